@@ -0,0 +1,130 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_BASE_CONTAINERS_SHARDED_LRU_CACHE_H_
+#define BRAVE_BASE_CONTAINERS_SHARDED_LRU_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/check_op.h"
+#include "base/containers/lru_cache.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace brave {
+
+// Thread-safe LRU cache for lookups that are hit from several sequences at
+// once, such as the network delegate helpers.
+//
+// Keys are spread over independent shards, each an LRU cache behind its own
+// lock, so concurrent lookups of different keys rarely contend. Eviction is
+// LRU within a shard, which approximates LRU over the whole cache. Values are
+// copied out, so they should be cheap to copy.
+template <class Key, class Value, class KeyHash = std::hash<Key>>
+class ShardedLRUCache {
+ public:
+  static constexpr size_t kDefaultShardCount = 16;
+
+  // `capacity` is the total number of entries, split evenly between
+  // `shard_count` shards.
+  explicit ShardedLRUCache(size_t capacity,
+                           size_t shard_count = kDefaultShardCount) {
+    DCHECK_GT(capacity, 0u);
+    DCHECK_GT(shard_count, 0u);
+    // A zero-sized base::LRUCache would never evict, so every shard keeps at
+    // least one entry.
+    const size_t shard_capacity =
+        std::max<size_t>(1, (capacity + shard_count - 1) / shard_count);
+    shards_.reserve(shard_count);
+    for (size_t i = 0; i < shard_count; i++) {
+      shards_.push_back(std::make_unique<Shard>(shard_capacity));
+    }
+  }
+  ShardedLRUCache(const ShardedLRUCache&) = delete;
+  ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+  ~ShardedLRUCache() = default;
+
+  void Put(const Key& key, Value value) {
+    Shard& shard = GetShard(key);
+    base::AutoLock lock(shard.lock);
+    shard.entries.Put(key, std::move(value));
+  }
+
+  // Returns a copy of the value for `key` and marks it as recently used.
+  absl::optional<Value> Get(const Key& key) {
+    Shard& shard = GetShard(key);
+    {
+      base::AutoLock lock(shard.lock);
+      auto it = shard.entries.Get(key);
+      if (it != shard.entries.end()) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return it->second;
+      }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return absl::nullopt;
+  }
+
+  void Erase(const Key& key) {
+    Shard& shard = GetShard(key);
+    base::AutoLock lock(shard.lock);
+    auto it = shard.entries.Peek(key);
+    if (it != shard.entries.end()) {
+      shard.entries.Erase(it);
+    }
+  }
+
+  void Clear() {
+    for (auto& shard : shards_) {
+      base::AutoLock lock(shard->lock);
+      shard->entries.Clear();
+    }
+  }
+
+  size_t size() const {
+    size_t size = 0;
+    for (const auto& shard : shards_) {
+      base::AutoLock lock(shard->lock);
+      size += shard->entries.size();
+    }
+    return size;
+  }
+
+  uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+  uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Shard {
+    explicit Shard(size_t capacity) : entries(capacity) {}
+
+    mutable base::Lock lock;
+    base::HashingLRUCache<Key, Value, KeyHash> entries GUARDED_BY(lock);
+  };
+
+  Shard& GetShard(const Key& key) {
+    // The shards' own hash tables bucket on the low bits of the same hash,
+    // so pick the shard from the high bits of a multiplicative mix instead.
+    const uint64_t hash =
+        static_cast<uint64_t>(KeyHash()(key)) * 0x9E3779B97F4A7C15ull;
+    return *shards_[(hash >> 32) % shards_.size()];
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_BASE_CONTAINERS_SHARDED_LRU_CACHE_H_
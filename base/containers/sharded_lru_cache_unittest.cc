@@ -0,0 +1,59 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/base/containers/sharded_lru_cache.h"
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+TEST(ShardedLRUCacheTest, Operations) {
+  // A single shard behaves as a plain LRU cache.
+  ShardedLRUCache<std::string, std::string> cache(3, 1);
+
+  // Test add/get and check that max size is maintained.
+  cache.Put("kA", "vA");
+  cache.Put("kB", "vB");
+  cache.Put("kC", "vC");
+  EXPECT_EQ(cache.Get("kA"), "vA");
+  // kA just became MRU, so adding a new k/v pair should evict the oldest.
+  cache.Put("kD", "vD");
+  EXPECT_FALSE(cache.Get("kB"));
+  EXPECT_EQ(cache.Get("kD"), "vD");
+  EXPECT_EQ(cache.size(), 3u);
+
+  // Test remove.
+  cache.Erase("kD");
+  EXPECT_FALSE(cache.Get("kD"));
+
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(ShardedLRUCacheTest, Counters) {
+  ShardedLRUCache<std::string, int> cache(10);
+  cache.Put("a", 1);
+  EXPECT_EQ(cache.Get("a"), 1);
+  EXPECT_EQ(cache.Get("a"), 1);
+  EXPECT_FALSE(cache.Get("b"));
+  EXPECT_EQ(cache.hits(), 2u);
+  EXPECT_EQ(cache.misses(), 1u);
+}
+
+TEST(ShardedLRUCacheTest, CapacityIsSplitBetweenShards) {
+  ShardedLRUCache<int, int> cache(64, 4);
+  for (int i = 0; i < 1000; i++) {
+    cache.Put(i, i);
+  }
+  // Every shard holds at most a quarter of the capacity.
+  EXPECT_LE(cache.size(), 64u);
+  EXPECT_GT(cache.size(), 0u);
+  EXPECT_EQ(cache.Get(999), 999);
+}
+
+}  // namespace brave
@@ -74,7 +74,7 @@ using brave_shields::features::kBraveDomainBlock;
 using brave_shields::features::kBraveDomainBlock1PES;
 using brave_shields::features::kBraveExtensionNetworkBlocking;
 using brave_shields::features::kBraveReduceLanguage;
-using brave_shields::features::kCosmeticFilteringSyncLoad;
+using brave_shields::features::kCosmeticFilteringPrefetch;
 
 using de_amp::features::kBraveDeAMP;
 using debounce::features::kBraveDebounce;
@@ -180,10 +180,11 @@ constexpr char kBraveReduceLanguageName[] = "Reduce language identifiability";
 constexpr char kBraveReduceLanguageDescription[] =
     "Reduce the identifiability of my language preferences";
 
-constexpr char kCosmeticFilteringSyncLoadName[] =
-    "Enable sync loading of cosmetic filter rules";
-constexpr char kCosmeticFilteringSyncLoadDescription[] =
-    "Enable sync loading of cosmetic filter rules";
+constexpr char kCosmeticFilteringPrefetchName[] =
+    "Enable prefetching of cosmetic filter rules";
+constexpr char kCosmeticFilteringPrefetchDescription[] =
+    "Compute cosmetic filter rules when a navigation starts and send them to "
+    "the renderer before the page commits";
 
 constexpr char kBraveIpfsName[] = "Enable IPFS";
 constexpr char kBraveIpfsDescription[] = "Enable native support of IPFS.";
@@ -654,10 +655,10 @@ constexpr char kBraveAndroidSafeBrowsingDescription[] =
         flag_descriptions::kBraveReduceLanguageName,                        \
         flag_descriptions::kBraveReduceLanguageDescription, kOsAll,         \
         FEATURE_VALUE_TYPE(kBraveReduceLanguage)},                          \
-    {"brave-cosmetic-filtering-sync-load",                                  \
-     flag_descriptions::kCosmeticFilteringSyncLoadName,                     \
-     flag_descriptions::kCosmeticFilteringSyncLoadDescription, kOsAll,      \
-     FEATURE_VALUE_TYPE(kCosmeticFilteringSyncLoad)},                       \
+    {"brave-cosmetic-filtering-prefetch",                                   \
+     flag_descriptions::kCosmeticFilteringPrefetchName,                     \
+     flag_descriptions::kCosmeticFilteringPrefetchDescription, kOsAll,      \
+     FEATURE_VALUE_TYPE(kCosmeticFilteringPrefetch)},                       \
     {"brave-super-referral",                                                \
      flag_descriptions::kBraveSuperReferralName,                            \
      flag_descriptions::kBraveSuperReferralDescription,                     \
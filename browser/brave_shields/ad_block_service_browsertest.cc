@@ -15,6 +15,7 @@
 #include "base/memory/raw_ptr.h"
 #include "base/path_service.h"
 #include "base/strings/stringprintf.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/test/thread_test_helper.h"
 #include "brave/browser/brave_browser_process.h"
@@ -46,12 +47,14 @@
 #include "components/prefs/pref_change_registrar.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/navigation_controller.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
 #include "extensions/test/extension_test_message_listener.h"
 #include "net/dns/mock_host_resolver.h"
 #include "net/test/test_data_directory.h"
 #include "services/network/host_resolver.h"
+#include "ui/base/page_transition_types.h"
 
 #if BUILDFLAG(ENABLE_PLAYLIST)
 #include "brave/browser/playlist/playlist_service_factory.h"
@@ -1996,6 +1999,103 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringSimple) {
   EXPECT_EQ(base::Value(true), result_third.value);
 }
 
+// Test that cosmetic resources are prefetched for the main frame only
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringPrefetchMainFrame) {
+  base::HistogramTester histogram_tester;
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  UpdateAdBlockInstanceWithRules("b.com###ad-banner\n");
+
+  GURL tab_url =
+      embedded_test_server()->GetURL("b.com", "/cosmetic_filtering.html");
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), tab_url));
+  histogram_tester.ExpectTotalCount(
+      "Brave.CosmeticFilters.PrefetchReadyBeforeCommit", 1);
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  auto result = EvalJs(contents,
+                       R"(async function waitCSSSelector() {
+          if (await checkSelector('#ad-banner', 'display', 'none')) {
+            window.domAutomationController.send(true);
+          } else {
+            console.log('still waiting for css selector');
+            setTimeout(waitCSSSelector, 200);
+          }
+        } waitCSSSelector())",
+                       content::EXECUTE_SCRIPT_USE_MANUAL_REPLY);
+  ASSERT_TRUE(result.error.empty());
+  EXPECT_EQ(base::Value(true), result.value);
+
+  GURL frame_url =
+      embedded_test_server()->GetURL("frame.com", "/cosmetic_frame.html");
+  content::NavigateIframeToURL(contents, "iframe", frame_url);
+  histogram_tester.ExpectTotalCount(
+      "Brave.CosmeticFilters.PrefetchReadyBeforeCommit", 1);
+}
+
+// Test that nothing is prefetched when shields are down
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
+                       CosmeticFilteringPrefetchShieldsDown) {
+  base::HistogramTester histogram_tester;
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  UpdateAdBlockInstanceWithRules("b.com###ad-banner\n");
+
+  GURL tab_url =
+      embedded_test_server()->GetURL("b.com", "/cosmetic_filtering.html");
+  brave_shields::SetBraveShieldsEnabled(content_settings(), false, tab_url);
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), tab_url));
+  histogram_tester.ExpectTotalCount(
+      "Brave.CosmeticFilters.PrefetchReadyBeforeCommit", 0);
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  ASSERT_EQ(true, EvalJs(contents,
+                         "checkSelector('#ad-banner', 'display', 'block')"));
+  brave_shields::ResetBraveShieldsEnabled(content_settings(), tab_url);
+}
+
+// Test that the resources of a superseded navigation are never used
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
+                       CosmeticFilteringPrefetchSupersededNavigation) {
+  base::HistogramTester histogram_tester;
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  UpdateAdBlockInstanceWithRules(
+      "a.com###ad-banner\n"
+      "b.com##.ad\n");
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+  GURL first_url =
+      embedded_test_server()->GetURL("a.com", "/cosmetic_filtering.html");
+  content::TestNavigationManager first_navigation(contents, first_url);
+  contents->GetController().LoadURL(first_url, content::Referrer(),
+                                    ui::PAGE_TRANSITION_TYPED, std::string());
+  ASSERT_TRUE(first_navigation.WaitForRequestStart());
+
+  GURL second_url =
+      embedded_test_server()->GetURL("b.com", "/cosmetic_filtering.html");
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), second_url));
+  ASSERT_TRUE(first_navigation.WaitForNavigationFinished());
+  EXPECT_FALSE(first_navigation.was_committed());
+  histogram_tester.ExpectTotalCount(
+      "Brave.CosmeticFilters.PrefetchReadyBeforeCommit", 1);
+
+  auto result = EvalJs(contents,
+                       R"(async function waitCSSSelector() {
+          if (await checkSelector('.ad', 'display', 'none')) {
+            window.domAutomationController.send(true);
+          } else {
+            console.log('still waiting for css selector');
+            setTimeout(waitCSSSelector, 200);
+          }
+        } waitCSSSelector())",
+                       content::EXECUTE_SCRIPT_USE_MANUAL_REPLY);
+  ASSERT_TRUE(result.error.empty());
+  EXPECT_EQ(base::Value(true), result.value);
+  ASSERT_EQ(true, EvalJs(contents,
+                         "checkSelector('#ad-banner', 'display', 'block')"));
+}
+
 class CosmeticFilteringChildFramesFlagEnabledTest : public AdBlockServiceTest {
  public:
   CosmeticFilteringChildFramesFlagEnabledTest() {
@@ -2145,6 +2245,45 @@ IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringDynamic) {
   EXPECT_EQ(base::Value(true), result_second.value);
 }
 
+// Test that class names remembered as having no rule are looked up again once
+// the lists change
+IN_PROC_BROWSER_TEST_F(AdBlockServiceTest,
+                       CosmeticFilteringDynamicAfterListUpdate) {
+  ASSERT_TRUE(InstallDefaultAdBlockExtension());
+  UpdateAdBlockInstanceWithRules("##.ad");
+
+  GURL tab_url =
+      embedded_test_server()->GetURL("b.com", "/cosmetic_filtering.html");
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), tab_url));
+
+  content::WebContents* contents =
+      browser()->tab_strip_model()->GetActiveWebContents();
+
+  // `checkSelector` waits long enough for the lookup of the new names to be
+  // answered, so they are now known to have no rule.
+  ASSERT_EQ(true, EvalJs(contents,
+                         "addElementsDynamically();"
+                         "checkSelector('.blockme', 'display', 'block')"));
+
+  UpdateAdBlockInstanceWithRules("##.blockme");
+  // Same host, so the renderer would otherwise keep its negative cache.
+  ASSERT_TRUE(ui_test_utils::NavigateToURL(browser(), tab_url));
+
+  auto result = EvalJs(contents,
+                       R"(addElementsDynamically();
+        async function waitCSSSelector() {
+          if (await checkSelector('.blockme', 'display', 'none')) {
+            window.domAutomationController.send(true);
+          } else {
+            console.log('still waiting for css selector');
+            setTimeout(waitCSSSelector, 200);
+          }
+        } waitCSSSelector())",
+                       content::EXECUTE_SCRIPT_USE_MANUAL_REPLY);
+  ASSERT_TRUE(result.error.empty());
+  EXPECT_EQ(base::Value(true), result.value);
+}
+
 // Test cosmetic filtering on elements added dynamically, using a rule from the
 // custom filters
 IN_PROC_BROWSER_TEST_F(AdBlockServiceTest, CosmeticFilteringDynamicCustom) {
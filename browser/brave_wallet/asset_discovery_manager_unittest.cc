@@ -5,6 +5,8 @@
 
 #include "brave/components/brave_wallet/browser/asset_discovery_manager.h"
 
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/memory/raw_ptr.h"
 #include "base/strings/strcat.h"
 #include "base/test/bind.h"
@@ -22,6 +24,8 @@
 #include "brave/components/brave_wallet/browser/keyring_service.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
 #include "brave/components/brave_wallet/browser/tx_service.h"
+#include "brave/components/brave_wallet/common/eth_abi_utils.h"
+#include "brave/components/brave_wallet/common/eth_address.h"
 #include "brave/components/brave_wallet/common/features.h"
 #include "brave/components/brave_wallet/common/hex_utils.h"
 #include "brave/components/brave_wallet/common/test_utils.h"
@@ -73,6 +77,51 @@ const std::vector<std::string>& GetAssetDiscoverySupportedChainsForTest() {
   return *asset_discovery_supported_chains;
 }
 
+// Balances keyed by lowercase contract and owner addresses.
+using TokenBalancesMap =
+    std::map<std::pair<std::string, std::string>, uint256_t>;
+
+// Responds to a Multicall3 aggregate3 eth_call of ERC20 balanceOf calls with
+// the balances in |balances|, or zero for tokens not in |balances|.
+base::Value::Dict RespondToAggregate3(const base::Value::Dict& request,
+                                      const TokenBalancesMap& balances) {
+  const base::Value::List* params = request.FindList("params");
+  const std::string* data = params->front().GetDict().FindString("data");
+  std::vector<uint8_t> call_data;
+  EXPECT_TRUE(PrefixedHexStringToBytes(*data, &call_data));
+  auto calls = eth_abi::ExtractTupleArrayFromTuple(
+      eth_abi::ExtractFunctionSelectorAndArgsFromCall(call_data).second, 0);
+  EXPECT_TRUE(calls);
+
+  std::vector<std::vector<uint8_t>> results;
+  for (const auto& call : *calls) {
+    const auto contract = eth_abi::ExtractAddressFromTuple(call, 0);
+    const auto balance_of = eth_abi::ExtractBytesFromTuple(call, 2);
+    EXPECT_TRUE(balance_of);
+    const auto owner = eth_abi::ExtractAddressFromTuple(
+        eth_abi::ExtractFunctionSelectorAndArgsFromCall(*balance_of).second,
+        0);
+
+    uint256_t balance = 0;
+    auto iter = balances.find({contract.ToHex(), owner.ToHex()});
+    if (iter != balances.end()) {
+      balance = iter->second;
+    }
+    results.push_back(
+        eth_abi::TupleEncoder()
+            .AddUint256(1)
+            .AddBytes(eth_abi::TupleEncoder().AddUint256(balance).Encode())
+            .Encode());
+  }
+
+  base::Value::Dict response;
+  response.Set("jsonrpc", "2.0");
+  response.Set("id", request.Find("id")->Clone());
+  response.Set("result",
+               ToHex(eth_abi::TupleEncoder().AddTupleArray(results).Encode()));
+  return response;
+}
+
 }  // namespace
 
 class TestBraveWalletServiceObserverForAssetDiscovery
@@ -191,6 +240,37 @@ class AssetDiscoveryManagerUnitTest : public testing::Test {
         }));
   }
 
+  // Responds to Multicall3 balance scans, which may be sent in batches.
+  void SetBalanceScanInterceptor(const TokenBalancesMap& balances) {
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&, balances](const network::ResourceRequest& request) {
+          base::StringPiece request_string(request.request_body->elements()
+                                               ->at(0)
+                                               .As<network::DataElementBytes>()
+                                               .AsStringPiece());
+          auto request_value = base::JSONReader::Read(request_string);
+          ASSERT_TRUE(request_value);
+
+          base::Value response_value;
+          if (request_value->is_list()) {
+            base::Value::List responses;
+            for (const auto& batched_request : request_value->GetList()) {
+              responses.Append(
+                  RespondToAggregate3(batched_request.GetDict(), balances));
+            }
+            response_value = base::Value(std::move(responses));
+          } else {
+            response_value = base::Value(
+                RespondToAggregate3(request_value->GetDict(), balances));
+          }
+
+          std::string response;
+          base::JSONWriter::Write(response_value, &response);
+          url_loader_factory_.ClearResponses();
+          url_loader_factory_.AddResponse(request.url.spec(), response);
+        }));
+  }
+
   // SetDiscoverAssetsOnAllSupportedChainsInterceptor sets the response
   // based on the requested URL and verifies the from / to blocks
   // specified in the eth_getLogs query is expected for each URL/chain ID
@@ -678,6 +758,92 @@ TEST_F(AssetDiscoveryManagerUnitTest, DiscoverAssets) {
                      mojom::ProviderError::kSuccess, "", "0xd6464e");
 }
 
+TEST_F(AssetDiscoveryManagerUnitTest, DiscoverAssetsByBalanceScan) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(
+      features::kBraveWalletAssetDiscoveryBalanceScanFeature);
+
+  auto* blockchain_registry = BlockchainRegistry::GetInstance();
+  TokenListMap token_list_map;
+  std::string token_list_json = R"(
+     {
+      "0x0d8775f648430679a709e98d2b0cb6250d2887ef": {
+        "name": "Basic Attention Token",
+        "logo": "bat.svg",
+        "erc20": true,
+        "symbol": "BAT",
+        "decimals": 18
+      },
+      "0x6B175474E89094C44Da98b954EedeAC495271d0F": {
+        "name": "Dai Stablecoin",
+        "logo": "dai.svg",
+        "erc20": true,
+        "symbol": "DAI",
+        "decimals": 18
+      },
+      "0xC02aaA39b223FE8D0A0e5C4F27eAD9083C756Cc2": {
+        "name": "Wrapped Eth",
+        "logo": "weth.svg",
+        "erc20": true,
+        "symbol": "WETH",
+        "decimals": 18,
+        "chainId": "0x1"
+      },
+      "0xA0b86991c6218b36c1d19D4a2e9Eb0cE3606eB48": {
+        "name": "USD Coin",
+        "logo": "usdc.png",
+        "erc20": true,
+        "symbol": "USDC",
+        "decimals": 6,
+        "chainId": "0x1"
+      },
+      "0x4b10701Bfd7BFEdc47d50562b76b436fbB5BdB3B": {
+        "name": "Lil Nouns",
+        "logo": "lilnouns.svg",
+        "erc20": false,
+        "erc721": true,
+        "symbol": "LilNouns",
+        "chainId": "0x1"
+      }
+     })";
+  ASSERT_TRUE(
+      ParseTokenList(token_list_json, &token_list_map, mojom::CoinType::ETH));
+  blockchain_registry->UpdateTokenList(std::move(token_list_map));
+
+  // All balance scans fail.
+  SetLimitExceededJsonErrorResponse();
+  TestDiscoverAssets(mojom::kMainnetChainId, mojom::CoinType::ETH,
+                     {"0xB4B2802129071b2B9eBb8cBB01EA1E4D14B34961",
+                      "0xf81229FE54D8a20fBc1e1e2a3451D1c7489437Db"},
+                     {}, mojom::ProviderError::kInternalError,
+                     l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR), "");
+
+  // DAI is held by the first account and WETH by the second one, so both are
+  // discovered and added. USDC is not added because neither account holds it.
+  // BAT is not scanned because it is already a user asset and LilNouns is not
+  // scanned because it is an ERC721. The next block to discover assets from is
+  // not updated as no transfer logs are queried.
+  SetBalanceScanInterceptor(
+      {{{"0x6b175474e89094c44da98b954eedeac495271d0f",
+         "0xb4b2802129071b2b9ebb8cbb01ea1e4d14b34961"},
+        1},
+       {{"0xc02aaa39b223fe8d0a0e5c4f27ead9083c756cc2",
+         "0xf81229fe54d8a20fbc1e1e2a3451d1c7489437db"},
+        2}});
+  TestDiscoverAssets(mojom::kMainnetChainId, mojom::CoinType::ETH,
+                     {"0xB4B2802129071b2B9eBb8cBB01EA1E4D14B34961",
+                      "0xf81229FE54D8a20fBc1e1e2a3451D1c7489437Db"},
+                     {"0x6B175474E89094C44Da98b954EedeAC495271d0F",
+                      "0xC02aaA39b223FE8D0A0e5C4F27eAD9083C756Cc2"},
+                     mojom::ProviderError::kSuccess, "", "");
+
+  // Discovered assets are not scanned again.
+  TestDiscoverAssets(mojom::kMainnetChainId, mojom::CoinType::ETH,
+                     {"0xB4B2802129071b2B9eBb8cBB01EA1E4D14B34961",
+                      "0xf81229FE54D8a20fBc1e1e2a3451D1c7489437Db"},
+                     {}, mojom::ProviderError::kSuccess, "", "");
+}
+
 TEST_F(AssetDiscoveryManagerUnitTest,
        DiscoverAssetsOnAllSupportedChainsAccountsAdded) {
   // Send valid requests that yield no results and verify
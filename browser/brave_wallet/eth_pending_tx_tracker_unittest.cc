@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/files/file_path.h"
 #include "base/test/bind.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/eth_nonce_tracker.h"
@@ -17,6 +18,7 @@
 #include "brave/components/brave_wallet/browser/eth_tx_state_manager.h"
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 #include "brave/components/brave_wallet/browser/tx_meta.h"
+#include "brave/components/brave_wallet/browser/tx_store.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
 #include "brave/components/brave_wallet/common/eth_address.h"
@@ -71,7 +73,9 @@ class EthPendingTxTrackerUnitTest : public testing::Test {
 
 TEST_F(EthPendingTxTrackerUnitTest, IsNonceTaken) {
   JsonRpcService service(shared_url_loader_factory(), GetPrefs());
-  EthTxStateManager tx_state_manager(GetPrefs(), &service);
+  TxStore tx_store(GetPrefs(), base::FilePath());
+  EthTxStateManager tx_state_manager(GetPrefs(), &tx_store, &service);
+  task_environment_.RunUntilIdle();
   EthNonceTracker nonce_tracker(&tx_state_manager, &service);
   EthPendingTxTracker pending_tx_tracker(&tx_state_manager, &service,
                                          &nonce_tracker);
@@ -100,7 +104,9 @@ TEST_F(EthPendingTxTrackerUnitTest, ShouldTxDropped) {
       EthAddress::FromHex("0x2f015c60e0be116b1f0cd534704db9c92118fb6a")
           .ToChecksumAddress();
   JsonRpcService service(shared_url_loader_factory(), GetPrefs());
-  EthTxStateManager tx_state_manager(GetPrefs(), &service);
+  TxStore tx_store(GetPrefs(), base::FilePath());
+  EthTxStateManager tx_state_manager(GetPrefs(), &tx_store, &service);
+  task_environment_.RunUntilIdle();
   EthNonceTracker nonce_tracker(&tx_state_manager, &service);
   EthPendingTxTracker pending_tx_tracker(&tx_state_manager, &service,
                                          &nonce_tracker);
@@ -129,7 +135,9 @@ TEST_F(EthPendingTxTrackerUnitTest, ShouldTxDropped) {
 
 TEST_F(EthPendingTxTrackerUnitTest, DropTransaction) {
   JsonRpcService service(shared_url_loader_factory(), GetPrefs());
-  EthTxStateManager tx_state_manager(GetPrefs(), &service);
+  TxStore tx_store(GetPrefs(), base::FilePath());
+  EthTxStateManager tx_state_manager(GetPrefs(), &tx_store, &service);
+  task_environment_.RunUntilIdle();
   EthNonceTracker nonce_tracker(&tx_state_manager, &service);
   EthPendingTxTracker pending_tx_tracker(&tx_state_manager, &service,
                                          &nonce_tracker);
@@ -150,7 +158,9 @@ TEST_F(EthPendingTxTrackerUnitTest, UpdatePendingTransactions) {
       EthAddress::FromHex("0x2f015c60e0be116b1f0cd534704db9c92118fb6b")
           .ToChecksumAddress();
   JsonRpcService service(shared_url_loader_factory(), GetPrefs());
-  EthTxStateManager tx_state_manager(GetPrefs(), &service);
+  TxStore tx_store(GetPrefs(), base::FilePath());
+  EthTxStateManager tx_state_manager(GetPrefs(), &tx_store, &service);
+  task_environment_.RunUntilIdle();
   EthNonceTracker nonce_tracker(&tx_state_manager, &service);
   EthPendingTxTracker pending_tx_tracker(&tx_state_manager, &service,
                                          &nonce_tracker);
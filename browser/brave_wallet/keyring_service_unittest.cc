@@ -7,6 +7,7 @@
 
 #include <utility>
 
+#include "base/barrier_closure.h"
 #include "base/base64.h"
 #include "base/callback_helpers.h"
 #include "base/json/json_reader.h"
@@ -1385,6 +1386,101 @@ TEST_F(KeyringServiceUnitTest, LockAndUnlock) {
   }
 }
 
+TEST_F(KeyringServiceUnitTest, UnlockDerivesKeysAsynchronously) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitWithFeatures(
+      {brave_wallet::features::kBraveWalletFilecoinFeature,
+       brave_wallet::features::kBraveWalletSolanaFeature},
+      {});
+
+  KeyringService service(json_rpc_service(), GetPrefs());
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  ASSERT_TRUE(
+      AddFilecoinAccount(&service, "FIL Account 1", mojom::kFilecoinMainnet));
+  const auto eth_accounts =
+      service.GetAccountInfosForKeyring(mojom::kDefaultKeyringId);
+  ASSERT_EQ(eth_accounts.size(), 1u);
+  service.Lock();
+
+  // Keys are derived off the calling sequence, and a second call made in the
+  // meantime reports whether its password is right without resuming twice.
+  bool unlocked = false;
+  bool wrong_password_unlocked = true;
+  bool unlocked_again = false;
+  base::RunLoop run_loop;
+  auto barrier = base::BarrierClosure(3, run_loop.QuitClosure());
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   unlocked = success;
+                   barrier.Run();
+                 }));
+  EXPECT_TRUE(service.IsLocked());
+  service.Unlock("brave123", base::BindLambdaForTesting([&](bool success) {
+                   wrong_password_unlocked = success;
+                   barrier.Run();
+                 }));
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   unlocked_again = success;
+                   barrier.Run();
+                 }));
+  EXPECT_TRUE(service.IsLocked());
+  run_loop.Run();
+
+  EXPECT_TRUE(unlocked);
+  EXPECT_FALSE(wrong_password_unlocked);
+  EXPECT_TRUE(unlocked_again);
+  EXPECT_FALSE(service.IsLocked(mojom::kDefaultKeyringId));
+  EXPECT_FALSE(service.IsLocked(mojom::kFilecoinKeyringId));
+  EXPECT_FALSE(service.IsLocked(mojom::kSolanaKeyringId));
+  const auto unlocked_eth_accounts =
+      service.GetAccountInfosForKeyring(mojom::kDefaultKeyringId);
+  ASSERT_EQ(unlocked_eth_accounts.size(), 1u);
+  EXPECT_EQ(unlocked_eth_accounts[0]->address, eth_accounts[0]->address);
+  EXPECT_EQ(
+      service.GetAccountInfosForKeyring(mojom::kFilecoinKeyringId).size(), 1u);
+
+  // An empty password fails right away.
+  service.Lock();
+  EXPECT_FALSE(Unlock(&service, ""));
+  EXPECT_TRUE(service.IsLocked());
+}
+
+TEST_F(KeyringServiceUnitTest, LockDuringUnlock) {
+  KeyringService service(json_rpc_service(), GetPrefs());
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  service.Lock();
+
+  // A lock requested while keys are derived wins over the pending unlock.
+  bool unlocked = true;
+  base::RunLoop run_loop;
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   unlocked = success;
+                   run_loop.Quit();
+                 }));
+  service.Lock();
+  run_loop.Run();
+  EXPECT_FALSE(unlocked);
+  EXPECT_TRUE(service.IsLocked());
+  EXPECT_FALSE(service.GetHDKeyringById(mojom::kDefaultKeyringId));
+
+  // So does a reset.
+  unlocked = true;
+  base::RunLoop run_loop2;
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   unlocked = success;
+                   run_loop2.Quit();
+                 }));
+  service.Reset();
+  run_loop2.Run();
+  EXPECT_FALSE(unlocked);
+  EXPECT_TRUE(service.IsLocked());
+
+  // Unlock calls made after the lock are not affected.
+  ASSERT_TRUE(CreateWallet(&service, "brave"));
+  service.Lock();
+  EXPECT_TRUE(Unlock(&service, "brave"));
+  EXPECT_FALSE(service.IsLocked());
+}
+
 TEST_F(KeyringServiceUnitTest, Reset) {
   KeyringService service(json_rpc_service(), GetPrefs());
   ASSERT_TRUE(CreateWallet(&service, "brave"));
@@ -4273,6 +4369,49 @@ TEST_F(KeyringServiceEncryptionKeysMigrationUnitTest, MigrateWithUnlock) {
   ValidateImportedAccountsForUnlockedKeyring(&service);
 }
 
+TEST_F(KeyringServiceEncryptionKeysMigrationUnitTest,
+       MigrateWithConcurrentUnlocks) {
+  // Setup prefs with legacy iterations count value.
+  KeyringService::GetPbkdf2IterationsForTesting() = 100000;
+  SetupKeyring();
+  KeyringService::GetPbkdf2IterationsForTesting() = absl::nullopt;
+
+  // Reset migration pref so migration runs on next unlock.
+  GetPrefs()->ClearPref(kBraveWalletKeyringEncryptionKeysMigrated);
+  const std::string legacy_salt =
+      GetStringPrefForKeyring(kPasswordEncryptorSalt, mojom::kDefaultKeyringId);
+
+  // Both calls derive the legacy keys before either migrates, e.g. on a double
+  // submit. The second one still reports that the password is right.
+  KeyringService service(json_rpc_service(), GetPrefs());
+  bool unlocked = false;
+  bool unlocked_again = false;
+  base::RunLoop run_loop;
+  auto barrier = base::BarrierClosure(2, run_loop.QuitClosure());
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   unlocked = success;
+                   barrier.Run();
+                 }));
+  service.Unlock("brave", base::BindLambdaForTesting([&](bool success) {
+                   unlocked_again = success;
+                   barrier.Run();
+                 }));
+  run_loop.Run();
+
+  EXPECT_TRUE(unlocked);
+  EXPECT_TRUE(unlocked_again);
+  EXPECT_TRUE(
+      GetPrefs()->GetBoolean(kBraveWalletKeyringEncryptionKeysMigrated));
+  EXPECT_NE(legacy_salt, GetStringPrefForKeyring(kPasswordEncryptorSalt,
+                                                  mojom::kDefaultKeyringId));
+  ValidateImportedAccountsForUnlockedKeyring(&service);
+
+  // The migrated keyrings unlock with the same password.
+  service.Lock();
+  EXPECT_TRUE(Unlock(&service, "brave"));
+  ValidateImportedAccountsForUnlockedKeyring(&service);
+}
+
 TEST_F(KeyringServiceEncryptionKeysMigrationUnitTest,
        MigrateWithRestoreDoingResume) {
   // Setup prefs with legacy iterations count value.
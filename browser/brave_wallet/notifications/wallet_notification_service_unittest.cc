@@ -39,8 +39,9 @@ class WalletNotificationServiceUnitTest : public testing::Test {
         std::make_unique<JsonRpcService>(shared_url_loader_factory_, prefs());
     keyring_service_ =
         std::make_unique<KeyringService>(json_rpc_service_.get(), prefs());
-    tx_service_ = std::make_unique<TxService>(json_rpc_service_.get(),
-                                              keyring_service_.get(), prefs());
+    tx_service_ = std::make_unique<TxService>(
+        json_rpc_service_.get(), keyring_service_.get(), prefs(),
+        base::FilePath());
     notification_service_ =
         std::make_unique<WalletNotificationService>(profile());
     tester_ = std::make_unique<NotificationDisplayServiceTester>(profile());
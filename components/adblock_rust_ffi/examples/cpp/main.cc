@@ -316,6 +316,39 @@ void TestUrlCosmetics() {
   assert(bad_b_resources == bad_b_result);
 }
 
+void TestBinaryCosmetics() {
+  adblock::Engine engine(
+      "a.com###element\n"
+      "b.com##.ads\n"
+      "##.block\n"
+      "a.com#@#.block\n"
+      "b.*##div:style(background: #fff)\n");
+
+  auto a_resources = engine.urlCosmeticResourcesBinary("https://a.com");
+  assert(a_resources);
+  assert(a_resources->hide_selectors ==
+         std::vector<std::string>({"#element"}));
+  assert(a_resources->style_selectors.empty());
+  assert(a_resources->exceptions == std::vector<std::string>({".block"}));
+  assert(a_resources->injected_script.empty());
+  assert(!a_resources->generichide);
+
+  auto b_resources = engine.urlCosmeticResourcesBinary("https://b.com");
+  assert(b_resources);
+  assert(b_resources->style_selectors.size() == 1);
+  assert(b_resources->style_selectors[0].first == "div");
+  assert(b_resources->style_selectors[0].second ==
+         std::vector<std::string>({"background: #fff"}));
+
+  std::vector<std::string> classes({"block", "ads"});
+  std::vector<std::string> ids;
+  std::vector<std::string> exceptions;
+  auto selectors =
+      engine.hiddenClassIdSelectorsBinary(classes, ids, exceptions);
+  assert(selectors);
+  assert(*selectors == std::vector<std::string>({".block"}));
+}
+
 void TestSubdomainUrlCosmetics() {
   adblock::Engine engine(
       "a.co.uk##.element\n"
@@ -435,6 +468,7 @@ int main() {
   TestException();
   TestClassId();
   TestUrlCosmetics();
+  TestBinaryCosmetics();
   TestSubdomainUrlCosmetics();
   TestGenerichide();
   TestCosmeticScriptletResources();
@@ -22,6 +22,12 @@ typedef struct C_Engine C_Engine;
  */
 typedef struct C_FilterListMetadata C_FilterListMetadata;
 
+/**
+ * Maps each network filter of an `Engine` created from multiple lists back to
+ * the index of the list it was parsed from.
+ */
+typedef struct C_FilterListSources C_FilterListSources;
+
 /**
  * An external callback that receives a hostname and two out-parameters for
  * start and end position. The callback should fill the start and end positions
@@ -70,6 +76,19 @@ struct C_Engine* engine_create_with_metadata(
     const char* rules,
     struct C_FilterListMetadata** metadata);
 
+/**
+ * Create a new `Engine` from several filter lists at once, interpreting each of
+ * the `count` entries of `datas` as a C string of `data_sizes` bytes and
+ * parsing it as a filter list in ABP syntax. Only network filters are kept.
+ * `sources` is populated with a mapping that `engine_match_with_source` uses
+ * to attribute each match to the list it came from.
+ */
+struct C_Engine* engine_create_from_buffers(
+    const char* const* datas,
+    const size_t* data_sizes,
+    size_t count,
+    struct C_FilterListSources** sources);
+
 /**
  * Checks if a `url` matches for the specified `Engine` within the context.
  *
@@ -90,6 +109,33 @@ void engine_match(struct C_Engine* engine,
                   char** redirect,
                   char** rewritten_url);
 
+/**
+ * Same as `engine_match`, for an `Engine` created by
+ * `engine_create_from_buffers`.
+ *
+ * `source_index` is set to the index of the filter list containing the
+ * exception or, failing that, the blocking filter that matched, or -1 if
+ * nothing matched.
+ */
+void engine_match_with_source(struct C_Engine* engine,
+                              const struct C_FilterListSources* sources,
+                              const char* url,
+                              const char* host,
+                              const char* tab_host,
+                              bool third_party,
+                              const char* resource_type,
+                              bool* did_match_rule,
+                              bool* did_match_exception,
+                              bool* did_match_important,
+                              char** redirect,
+                              char** rewritten_url,
+                              int32_t* source_index);
+
+/**
+ * Destroy a `FilterListSources` once you are done with it.
+ */
+void filter_list_sources_destroy(struct C_FilterListSources* sources);
+
 /**
  * Returns any CSP directives that should be added to a subdocument or document
  * request's response headers.
@@ -185,6 +231,43 @@ char* engine_hidden_class_id_selectors(struct C_Engine* engine,
                                        const char* const* exceptions,
                                        size_t exceptions_size);
 
+/**
+ * Destroy a byte buffer returned by one of the `*_binary` functions once you
+ * are done with it.
+ */
+void c_byte_buffer_destroy(uint8_t* buffer, size_t size);
+
+/**
+ * Returns the same resources as `engine_url_cosmetic_resources`, in a compact
+ * binary encoding that can be read without a JSON parser:
+ *
+ * - `generichide` as a single byte
+ * - `hide_selectors` as a string list
+ * - `style_selectors` as a `u32` count of (selector string, style string list)
+ * pairs
+ * - `exceptions` as a string list
+ * - `injected_script` as a string
+ *
+ * Strings are a little-endian `u32` byte length followed by UTF-8 bytes;
+ * string lists are a little-endian `u32` count followed by that many strings.
+ */
+uint8_t* engine_url_cosmetic_resources_binary(struct C_Engine* engine,
+                                              const char* url,
+                                              size_t* size);
+
+/**
+ * Returns the same selectors as `engine_hidden_class_id_selectors`, encoded as
+ * a binary string list (see `engine_url_cosmetic_resources_binary`).
+ */
+uint8_t* engine_hidden_class_id_selectors_binary(struct C_Engine* engine,
+                                                 const char* const* classes,
+                                                 size_t classes_size,
+                                                 const char* const* ids,
+                                                 size_t ids_size,
+                                                 const char* const* exceptions,
+                                                 size_t exceptions_size,
+                                                 size_t* size);
+
 #if BUILDFLAG(IS_IOS)
 char* convert_rules_to_content_blocking(const char* rules);
 #endif
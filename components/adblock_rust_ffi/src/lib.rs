@@ -1,13 +1,23 @@
+use adblock::blocker::BlockerResult;
 use adblock::engine::Engine;
-use adblock::lists::FilterListMetadata;
+use adblock::lists::{FilterListMetadata, ParseOptions, RuleTypes};
 use adblock::resources::{MimeType, Resource, ResourceType};
 use core::ptr;
 use libc::size_t;
+use std::collections::hash_map::DefaultHasher;
+use std::collections::HashMap;
 use std::ffi::CStr;
 use std::ffi::CString;
 use std::os::raw::c_char;
+use std::hash::{Hash, Hasher};
 use std::string::String;
 
+/// Maps each network filter of an `Engine` created from multiple lists back to the index of the
+/// list it was parsed from.
+pub struct FilterListSources {
+    sources: HashMap<u64, usize>,
+}
+
 /// An external callback that receives a hostname and two out-parameters for start and end
 /// position. The callback should fill the start and end positions with the start and end indices
 /// of the domain part of the hostname.
@@ -112,13 +122,51 @@ fn engine_create_from_str(rules: &str) -> (*mut FilterListMetadata, *mut Engine)
     )
 }
 
-/// Checks if a `url` matches for the specified `Engine` within the context.
-///
-/// This API is designed for multi-engine use, so block results are used both as inputs and
-/// outputs. They will be updated to reflect additional checking within this engine, rather than
-/// being replaced with results just for this engine.
+/// Create a new `Engine` from several filter lists at once, interpreting each of the `count`
+/// entries of `datas` as a C string of `data_sizes` bytes and parsing it as a filter list in ABP
+/// syntax. Only network filters are kept. `sources` is populated with a mapping that
+/// `engine_match_with_source` uses to attribute each match to the list it came from.
 #[no_mangle]
-pub unsafe extern "C" fn engine_match(
+pub unsafe extern "C" fn engine_create_from_buffers(
+    datas: *const *const c_char,
+    data_sizes: *const size_t,
+    count: size_t,
+    sources: *mut *mut FilterListSources,
+) -> *mut Engine {
+    let datas = std::slice::from_raw_parts(datas, count);
+    let data_sizes = std::slice::from_raw_parts(data_sizes, count);
+    // Debug mode retains the original text of each filter, which is what matches are attributed
+    // by.
+    let mut filter_set = adblock::lists::FilterSet::new(true);
+    let mut list_sources = HashMap::new();
+    for index in 0..count {
+        let data: &[u8] = std::slice::from_raw_parts(datas[index] as *const u8, data_sizes[index]);
+        let rules = std::str::from_utf8(data).unwrap_or_else(|_| {
+            eprintln!("Failed to parse filter list with invalid UTF-8 content");
+            ""
+        });
+        for line in rules.lines() {
+            list_sources.entry(hash_filter(line.trim())).or_insert(index);
+        }
+        filter_set.add_filter_list(
+            &rules,
+            ParseOptions { rule_types: RuleTypes::NetworkOnly, ..Default::default() },
+        );
+    }
+    let engine = Engine::from_filter_set(filter_set, true);
+    *sources = Box::into_raw(Box::new(FilterListSources {
+        sources: list_sources,
+    }));
+    Box::into_raw(Box::new(engine))
+}
+
+fn hash_filter(filter: &str) -> u64 {
+    let mut hasher = DefaultHasher::new();
+    filter.hash(&mut hasher);
+    hasher.finish()
+}
+
+unsafe fn engine_check(
     engine: *mut Engine,
     url: *const c_char,
     host: *const c_char,
@@ -130,14 +178,14 @@ pub unsafe extern "C" fn engine_match(
     did_match_important: *mut bool,
     redirect: *mut *mut c_char,
     rewritten_url: *mut *mut c_char,
-) {
+) -> BlockerResult {
     let url = CStr::from_ptr(url).to_str().unwrap();
     let host = CStr::from_ptr(host).to_str().unwrap();
     let tab_host = CStr::from_ptr(tab_host).to_str().unwrap();
     let resource_type = CStr::from_ptr(resource_type).to_str().unwrap();
     assert!(!engine.is_null());
     let engine = Box::leak(Box::from_raw(engine));
-    let blocker_result = engine.check_network_urls_with_hostnames_subset(
+    let mut blocker_result = engine.check_network_urls_with_hostnames_subset(
         url,
         host,
         tab_host,
@@ -153,12 +201,108 @@ pub unsafe extern "C" fn engine_match(
     *did_match_important |= blocker_result.important;
     *redirect = blocker_result
         .redirect
+        .take()
         .and_then(|x| CString::new(x).map(CString::into_raw).ok())
         .unwrap_or(ptr::null_mut());
     *rewritten_url = blocker_result
         .rewritten_url
+        .take()
         .and_then(|x| CString::new(x).map(CString::into_raw).ok())
         .unwrap_or(ptr::null_mut());
+    blocker_result
+}
+
+/// Checks if a `url` matches for the specified `Engine` within the context.
+///
+/// This API is designed for multi-engine use, so block results are used both as inputs and
+/// outputs. They will be updated to reflect additional checking within this engine, rather than
+/// being replaced with results just for this engine.
+#[no_mangle]
+pub unsafe extern "C" fn engine_match(
+    engine: *mut Engine,
+    url: *const c_char,
+    host: *const c_char,
+    tab_host: *const c_char,
+    third_party: bool,
+    resource_type: *const c_char,
+    did_match_rule: *mut bool,
+    did_match_exception: *mut bool,
+    did_match_important: *mut bool,
+    redirect: *mut *mut c_char,
+    rewritten_url: *mut *mut c_char,
+) {
+    engine_check(
+        engine,
+        url,
+        host,
+        tab_host,
+        third_party,
+        resource_type,
+        did_match_rule,
+        did_match_exception,
+        did_match_important,
+        redirect,
+        rewritten_url,
+    );
+}
+
+/// Same as `engine_match`, for an `Engine` created by `engine_create_from_buffers`.
+///
+/// `source_index` is set to the index of the filter list containing the exception or, failing
+/// that, the blocking filter that matched, or -1 if nothing matched.
+#[no_mangle]
+pub unsafe extern "C" fn engine_match_with_source(
+    engine: *mut Engine,
+    sources: *const FilterListSources,
+    url: *const c_char,
+    host: *const c_char,
+    tab_host: *const c_char,
+    third_party: bool,
+    resource_type: *const c_char,
+    did_match_rule: *mut bool,
+    did_match_exception: *mut bool,
+    did_match_important: *mut bool,
+    redirect: *mut *mut c_char,
+    rewritten_url: *mut *mut c_char,
+    source_index: *mut i32,
+) {
+    let blocker_result = engine_check(
+        engine,
+        url,
+        host,
+        tab_host,
+        third_party,
+        resource_type,
+        did_match_rule,
+        did_match_exception,
+        did_match_important,
+        redirect,
+        rewritten_url,
+    );
+    assert!(!sources.is_null());
+    let matched_filter = if blocker_result.exception.is_some() {
+        blocker_result.exception
+    } else if blocker_result.matched {
+        blocker_result.filter
+    } else {
+        None
+    };
+    // Filters fused together by the optimizer report their original lines joined by " <+> ", all
+    // of which come from the same list for the purposes of attribution.
+    *source_index = matched_filter
+        .as_ref()
+        .and_then(|filter| filter.split(" <+> ").next())
+        .and_then(|filter| (*sources).sources.get(&hash_filter(filter)))
+        .map(|index| *index as i32)
+        .unwrap_or(-1);
+}
+
+/// Destroy a `FilterListSources` once you are done with it.
+#[no_mangle]
+pub unsafe extern "C" fn filter_list_sources_destroy(sources: *mut FilterListSources) {
+    if !sources.is_null() {
+        drop(Box::from_raw(sources));
+    }
 }
 
 /// Returns any CSP directives that should be added to a subdocument or document request's response
@@ -373,6 +517,104 @@ pub unsafe extern "C" fn engine_hidden_class_id_selectors(
         .into_raw()
 }
 
+/// Appends a string to `buffer` as a little-endian `u32` byte length followed by its UTF-8 bytes.
+fn encode_string(buffer: &mut Vec<u8>, value: &str) {
+    buffer.extend_from_slice(&(value.len() as u32).to_le_bytes());
+    buffer.extend_from_slice(value.as_bytes());
+}
+
+/// Appends a list of strings to `buffer` as a little-endian `u32` count followed by each string.
+fn encode_strings<'a>(buffer: &mut Vec<u8>, values: impl ExactSizeIterator<Item = &'a String>) {
+    buffer.extend_from_slice(&(values.len() as u32).to_le_bytes());
+    for value in values {
+        encode_string(buffer, value);
+    }
+}
+
+/// Hands ownership of `buffer` to the caller, who must release it with `c_byte_buffer_destroy`.
+unsafe fn into_raw_byte_buffer(buffer: Vec<u8>, size: *mut size_t) -> *mut u8 {
+    let buffer = buffer.into_boxed_slice();
+    *size = buffer.len();
+    Box::into_raw(buffer) as *mut u8
+}
+
+/// Destroy a byte buffer returned by one of the `*_binary` functions once you are done with it.
+#[no_mangle]
+pub unsafe extern "C" fn c_byte_buffer_destroy(buffer: *mut u8, size: size_t) {
+    if !buffer.is_null() {
+        drop(Box::from_raw(std::slice::from_raw_parts_mut(buffer, size)));
+    }
+}
+
+/// Returns the same resources as `engine_url_cosmetic_resources`, in a compact binary encoding
+/// that can be read without a JSON parser:
+///
+/// - `generichide` as a single byte
+/// - `hide_selectors` as a string list
+/// - `style_selectors` as a `u32` count of (selector string, style string list) pairs
+/// - `exceptions` as a string list
+/// - `injected_script` as a string
+///
+/// Strings are a little-endian `u32` byte length followed by UTF-8 bytes; string lists are a
+/// little-endian `u32` count followed by that many strings.
+#[no_mangle]
+pub unsafe extern "C" fn engine_url_cosmetic_resources_binary(
+    engine: *mut Engine,
+    url: *const c_char,
+    size: *mut size_t,
+) -> *mut u8 {
+    let url = CStr::from_ptr(url).to_str().unwrap();
+    assert!(!engine.is_null());
+    let engine = Box::leak(Box::from_raw(engine));
+    let resources = engine.url_cosmetic_resources(url);
+
+    let mut buffer = Vec::new();
+    buffer.push(resources.generichide as u8);
+    encode_strings(&mut buffer, resources.hide_selectors.iter());
+    buffer.extend_from_slice(&(resources.style_selectors.len() as u32).to_le_bytes());
+    for (selector, styles) in resources.style_selectors.iter() {
+        encode_string(&mut buffer, selector);
+        encode_strings(&mut buffer, styles.iter());
+    }
+    encode_strings(&mut buffer, resources.exceptions.iter());
+    encode_string(&mut buffer, &resources.injected_script);
+    into_raw_byte_buffer(buffer, size)
+}
+
+/// Returns the same selectors as `engine_hidden_class_id_selectors`, encoded as a binary string
+/// list (see `engine_url_cosmetic_resources_binary`).
+#[no_mangle]
+pub unsafe extern "C" fn engine_hidden_class_id_selectors_binary(
+    engine: *mut Engine,
+    classes: *const *const c_char,
+    classes_size: size_t,
+    ids: *const *const c_char,
+    ids_size: size_t,
+    exceptions: *const *const c_char,
+    exceptions_size: size_t,
+    size: *mut size_t,
+) -> *mut u8 {
+    let classes = std::slice::from_raw_parts(classes, classes_size);
+    let classes: Vec<String> = (0..classes_size)
+        .map(|index| CStr::from_ptr(classes[index]).to_str().unwrap().to_owned())
+        .collect();
+    let ids = std::slice::from_raw_parts(ids, ids_size);
+    let ids: Vec<String> = (0..ids_size)
+        .map(|index| CStr::from_ptr(ids[index]).to_str().unwrap().to_owned())
+        .collect();
+    let exceptions = std::slice::from_raw_parts(exceptions, exceptions_size);
+    let exceptions: std::collections::HashSet<String> = (0..exceptions_size)
+        .map(|index| CStr::from_ptr(exceptions[index]).to_str().unwrap().to_owned())
+        .collect();
+    assert!(!engine.is_null());
+    let engine = Box::leak(Box::from_raw(engine));
+    let selectors = engine.hidden_class_id_selectors(&classes, &ids, &exceptions);
+
+    let mut buffer = Vec::new();
+    encode_strings(&mut buffer, selectors.iter());
+    into_raw_byte_buffer(buffer, size)
+}
+
 #[cfg(feature = "ios")]
 #[no_mangle]
 pub unsafe extern "C" fn convert_rules_to_content_blocking(rules: *const c_char) -> *mut c_char {
@@ -4,12 +4,87 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "wrapper.h"  // NOLINT https://github.com/brave/brave-browser/issues/14821
+#include <cstring>
 #include <iostream>
 
 extern "C" {
 #include "lib.h"  // NOLINT
 }
 
+namespace {
+
+std::vector<const char*> ToRawStrings(const std::vector<std::string>& strings) {
+  std::vector<const char*> strings_raw;
+  strings_raw.reserve(strings.size());
+  for (const auto& string : strings) {
+    strings_raw.push_back(string.c_str());
+  }
+  return strings_raw;
+}
+
+// Reads the binary encoding documented on
+// `engine_url_cosmetic_resources_binary`. Every read is bounds-checked and
+// fails once the end of the buffer is reached.
+class BinaryReader {
+ public:
+  BinaryReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  bool ReadByte(uint8_t* out) {
+    if (size_ - offset_ < 1) {
+      return false;
+    }
+    *out = data_[offset_++];
+    return true;
+  }
+
+  bool ReadUint32(uint32_t* out) {
+    if (size_ - offset_ < 4) {
+      return false;
+    }
+    *out = static_cast<uint32_t>(data_[offset_]) |
+           static_cast<uint32_t>(data_[offset_ + 1]) << 8 |
+           static_cast<uint32_t>(data_[offset_ + 2]) << 16 |
+           static_cast<uint32_t>(data_[offset_ + 3]) << 24;
+    offset_ += 4;
+    return true;
+  }
+
+  bool ReadString(std::string* out) {
+    uint32_t length;
+    if (!ReadUint32(&length) || size_ - offset_ < length) {
+      return false;
+    }
+    out->assign(reinterpret_cast<const char*>(data_ + offset_), length);
+    offset_ += length;
+    return true;
+  }
+
+  bool ReadStrings(std::vector<std::string>* out) {
+    uint32_t count;
+    // Every string takes at least 4 bytes, which bounds `count` before
+    // reserving.
+    if (!ReadUint32(&count) || (size_ - offset_) / 4 < count) {
+      return false;
+    }
+    out->resize(count);
+    for (auto& string : *out) {
+      if (!ReadString(&string)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool AtEnd() const { return offset_ == size_; }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+}  // namespace
+
 namespace adblock {
 
 bool SetDomainResolver(DomainResolverCallback resolver) {
@@ -26,6 +101,11 @@ const std::string ConvertRulesToContentBlockingRules(const std::string& rules) {
 }
 #endif
 
+CosmeticResources::CosmeticResources() = default;
+CosmeticResources::~CosmeticResources() = default;
+CosmeticResources::CosmeticResources(CosmeticResources&&) = default;
+CosmeticResources& CosmeticResources::operator=(CosmeticResources&&) = default;
+
 FilterListMetadata::FilterListMetadata() = default;
 
 FilterListMetadata::FilterListMetadata(C_FilterListMetadata* metadata) {
@@ -68,8 +148,28 @@ engineFromBufferWithMetadata(const char* data, size_t data_size) {
   return std::make_pair(std::move(metadata), std::move(engine));
 }
 
+std::unique_ptr<Engine> engineFromBuffers(
+    const std::vector<std::pair<const char*, size_t>>& lists) {
+  std::vector<const char*> datas;
+  std::vector<size_t> data_sizes;
+  datas.reserve(lists.size());
+  data_sizes.reserve(lists.size());
+  for (const auto& list : lists) {
+    datas.push_back(list.first);
+    data_sizes.push_back(list.second);
+  }
+
+  C_FilterListSources* c_sources;
+  C_Engine* c_engine = engine_create_from_buffers(
+      datas.data(), data_sizes.data(), lists.size(), &c_sources);
+  return std::make_unique<Engine>(c_engine, c_sources);
+}
+
 Engine::Engine(C_Engine* c_engine) : raw(c_engine) {}
 
+Engine::Engine(C_Engine* c_engine, C_FilterListSources* c_sources)
+    : raw(c_engine), sources(c_sources) {}
+
 Engine::Engine() : raw(engine_create("")) {}
 
 Engine::Engine(const std::string& rules) : raw(engine_create(rules.c_str())) {}
@@ -106,6 +206,43 @@ void Engine::matches(const std::string& url,
   }
 }
 
+void Engine::matchesWithSource(const std::string& url,
+                               const std::string& host,
+                               const std::string& tab_host,
+                               bool is_third_party,
+                               const std::string& resource_type,
+                               bool* did_match_rule,
+                               bool* did_match_exception,
+                               bool* did_match_important,
+                               std::string* redirect,
+                               std::string* rewritten_url,
+                               int* source_index) {
+  char* redirect_char_ptr = nullptr;
+  char* rewritten_url_ptr = nullptr;
+  int32_t c_source_index = -1;
+  engine_match_with_source(raw, sources, url.c_str(), host.c_str(),
+                           tab_host.c_str(), is_third_party,
+                           resource_type.c_str(), did_match_rule,
+                           did_match_exception, did_match_important,
+                           &redirect_char_ptr, &rewritten_url_ptr,
+                           &c_source_index);
+  if (redirect_char_ptr) {
+    if (redirect) {
+      *redirect = redirect_char_ptr;
+    }
+    c_char_buffer_destroy(redirect_char_ptr);
+  }
+  if (rewritten_url_ptr) {
+    if (rewritten_url) {
+      *rewritten_url = rewritten_url_ptr;
+    }
+    c_char_buffer_destroy(rewritten_url_ptr);
+  }
+  if (source_index) {
+    *source_index = c_source_index;
+  }
+}
+
 std::string Engine::getCspDirectives(const std::string& url,
                                      const std::string& host,
                                      const std::string& tab_host,
@@ -158,23 +295,9 @@ const std::string Engine::hiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
-  std::vector<const char*> classes_raw;
-  classes_raw.reserve(classes.size());
-  for (const auto& classe : classes) {
-    classes_raw.push_back(classe.c_str());
-  }
-
-  std::vector<const char*> ids_raw;
-  ids_raw.reserve(ids.size());
-  for (const auto& id : ids) {
-    ids_raw.push_back(id.c_str());
-  }
-
-  std::vector<const char*> exceptions_raw;
-  exceptions_raw.reserve(exceptions.size());
-  for (const auto& exception : exceptions) {
-    exceptions_raw.push_back(exception.c_str());
-  }
+  std::vector<const char*> classes_raw = ToRawStrings(classes);
+  std::vector<const char*> ids_raw = ToRawStrings(ids);
+  std::vector<const char*> exceptions_raw = ToRawStrings(exceptions);
 
   char* stylesheet_raw = engine_hidden_class_id_selectors(
       raw, classes_raw.data(), classes.size(), ids_raw.data(), ids.size(),
@@ -185,7 +308,61 @@ const std::string Engine::hiddenClassIdSelectors(
   return stylesheet;
 }
 
+absl::optional<CosmeticResources> Engine::urlCosmeticResourcesBinary(
+    const std::string& url) {
+  size_t size = 0;
+  uint8_t* buffer =
+      engine_url_cosmetic_resources_binary(raw, url.c_str(), &size);
+
+  CosmeticResources resources;
+  BinaryReader reader(buffer, size);
+  uint8_t generichide = 0;
+  uint32_t style_selectors_count = 0;
+  bool ok = reader.ReadByte(&generichide) &&
+            reader.ReadStrings(&resources.hide_selectors) &&
+            reader.ReadUint32(&style_selectors_count);
+  for (uint32_t i = 0; ok && i < style_selectors_count; i++) {
+    std::pair<std::string, std::vector<std::string>> entry;
+    ok = reader.ReadString(&entry.first) && reader.ReadStrings(&entry.second);
+    resources.style_selectors.push_back(std::move(entry));
+  }
+  ok = ok && reader.ReadStrings(&resources.exceptions) &&
+       reader.ReadString(&resources.injected_script) && reader.AtEnd();
+
+  c_byte_buffer_destroy(buffer, size);
+  if (!ok) {
+    return absl::nullopt;
+  }
+  resources.generichide = generichide != 0;
+  return resources;
+}
+
+absl::optional<std::vector<std::string>> Engine::hiddenClassIdSelectorsBinary(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions) {
+  std::vector<const char*> classes_raw = ToRawStrings(classes);
+  std::vector<const char*> ids_raw = ToRawStrings(ids);
+  std::vector<const char*> exceptions_raw = ToRawStrings(exceptions);
+
+  size_t size = 0;
+  uint8_t* buffer = engine_hidden_class_id_selectors_binary(
+      raw, classes_raw.data(), classes.size(), ids_raw.data(), ids.size(),
+      exceptions_raw.data(), exceptions.size(), &size);
+
+  std::vector<std::string> selectors;
+  BinaryReader reader(buffer, size);
+  const bool ok = reader.ReadStrings(&selectors) && reader.AtEnd();
+
+  c_byte_buffer_destroy(buffer, size);
+  if (!ok) {
+    return absl::nullopt;
+  }
+  return selectors;
+}
+
 Engine::~Engine() {
+  filter_list_sources_destroy(sources);
   engine_destroy(raw);
 }
 
@@ -60,12 +60,32 @@ typedef ADBLOCK_EXPORT struct FilterListMetadata {
   FilterListMetadata(const FilterListMetadata&) = delete;
 } FilterListMetadata;
 
+// Cosmetic filtering resources for a single URL, as returned by
+// `Engine::urlCosmeticResourcesBinary`.
+typedef ADBLOCK_EXPORT struct CosmeticResources {
+  CosmeticResources();
+  ~CosmeticResources();
+
+  CosmeticResources(CosmeticResources&&);
+  CosmeticResources& operator=(CosmeticResources&&);
+
+  std::vector<std::string> hide_selectors;
+  std::vector<std::pair<std::string, std::vector<std::string>>> style_selectors;
+  std::vector<std::string> exceptions;
+  std::string injected_script;
+  bool generichide = false;
+
+ private:
+  CosmeticResources(const CosmeticResources&) = delete;
+} CosmeticResources;
+
 class ADBLOCK_EXPORT Engine {
  public:
   Engine();
   explicit Engine(C_Engine* c_engine);
   explicit Engine(const std::string& rules);
   Engine(const char* data, size_t data_size);
+  Engine(C_Engine* c_engine, C_FilterListSources* c_sources);
   void matches(const std::string& url,
                const std::string& host,
                const std::string& tab_host,
@@ -76,6 +96,19 @@ class ADBLOCK_EXPORT Engine {
                bool* did_match_important,
                std::string* redirect,
                std::string* rewritten_url);
+  // Only valid for engines created by `engineFromBuffers`. `source_index` is
+  // set to the index of the list the match was attributed to, or -1.
+  void matchesWithSource(const std::string& url,
+                         const std::string& host,
+                         const std::string& tab_host,
+                         bool is_third_party,
+                         const std::string& resource_type,
+                         bool* did_match_rule,
+                         bool* did_match_exception,
+                         bool* did_match_important,
+                         std::string* redirect,
+                         std::string* rewritten_url,
+                         int* source_index);
   std::string getCspDirectives(const std::string& url,
                                const std::string& host,
                                const std::string& tab_host,
@@ -94,6 +127,15 @@ class ADBLOCK_EXPORT Engine {
       const std::vector<std::string>& classes,
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
+  // Same as `urlCosmeticResources` and `hiddenClassIdSelectors`, but decoded
+  // from a compact binary buffer rather than parsed from JSON. Returns nullopt
+  // if the buffer is malformed.
+  absl::optional<CosmeticResources> urlCosmeticResourcesBinary(
+      const std::string& url);
+  absl::optional<std::vector<std::string>> hiddenClassIdSelectorsBinary(
+      const std::vector<std::string>& classes,
+      const std::vector<std::string>& ids,
+      const std::vector<std::string>& exceptions);
   ~Engine();
 
   Engine(Engine&&) = default;
@@ -102,12 +144,17 @@ class ADBLOCK_EXPORT Engine {
   Engine(const Engine&) = delete;
   void operator=(const Engine&) = delete;
   raw_ptr<C_Engine> raw = nullptr;
+  raw_ptr<C_FilterListSources> sources = nullptr;
 };
 
 std::pair<FilterListMetadata, std::unique_ptr<Engine>> engineWithMetadata(
     const std::string& rules);
 std::pair<FilterListMetadata, std::unique_ptr<Engine>>
 engineFromBufferWithMetadata(const char* data, size_t data_size);
+// Compiles the network filters of all `lists` into a single engine, whose
+// matches can be attributed to their list through `matchesWithSource`.
+std::unique_ptr<Engine> engineFromBuffers(
+    const std::vector<std::pair<const char*, size_t>>& lists);
 
 }  // namespace adblock
 
@@ -6,6 +6,7 @@
 #include "brave/components/brave_perf_predictor/browser/named_third_party_registry.h"
 
 #include <tuple>
+#include <utility>
 
 #include "base/bind.h"
 #include "base/containers/flat_set.h"
@@ -28,6 +29,8 @@ namespace brave_perf_predictor {
 
 namespace {
 
+constexpr size_t kEntityByHostCacheSize = 512;
+
 std::tuple<base::flat_map<std::string, std::string>,
            base::flat_map<std::string, std::string>>
 ParseMappings(const base::StringPiece entities, bool discard_irrelevant) {
@@ -105,6 +108,7 @@ bool NamedThirdPartyRegistry::LoadMappings(const base::StringPiece entities,
   // Reset previous mappings
   entity_by_domain_.clear();
   entity_by_root_domain_.clear();
+  entity_by_host_cache_.Clear();
   initialized_ = false;
 
   tie(entity_by_domain_, entity_by_root_domain_) =
@@ -120,6 +124,7 @@ void NamedThirdPartyRegistry::UpdateMappings(
     std::tuple<base::flat_map<std::string, std::string>,
                base::flat_map<std::string, std::string>> entity_mappings) {
   tie(entity_by_domain_, entity_by_root_domain_) = entity_mappings;
+  entity_by_host_cache_.Clear();
   VLOG(2) << "Loaded " << entity_by_domain_.size() << " mappings by domain and "
           << entity_by_root_domain_.size() << " by root domain; size";
   initialized_ = true;
@@ -136,23 +141,31 @@ absl::optional<std::string> NamedThirdPartyRegistry::GetThirdParty(
   if (!url.is_valid())
     return absl::nullopt;
 
-  if (url.has_host()) {
-    auto domain_entry = entity_by_domain_.find(url.host());
-    if (domain_entry != entity_by_domain_.end())
-      return domain_entry->second;
+  if (!url.has_host())
+    return absl::nullopt;
+
+  if (auto cached_entity = entity_by_host_cache_.Get(url.host()))
+    return std::move(*cached_entity);
 
+  absl::optional<std::string> entity;
+  auto domain_entry = entity_by_domain_.find(url.host());
+  if (domain_entry != entity_by_domain_.end()) {
+    entity = domain_entry->second;
+  } else {
     auto root_domain = net::registry_controlled_domains::GetDomainAndRegistry(
         url, net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
     auto root_domain_entry = entity_by_root_domain_.find(root_domain);
     if (root_domain_entry != entity_by_root_domain_.end())
-      return root_domain_entry->second;
+      entity = root_domain_entry->second;
   }
 
-  return absl::nullopt;
+  entity_by_host_cache_.Put(url.host(), entity);
+  return entity;
 }
 
-NamedThirdPartyRegistry::NamedThirdPartyRegistry() = default;
+NamedThirdPartyRegistry::NamedThirdPartyRegistry()
+    : entity_by_host_cache_(kEntityByHostCacheSize) {}
 
 NamedThirdPartyRegistry::~NamedThirdPartyRegistry() = default;
 
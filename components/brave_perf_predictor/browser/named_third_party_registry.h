@@ -12,6 +12,7 @@
 #include "base/containers/flat_map.h"
 #include "base/memory/weak_ptr.h"
 #include "base/values.h"
+#include "brave/base/containers/sharded_lru_cache.h"
 #include "components/keyed_service/core/keyed_service.h"
 
 namespace brave_perf_predictor {
@@ -46,6 +47,10 @@ class NamedThirdPartyRegistry : public KeyedService {
   bool initialized_ = false;
   base::flat_map<std::string, std::string> entity_by_domain_;
   base::flat_map<std::string, std::string> entity_by_root_domain_;
+  // Entity (or its absence) by host, which saves the registry-controlled
+  // domain lookup for the hosts a page keeps loading resources from.
+  mutable brave::ShardedLRUCache<std::string, absl::optional<std::string>>
+      entity_by_host_cache_;
 
   base::WeakPtrFactory<NamedThirdPartyRegistry> weak_factory_{this};
 };
@@ -0,0 +1,80 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include "base/metrics/histogram_macros.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
+
+namespace brave_shields {
+
+AdBlockDecisionCache::Decision::Decision() = default;
+AdBlockDecisionCache::Decision::Decision(const Decision&) = default;
+AdBlockDecisionCache::Decision& AdBlockDecisionCache::Decision::operator=(
+    const Decision&) = default;
+AdBlockDecisionCache::Decision::~Decision() = default;
+
+AdBlockDecisionCache::AdBlockDecisionCache(size_t max_size)
+    : entries_(max_size) {
+  // Created on the UI thread, used exclusively on the adblock task runner.
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+AdBlockDecisionCache::~AdBlockDecisionCache() = default;
+
+absl::optional<AdBlockDecisionCache::Decision> AdBlockDecisionCache::Get(
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool aggressive_blocking,
+    uint64_t generation) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  auto it = entries_.Get(
+      MakeKey(url, resource_type, tab_host, aggressive_blocking));
+  bool hit = it != entries_.end();
+  if (hit) {
+    // Out of the entries found, how many were invalidated by a list change.
+    const bool stale = it->second.generation != generation;
+    UMA_HISTOGRAM_BOOLEAN("Brave.Adblock.DecisionCache.StaleEntry", stale);
+    if (stale) {
+      entries_.Erase(it);
+      hit = false;
+    }
+  }
+
+  UMA_HISTOGRAM_BOOLEAN("Brave.Adblock.DecisionCache.Hit", hit);
+  if (!hit) {
+    return absl::nullopt;
+  }
+  return it->second.decision;
+}
+
+void AdBlockDecisionCache::Put(const GURL& url,
+                               blink::mojom::ResourceType resource_type,
+                               const std::string& tab_host,
+                               bool aggressive_blocking,
+                               uint64_t generation,
+                               const Decision& decision) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  entries_.Put(MakeKey(url, resource_type, tab_host, aggressive_blocking),
+               Entry{generation, decision});
+}
+
+// static
+std::string AdBlockDecisionCache::MakeKey(
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool aggressive_blocking) {
+  // Neither a host nor a number can contain a space, so the key is
+  // unambiguous.
+  return base::StrCat({base::NumberToString(static_cast<int>(resource_type)),
+                       aggressive_blocking ? " a " : " s ", tab_host, " ",
+                       url.possibly_invalid_spec()});
+}
+
+}  // namespace brave_shields
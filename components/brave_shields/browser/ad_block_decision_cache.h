@@ -0,0 +1,84 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "base/containers/lru_cache.h"
+#include "base/sequence_checker.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+// Remembers the outcome of recent `AdBlockService::ShouldStartRequest` calls,
+// since pages keep requesting the same ad and tracker URLs over and over.
+//
+// Every entry is stamped with the engine generation it was computed under
+// (see `AdBlockEngine::GetGeneration`); entries from an older generation are
+// treated as misses, so reloading any list or toggling a tag invalidates the
+// whole cache without having to walk it.
+//
+// Must only be used on the adblock task runner.
+class AdBlockDecisionCache {
+ public:
+  struct Decision {
+    Decision();
+    Decision(const Decision&);
+    Decision& operator=(const Decision&);
+    ~Decision();
+
+    bool did_match_rule = false;
+    bool did_match_exception = false;
+    bool did_match_important = false;
+    std::string mock_data_url;
+    std::string rewritten_url;
+  };
+
+  explicit AdBlockDecisionCache(size_t max_size = kDefaultMaxSize);
+  AdBlockDecisionCache(const AdBlockDecisionCache&) = delete;
+  AdBlockDecisionCache& operator=(const AdBlockDecisionCache&) = delete;
+  ~AdBlockDecisionCache();
+
+  absl::optional<Decision> Get(const GURL& url,
+                               blink::mojom::ResourceType resource_type,
+                               const std::string& tab_host,
+                               bool aggressive_blocking,
+                               uint64_t generation);
+  void Put(const GURL& url,
+           blink::mojom::ResourceType resource_type,
+           const std::string& tab_host,
+           bool aggressive_blocking,
+           uint64_t generation,
+           const Decision& decision);
+
+  size_t size() const { return entries_.size(); }
+
+  static constexpr size_t kDefaultMaxSize = 2000;
+
+ private:
+  struct Entry {
+    uint64_t generation;
+    Decision decision;
+  };
+
+  static std::string MakeKey(const GURL& url,
+                             blink::mojom::ResourceType resource_type,
+                             const std::string& tab_host,
+                             bool aggressive_blocking);
+
+  base::HashingLRUCache<std::string, Entry> entries_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
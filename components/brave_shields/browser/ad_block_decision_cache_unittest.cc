@@ -0,0 +1,108 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include "base/test/metrics/histogram_tester.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+constexpr blink::mojom::ResourceType kScript =
+    blink::mojom::ResourceType::kScript;
+
+AdBlockDecisionCache::Decision BlockDecision() {
+  AdBlockDecisionCache::Decision decision;
+  decision.did_match_rule = true;
+  decision.mock_data_url = "data:text/javascript,";
+  return decision;
+}
+
+}  // namespace
+
+TEST(AdBlockDecisionCacheTest, HitAndMiss) {
+  base::HistogramTester histogram_tester;
+  AdBlockDecisionCache cache;
+  const GURL url("https://ads.example.com/ad.js");
+
+  EXPECT_FALSE(cache.Get(url, kScript, "brave.com", false, 1));
+  cache.Put(url, kScript, "brave.com", false, 1, BlockDecision());
+
+  auto decision = cache.Get(url, kScript, "brave.com", false, 1);
+  ASSERT_TRUE(decision);
+  EXPECT_TRUE(decision->did_match_rule);
+  EXPECT_FALSE(decision->did_match_exception);
+  EXPECT_EQ(decision->mock_data_url, "data:text/javascript,");
+
+  histogram_tester.ExpectBucketCount("Brave.Adblock.DecisionCache.Hit", true,
+                                     1);
+  histogram_tester.ExpectBucketCount("Brave.Adblock.DecisionCache.Hit", false,
+                                     1);
+}
+
+TEST(AdBlockDecisionCacheTest, KeyIncludesContext) {
+  AdBlockDecisionCache cache;
+  const GURL url("https://ads.example.com/ad.js");
+  cache.Put(url, kScript, "brave.com", false, 1, BlockDecision());
+
+  EXPECT_FALSE(cache.Get(url, kScript, "example.com", false, 1));
+  EXPECT_FALSE(
+      cache.Get(url, blink::mojom::ResourceType::kImage, "brave.com", false, 1));
+  EXPECT_FALSE(cache.Get(url, kScript, "brave.com", true, 1));
+  EXPECT_TRUE(cache.Get(url, kScript, "brave.com", false, 1));
+}
+
+TEST(AdBlockDecisionCacheTest, StaleGenerationIsMiss) {
+  base::HistogramTester histogram_tester;
+  AdBlockDecisionCache cache;
+  const GURL url("https://ads.example.com/ad.js");
+  cache.Put(url, kScript, "brave.com", false, 1, BlockDecision());
+
+  EXPECT_TRUE(cache.Get(url, kScript, "brave.com", false, 1));
+  EXPECT_FALSE(cache.Get(url, kScript, "brave.com", false, 2));
+  // The stale entry is dropped rather than kept around.
+  EXPECT_EQ(cache.size(), 0u);
+  // Nothing is recorded when there is no entry at all.
+  EXPECT_FALSE(cache.Get(url, kScript, "brave.com", false, 2));
+
+  histogram_tester.ExpectBucketCount("Brave.Adblock.DecisionCache.StaleEntry",
+                                     false, 1);
+  histogram_tester.ExpectBucketCount("Brave.Adblock.DecisionCache.StaleEntry",
+                                     true, 1);
+}
+
+TEST(AdBlockDecisionCacheTest, BumpGenerationInvalidates) {
+  AdBlockDecisionCache cache;
+  const GURL url("https://ads.example.com/ad.js");
+  const uint64_t generation = AdBlockEngine::GetGeneration();
+  cache.Put(url, kScript, "brave.com", false, generation, BlockDecision());
+
+  AdBlockEngine::BumpGeneration();
+  EXPECT_NE(AdBlockEngine::GetGeneration(), generation);
+  EXPECT_FALSE(cache.Get(url, kScript, "brave.com", false,
+                         AdBlockEngine::GetGeneration()));
+}
+
+TEST(AdBlockDecisionCacheTest, Bounded) {
+  AdBlockDecisionCache cache(2);
+  cache.Put(GURL("https://a.com/"), kScript, "brave.com", false, 1,
+            BlockDecision());
+  cache.Put(GURL("https://b.com/"), kScript, "brave.com", false, 1,
+            BlockDecision());
+  cache.Put(GURL("https://c.com/"), kScript, "brave.com", false, 1,
+            BlockDecision());
+
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_FALSE(
+      cache.Get(GURL("https://a.com/"), kScript, "brave.com", false, 1));
+  EXPECT_TRUE(
+      cache.Get(GURL("https://c.com/"), kScript, "brave.com", false, 1));
+}
+
+}  // namespace brave_shields
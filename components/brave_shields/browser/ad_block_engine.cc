@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_shields/browser/ad_block_engine.h"
 
+#include <atomic>
 #include <set>
 #include <string>
 #include <utility>
@@ -12,8 +13,8 @@
 
 #include "base/bind.h"
 #include "base/containers/contains.h"
+#include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
-#include "base/json/json_reader.h"
 #include "base/memory/ptr_util.h"
 #include "base/ranges/algorithm.h"
 #include "base/strings/utf_string_conversions.h"
@@ -28,6 +29,12 @@ using namespace net::registry_controlled_domains;  // NOLINT
 
 namespace {
 
+std::atomic<uint64_t> g_engine_generation{0};
+
+void BumpEngineGeneration() {
+  g_engine_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
 std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
   std::string filter_option = "";
   switch (resource_type) {
@@ -100,7 +107,19 @@ namespace brave_shields {
 
 AdBlockEngine::AdBlockEngine() : ad_block_client_(new adblock::Engine()) {}
 
-AdBlockEngine::~AdBlockEngine() = default;
+AdBlockEngine::~AdBlockEngine() {
+  BumpEngineGeneration();
+}
+
+// static
+uint64_t AdBlockEngine::GetGeneration() {
+  return g_engine_generation.load(std::memory_order_relaxed);
+}
+
+// static
+void AdBlockEngine::BumpGeneration() {
+  BumpEngineGeneration();
+}
 
 void AdBlockEngine::ShouldStartRequest(const GURL& url,
                                        blink::mojom::ResourceType resource_type,
@@ -111,6 +130,21 @@ void AdBlockEngine::ShouldStartRequest(const GURL& url,
                                        bool* did_match_important,
                                        std::string* mock_data_url,
                                        std::string* rewritten_url) {
+  ShouldStartRequest(url, resource_type, tab_host, aggressive_blocking,
+                     did_match_rule, did_match_exception, did_match_important,
+                     mock_data_url, rewritten_url, nullptr);
+}
+
+void AdBlockEngine::ShouldStartRequest(const GURL& url,
+                                       blink::mojom::ResourceType resource_type,
+                                       const std::string& tab_host,
+                                       bool aggressive_blocking,
+                                       bool* did_match_rule,
+                                       bool* did_match_exception,
+                                       bool* did_match_important,
+                                       std::string* mock_data_url,
+                                       std::string* rewritten_url,
+                                       std::string* matched_source) {
   // Determine third-party here so the library doesn't need to figure it out.
   // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
   // a URL or origin and not a string to a host name.
@@ -118,15 +152,25 @@ void AdBlockEngine::ShouldStartRequest(const GURL& url,
       url,
       url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
       INCLUDE_PRIVATE_REGISTRIES);
-  ad_block_client_->matches(url.spec(), url.host(), tab_host, is_third_party,
-                            ResourceTypeToString(resource_type), did_match_rule,
-                            did_match_exception, did_match_important,
-                            mock_data_url, rewritten_url);
 
-  // LOG(ERROR) << "AdBlockEngine::ShouldStartRequest(), host: "
-  //  << tab_host
-  //  << ", resource type: " << resource_type
-  //  << ", url.spec(): " << url.spec();
+  if (source_ids_.empty()) {
+    ad_block_client_->matches(url.spec(), url.host(), tab_host, is_third_party,
+                              ResourceTypeToString(resource_type),
+                              did_match_rule, did_match_exception,
+                              did_match_important, mock_data_url,
+                              rewritten_url);
+    return;
+  }
+
+  int source_index = -1;
+  ad_block_client_->matchesWithSource(
+      url.spec(), url.host(), tab_host, is_third_party,
+      ResourceTypeToString(resource_type), did_match_rule, did_match_exception,
+      did_match_important, mock_data_url, rewritten_url, &source_index);
+  if (matched_source && source_index >= 0 &&
+      static_cast<size_t>(source_index) < source_ids_.size()) {
+    *matched_source = source_ids_[source_index];
+  }
 }
 
 absl::optional<std::string> AdBlockEngine::GetCspDirectives(
@@ -152,6 +196,7 @@ absl::optional<std::string> AdBlockEngine::GetCspDirectives(
 }
 
 void AdBlockEngine::EnableTag(const std::string& tag, bool enabled) {
+  BumpEngineGeneration();
   if (enabled) {
     if (tags_.find(tag) == tags_.end()) {
       ad_block_client_->addTag(tag);
@@ -164,6 +209,7 @@ void AdBlockEngine::EnableTag(const std::string& tag, bool enabled) {
 }
 
 void AdBlockEngine::AddResources(const std::string& resources) {
+  BumpEngineGeneration();
   ad_block_client_->addResources(resources);
 }
 
@@ -171,24 +217,32 @@ bool AdBlockEngine::TagExists(const std::string& tag) {
   return base::Contains(tags_, tag);
 }
 
-absl::optional<base::Value> AdBlockEngine::UrlCosmeticResources(
-    const std::string& url) {
-  return base::JSONReader::Read(ad_block_client_->urlCosmeticResources(url));
+cosmetic_filters::mojom::UrlCosmeticResourcesPtr
+AdBlockEngine::UrlCosmeticResources(const std::string& url) {
+  absl::optional<adblock::CosmeticResources> resources =
+      ad_block_client_->urlCosmeticResourcesBinary(url);
+  if (!resources) {
+    return nullptr;
+  }
+
+  auto result = cosmetic_filters::mojom::UrlCosmeticResources::New();
+  result->hide_selectors = std::move(resources->hide_selectors);
+  result->style_selectors =
+      base::flat_map<std::string, std::vector<std::string>>(
+          std::move(resources->style_selectors));
+  result->exceptions = std::move(resources->exceptions);
+  result->injected_script = std::move(resources->injected_script);
+  result->generichide = resources->generichide;
+  return result;
 }
 
-base::Value::List AdBlockEngine::HiddenClassIdSelectors(
+std::vector<std::string> AdBlockEngine::HiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
-  absl::optional<base::Value> result = base::JSONReader::Read(
-      ad_block_client_->hiddenClassIdSelectors(classes, ids, exceptions));
-
-  if (!result) {
-    return base::Value::List();
-  } else {
-    DCHECK(result->is_list());
-    return std::move(result->GetList());
-  }
+  return ad_block_client_
+      ->hiddenClassIdSelectorsBinary(classes, ids, exceptions)
+      .value_or(std::vector<std::string>());
 }
 
 absl::optional<adblock::FilterListMetadata> AdBlockEngine::Load(
@@ -203,10 +257,24 @@ absl::optional<adblock::FilterListMetadata> AdBlockEngine::Load(
   }
 }
 
+void AdBlockEngine::UpdateMergedAdBlockClient(
+    std::unique_ptr<adblock::Engine> ad_block_client,
+    std::vector<std::string> source_ids) {
+  BumpEngineGeneration();
+  ad_block_client_ = std::move(ad_block_client);
+  source_ids_ = std::move(source_ids);
+  AddKnownTagsToAdBlockInstance();
+  if (test_observer_) {
+    test_observer_->OnEngineUpdated();
+  }
+}
+
 void AdBlockEngine::UpdateAdBlockClient(
     std::unique_ptr<adblock::Engine> ad_block_client,
     const std::string& resources_json) {
+  BumpEngineGeneration();
   ad_block_client_ = std::move(ad_block_client);
+  source_ids_.clear();
   AddResources(resources_json);
   AddKnownTagsToAdBlockInstance();
   if (test_observer_) {
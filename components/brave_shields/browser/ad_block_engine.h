@@ -16,9 +16,9 @@
 
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list_types.h"
-#include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/gurl.h"
 
@@ -56,6 +56,19 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
                           bool* did_match_important,
                           std::string* mock_data_url,
                           std::string* rewritten_url);
+  // Same as above, additionally reporting the id of the filter list the match
+  // was attributed to in `matched_source` when the engine was installed by
+  // `UpdateMergedAdBlockClient`.
+  void ShouldStartRequest(const GURL& url,
+                          blink::mojom::ResourceType resource_type,
+                          const std::string& tab_host,
+                          bool aggressive_blocking,
+                          bool* did_match_rule,
+                          bool* did_match_exception,
+                          bool* did_match_important,
+                          std::string* mock_data_url,
+                          std::string* rewritten_url,
+                          std::string* matched_source);
   absl::optional<std::string> GetCspDirectives(
       const GURL& url,
       blink::mojom::ResourceType resource_type,
@@ -64,8 +77,9 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
-  absl::optional<base::Value> UrlCosmeticResources(const std::string& url);
-  base::Value::List HiddenClassIdSelectors(
+  cosmetic_filters::mojom::UrlCosmeticResourcesPtr UrlCosmeticResources(
+      const std::string& url);
+  std::vector<std::string> HiddenClassIdSelectors(
       const std::vector<std::string>& classes,
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
@@ -75,6 +89,13 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
       const DATFileDataBuffer& dat_buf,
       const std::string& resources_json);
 
+  // Installs an engine compiled from several filter lists by
+  // `adblock::engineFromBuffers`. `source_ids` holds the id of each list, in
+  // the order they were compiled.
+  void UpdateMergedAdBlockClient(
+      std::unique_ptr<adblock::Engine> ad_block_client,
+      std::vector<std::string> source_ids);
+
   class TestObserver : public base::CheckedObserver {
    public:
     virtual void OnEngineUpdated() = 0;
@@ -83,6 +104,15 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
   void AddObserverForTest(TestObserver* observer);
   void RemoveObserverForTest();
 
+  // Returns a counter that changes whenever any engine in the process may
+  // start returning different results, i.e. when one is reloaded, destroyed,
+  // has resources added or has a tag toggled. Used to invalidate cached
+  // matching decisions.
+  static uint64_t GetGeneration();
+  // Changes the generation for anything that affects matching outside of an
+  // engine, e.g. a list being enabled or disabled.
+  static void BumpGeneration();
+
  protected:
   void AddKnownTagsToAdBlockInstance();
   void UpdateAdBlockClient(std::unique_ptr<adblock::Engine> ad_block_client,
@@ -103,6 +133,8 @@ class AdBlockEngine : public base::SupportsWeakPtr<AdBlockEngine> {
   friend class ::PerfPredictorTabHelperTest;
 
   std::set<std::string> tags_;
+  // Only set for engines compiled from multiple lists.
+  std::vector<std::string> source_ids_;
 
   raw_ptr<TestObserver> test_observer_ = nullptr;
 };
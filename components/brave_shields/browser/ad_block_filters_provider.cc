@@ -5,6 +5,8 @@
 
 #include "brave/components/brave_shields/browser/ad_block_filters_provider.h"
 
+#include <utility>
+
 namespace brave_shields {
 
 AdBlockFiltersProvider::AdBlockFiltersProvider() = default;
@@ -36,6 +38,12 @@ void AdBlockFiltersProvider::LoadDAT(
                                weak_factory_.GetWeakPtr(), observer));
 }
 
+void AdBlockFiltersProvider::ReloadDATBuffer(
+    base::OnceCallback<void(bool deserialize, const DATFileDataBuffer& dat_buf)>
+        cb) {
+  LoadDATBuffer(std::move(cb));
+}
+
 void AdBlockFiltersProvider::OnLoad(AdBlockFiltersProvider::Observer* observer,
                                     bool deserialize,
                                     const DATFileDataBuffer& dat_buf) {
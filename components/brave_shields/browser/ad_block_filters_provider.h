@@ -35,6 +35,11 @@ class AdBlockFiltersProvider {
   void RemoveObserver(Observer* observer);
 
   void LoadDAT(Observer* observer);
+  // Loads the filters again and hands them to |cb| only, without notifying
+  // any observer.
+  void ReloadDATBuffer(
+      base::OnceCallback<void(bool deserialize,
+                              const DATFileDataBuffer& dat_buf)> cb);
 
   virtual bool Delete() &&;
 
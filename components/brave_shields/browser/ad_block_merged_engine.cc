@@ -0,0 +1,212 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_merged_engine.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/task/thread_pool.h"
+#include "base/time/time.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Lists tend to finish loading in bursts (e.g. at startup), so wait a little
+// for the rest of them before recompiling.
+constexpr base::TimeDelta kRebuildDelay = base::Seconds(2);
+
+std::unique_ptr<adblock::Engine> BuildEngine(
+    std::vector<scoped_refptr<base::RefCountedBytes>> lists,
+    const std::string& resources_json) {
+  const base::TimeTicks start = base::TimeTicks::Now();
+
+  std::vector<std::pair<const char*, size_t>> buffers;
+  buffers.reserve(lists.size());
+  for (const auto& list : lists) {
+    buffers.emplace_back(reinterpret_cast<const char*>(list->front()),
+                         list->size());
+  }
+
+  auto ad_block_client = adblock::engineFromBuffers(buffers);
+  ad_block_client->addResources(resources_json);
+
+  UMA_HISTOGRAM_TIMES("Brave.Adblock.MergedEngineBuildTime",
+                      base::TimeTicks::Now() - start);
+  return ad_block_client;
+}
+
+}  // namespace
+
+AdBlockMergedEngine::Source::Source() = default;
+AdBlockMergedEngine::Source::Source(const Source&) = default;
+AdBlockMergedEngine::Source& AdBlockMergedEngine::Source::operator=(
+    const Source&) = default;
+AdBlockMergedEngine::Source::~Source() = default;
+
+AdBlockMergedEngine::AdBlockMergedEngine() {
+  // Created on the UI thread, used exclusively on the adblock task runner.
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+AdBlockMergedEngine::~AdBlockMergedEngine() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+void AdBlockMergedEngine::ShouldStartRequest(
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool aggressive_blocking,
+    bool* did_match_rule,
+    bool* did_match_exception,
+    bool* did_match_important,
+    std::string* mock_data_url,
+    std::string* rewritten_url,
+    std::string* matched_source) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  engine_.ShouldStartRequest(url, resource_type, tab_host, aggressive_blocking,
+                             did_match_rule, did_match_exception,
+                             did_match_important, mock_data_url, rewritten_url,
+                             matched_source);
+}
+
+bool AdBlockMergedEngine::IsUpToDate() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return is_up_to_date_;
+}
+
+void AdBlockMergedEngine::AddSource(const std::string& source_id,
+                                    base::RepeatingClosure reload_list) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  sources_[source_id].reload_list = std::move(reload_list);
+}
+
+void AdBlockMergedEngine::UpdateSource(
+    const std::string& source_id,
+    scoped_refptr<base::RefCountedBytes> list) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Source& source = sources_[source_id];
+  source.list = std::move(list);
+  source.list_dropped = false;
+  source.reload_pending = false;
+  ScheduleRebuild();
+}
+
+void AdBlockMergedEngine::UpdateResources(const std::string& resources_json) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (resources_json == resources_json_) {
+    return;
+  }
+  resources_json_ = resources_json;
+  ScheduleRebuild();
+}
+
+void AdBlockMergedEngine::RemoveSource(const std::string& source_id) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (sources_.erase(source_id)) {
+    ScheduleRebuild();
+  }
+}
+
+void AdBlockMergedEngine::SetSourceEnabled(const std::string& source_id,
+                                           bool enabled) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  Source& source = sources_[source_id];
+  if (source.enabled == enabled) {
+    return;
+  }
+  source.enabled = enabled;
+  ScheduleRebuild();
+}
+
+void AdBlockMergedEngine::ScheduleRebuild() {
+  is_up_to_date_ = false;
+  rebuild_timer_.Start(FROM_HERE, kRebuildDelay,
+                       base::BindOnce(&AdBlockMergedEngine::Rebuild,
+                                      base::Unretained(this)));
+}
+
+void AdBlockMergedEngine::Rebuild() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // Any build still in flight is now stale and will be dropped on arrival.
+  generation_++;
+
+  std::vector<std::string> source_ids;
+  std::vector<scoped_refptr<base::RefCountedBytes>> lists;
+  bool waiting_for_lists = false;
+  for (auto& [source_id, source] : sources_) {
+    if (!source.enabled) {
+      continue;
+    }
+    if (source.list_dropped) {
+      // Compiling resumes once the list comes back through `UpdateSource`.
+      if (!source.reload_pending) {
+        source.reload_pending = true;
+        source.reload_list.Run();
+      }
+      waiting_for_lists = true;
+      continue;
+    }
+    if (!source.list || source.list->size() == 0) {
+      continue;
+    }
+    source_ids.push_back(source_id);
+    lists.push_back(source.list);
+  }
+
+  if (waiting_for_lists) {
+    return;
+  }
+
+  if (lists.empty()) {
+    engine_.UpdateMergedAdBlockClient(std::make_unique<adblock::Engine>(), {});
+    is_up_to_date_ = true;
+    return;
+  }
+
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&BuildEngine, std::move(lists), resources_json_),
+      base::BindOnce(&AdBlockMergedEngine::OnEngineBuilt, AsWeakPtr(),
+                     generation_, std::move(source_ids)));
+}
+
+void AdBlockMergedEngine::OnEngineBuilt(
+    uint64_t generation,
+    std::vector<std::string> source_ids,
+    std::unique_ptr<adblock::Engine> ad_block_client) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (generation != generation_) {
+    return;
+  }
+  engine_.UpdateMergedAdBlockClient(std::move(ad_block_client),
+                                    std::move(source_ids));
+  is_up_to_date_ = true;
+
+  // The per-list engines keep their own copy of the filters, so don't hold on
+  // to the text of lists that can be reloaded for the next rebuild.
+  for (auto& [source_id, source] : sources_) {
+    if (source.list && source.reload_list) {
+      source.list = nullptr;
+      source.list_dropped = true;
+    }
+  }
+}
+
+void AdBlockMergedEngine::AddObserverForTest(
+    AdBlockEngine::TestObserver* observer) {
+  engine_.AddObserverForTest(observer);
+}
+
+void AdBlockMergedEngine::RebuildNowForTest() {
+  rebuild_timer_.Stop();
+  Rebuild();
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,114 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_MERGED_ENGINE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_MERGED_ENGINE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/timer/timer.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+#include "url/gurl.h"
+
+namespace adblock {
+class Engine;
+}  // namespace adblock
+
+namespace brave_shields {
+
+// Compiles the network filters of several filter lists into a single adblock
+// engine, so that a network request needs one lookup no matter how many lists
+// are enabled. Matches are still attributed to the list they came from.
+//
+// Lists are identified by an opaque source id and are pushed in by
+// `AdBlockService::SourceProviderObserver` whenever they load. The engine is
+// recompiled on the thread pool shortly after any list changes, then swapped
+// in on the adblock task runner. Everything except construction must happen on
+// that task runner.
+//
+// Until the compiled engine covers every enabled list, `IsUpToDate` is false
+// and the per-list engines must be used instead. Once compiled, the text of
+// the lists that can be reloaded is dropped, and it is asked for again on the
+// next rebuild.
+class AdBlockMergedEngine : public base::SupportsWeakPtr<AdBlockMergedEngine> {
+ public:
+  AdBlockMergedEngine();
+  AdBlockMergedEngine(const AdBlockMergedEngine&) = delete;
+  AdBlockMergedEngine& operator=(const AdBlockMergedEngine&) = delete;
+  ~AdBlockMergedEngine();
+
+  void ShouldStartRequest(const GURL& url,
+                          blink::mojom::ResourceType resource_type,
+                          const std::string& tab_host,
+                          bool aggressive_blocking,
+                          bool* did_match_rule,
+                          bool* did_match_exception,
+                          bool* did_match_important,
+                          std::string* mock_data_url,
+                          std::string* rewritten_url,
+                          std::string* matched_source);
+
+  // Whether the compiled engine covers the current version of every enabled
+  // list.
+  bool IsUpToDate() const;
+
+  // Registers `reload_list`, which must eventually call `UpdateSource` again
+  // for `source_id`. Only the text of lists registered here is dropped once
+  // compiled.
+  void AddSource(const std::string& source_id,
+                 base::RepeatingClosure reload_list);
+  // Adds or replaces the filter list text for `source_id`.
+  void UpdateSource(const std::string& source_id,
+                    scoped_refptr<base::RefCountedBytes> list);
+  void UpdateResources(const std::string& resources_json);
+  void RemoveSource(const std::string& source_id);
+  // Disabled sources are kept around but left out of the compiled engine.
+  void SetSourceEnabled(const std::string& source_id, bool enabled);
+
+  void AddObserverForTest(AdBlockEngine::TestObserver* observer);
+  void RebuildNowForTest();
+
+ private:
+  struct Source {
+    Source();
+    Source(const Source&);
+    Source& operator=(const Source&);
+    ~Source();
+
+    scoped_refptr<base::RefCountedBytes> list;
+    // Set once `list` has been compiled and dropped.
+    bool list_dropped = false;
+    bool reload_pending = false;
+    bool enabled = true;
+    base::RepeatingClosure reload_list;
+  };
+
+  void ScheduleRebuild();
+  void Rebuild();
+  void OnEngineBuilt(uint64_t generation,
+                     std::vector<std::string> source_ids,
+                     std::unique_ptr<adblock::Engine> ad_block_client);
+
+  std::map<std::string, Source> sources_;
+  std::string resources_json_;
+  uint64_t generation_ = 0;
+  bool is_up_to_date_ = false;
+  base::OneShotTimer rebuild_timer_;
+  AdBlockEngine engine_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_MERGED_ENGINE_H_
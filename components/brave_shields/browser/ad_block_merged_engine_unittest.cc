@@ -0,0 +1,223 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/memory/ref_counted_memory.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "brave/components/adblock_rust_ffi/src/wrapper.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+#include "brave/components/brave_shields/browser/ad_block_merged_engine.h"
+#include "brave/components/brave_shields/common/adblock_domain_resolver.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+class AdBlockMergedEngineTest : public testing::Test {
+ public:
+  AdBlockMergedEngineTest() {
+    adblock::SetDomainResolver(AdBlockServiceDomainResolver);
+  }
+
+ protected:
+  void LoadLists(const std::vector<std::string>& lists) {
+    std::vector<std::pair<const char*, size_t>> buffers;
+    std::vector<std::string> source_ids;
+    for (size_t i = 0; i < lists.size(); i++) {
+      buffers.emplace_back(lists[i].data(), lists[i].size());
+      source_ids.push_back("list" + base::NumberToString(i));
+    }
+    engine_.UpdateMergedAdBlockClient(adblock::engineFromBuffers(buffers),
+                                      std::move(source_ids));
+  }
+
+  struct Result {
+    bool did_match_rule = false;
+    bool did_match_exception = false;
+    bool did_match_important = false;
+    std::string matched_source;
+  };
+
+  Result Check(const std::string& url) {
+    Result result;
+    std::string mock_data_url;
+    std::string rewritten_url;
+    engine_.ShouldStartRequest(
+        GURL(url), blink::mojom::ResourceType::kScript, "example.com", false,
+        &result.did_match_rule, &result.did_match_exception,
+        &result.did_match_important, &mock_data_url, &rewritten_url,
+        &result.matched_source);
+    return result;
+  }
+
+  AdBlockEngine engine_;
+};
+
+TEST_F(AdBlockMergedEngineTest, AttributesMatchesToTheirList) {
+  LoadLists({"||first.com^\n", "||second.com^\n", "||third.com^$important\n"});
+
+  Result result = Check("https://first.com/ad.js");
+  EXPECT_TRUE(result.did_match_rule);
+  EXPECT_EQ(result.matched_source, "list0");
+
+  result = Check("https://second.com/ad.js");
+  EXPECT_TRUE(result.did_match_rule);
+  EXPECT_EQ(result.matched_source, "list1");
+
+  result = Check("https://third.com/ad.js");
+  EXPECT_TRUE(result.did_match_important);
+  EXPECT_EQ(result.matched_source, "list2");
+
+  result = Check("https://fourth.com/ad.js");
+  EXPECT_FALSE(result.did_match_rule);
+  EXPECT_TRUE(result.matched_source.empty());
+}
+
+TEST_F(AdBlockMergedEngineTest, ExceptionsApplyAcrossLists) {
+  LoadLists({"||tracker.com^\n", "@@||tracker.com/allowed.js\n"});
+
+  Result result = Check("https://tracker.com/allowed.js");
+  EXPECT_TRUE(result.did_match_exception);
+  EXPECT_EQ(result.matched_source, "list1");
+
+  result = Check("https://tracker.com/blocked.js");
+  EXPECT_TRUE(result.did_match_rule);
+  EXPECT_FALSE(result.did_match_exception);
+  EXPECT_EQ(result.matched_source, "list0");
+}
+
+TEST_F(AdBlockMergedEngineTest, CosmeticFiltersAreIgnored) {
+  LoadLists({"example.com##.ad\n||ads.com^\n"});
+
+  Result result = Check("https://ads.com/ad.js");
+  EXPECT_TRUE(result.did_match_rule);
+  EXPECT_EQ(result.matched_source, "list0");
+}
+
+class AdBlockMergedEngineRebuildTest : public testing::Test,
+                                       public AdBlockEngine::TestObserver {
+ public:
+  AdBlockMergedEngineRebuildTest() {
+    adblock::SetDomainResolver(AdBlockServiceDomainResolver);
+    merged_engine_.AddObserverForTest(this);
+  }
+
+  // AdBlockEngine::TestObserver:
+  void OnEngineUpdated() override {
+    engine_updates_++;
+    if (run_loop_) {
+      run_loop_->Quit();
+    }
+  }
+
+ protected:
+  static scoped_refptr<base::RefCountedBytes> MakeList(
+      const std::string& list) {
+    return base::MakeRefCounted<base::RefCountedBytes>(
+        std::vector<unsigned char>(list.begin(), list.end()));
+  }
+
+  void RebuildAndWait() {
+    run_loop_ = std::make_unique<base::RunLoop>();
+    merged_engine_.RebuildNowForTest();
+    run_loop_->Run();
+    run_loop_.reset();
+  }
+
+  std::string MatchedSource(const std::string& url) {
+    bool did_match_rule = false;
+    bool did_match_exception = false;
+    bool did_match_important = false;
+    std::string mock_data_url;
+    std::string rewritten_url;
+    std::string matched_source;
+    merged_engine_.ShouldStartRequest(
+        GURL(url), blink::mojom::ResourceType::kScript, "example.com", false,
+        &did_match_rule, &did_match_exception, &did_match_important,
+        &mock_data_url, &rewritten_url, &matched_source);
+    return did_match_rule ? matched_source : std::string();
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  AdBlockMergedEngine merged_engine_;
+  std::unique_ptr<base::RunLoop> run_loop_;
+  int engine_updates_ = 0;
+};
+
+TEST_F(AdBlockMergedEngineRebuildTest, UpToDateOnlyOnceBuilt) {
+  EXPECT_FALSE(merged_engine_.IsUpToDate());
+
+  merged_engine_.UpdateSource("first", MakeList("||first.com^\n"));
+  merged_engine_.UpdateSource("second", MakeList("||second.com^\n"));
+  EXPECT_FALSE(merged_engine_.IsUpToDate());
+
+  RebuildAndWait();
+  EXPECT_TRUE(merged_engine_.IsUpToDate());
+  EXPECT_EQ(MatchedSource("https://first.com/ad.js"), "first");
+  EXPECT_EQ(MatchedSource("https://second.com/ad.js"), "second");
+
+  merged_engine_.UpdateSource("second", MakeList("||other.com^\n"));
+  EXPECT_FALSE(merged_engine_.IsUpToDate());
+
+  RebuildAndWait();
+  EXPECT_TRUE(merged_engine_.IsUpToDate());
+  EXPECT_EQ(MatchedSource("https://second.com/ad.js"), "");
+  EXPECT_EQ(MatchedSource("https://other.com/ad.js"), "second");
+}
+
+TEST_F(AdBlockMergedEngineRebuildTest, DisabledSourcesAreLeftOut) {
+  merged_engine_.UpdateSource("first", MakeList("||first.com^\n"));
+  merged_engine_.UpdateSource("second", MakeList("||second.com^\n"));
+  merged_engine_.SetSourceEnabled("second", false);
+
+  RebuildAndWait();
+  EXPECT_EQ(MatchedSource("https://first.com/ad.js"), "first");
+  EXPECT_EQ(MatchedSource("https://second.com/ad.js"), "");
+
+  merged_engine_.SetSourceEnabled("second", true);
+  EXPECT_FALSE(merged_engine_.IsUpToDate());
+
+  RebuildAndWait();
+  EXPECT_EQ(MatchedSource("https://second.com/ad.js"), "second");
+}
+
+TEST_F(AdBlockMergedEngineRebuildTest, ReloadsDroppedListsOnRebuild) {
+  int reloads = 0;
+  merged_engine_.AddSource("first", base::BindLambdaForTesting(
+                                        [&reloads]() { reloads++; }));
+  merged_engine_.UpdateSource("first", MakeList("||first.com^\n"));
+  RebuildAndWait();
+  EXPECT_EQ(reloads, 0);
+  EXPECT_EQ(engine_updates_, 1);
+
+  // The text of "first" was dropped once compiled, so changing another list
+  // asks for it again and holds the rebuild until it arrives.
+  merged_engine_.UpdateSource("second", MakeList("||second.com^\n"));
+  merged_engine_.RebuildNowForTest();
+  EXPECT_EQ(reloads, 1);
+  EXPECT_FALSE(merged_engine_.IsUpToDate());
+
+  // Only one reload is requested while it is outstanding.
+  merged_engine_.RebuildNowForTest();
+  EXPECT_EQ(reloads, 1);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(engine_updates_, 1);
+
+  merged_engine_.UpdateSource("first", MakeList("||first.com^\n"));
+  RebuildAndWait();
+  EXPECT_EQ(reloads, 1);
+  EXPECT_TRUE(merged_engine_.IsUpToDate());
+  EXPECT_EQ(MatchedSource("https://first.com/ad.js"), "first");
+  EXPECT_EQ(MatchedSource("https://second.com/ad.js"), "second");
+}
+
+}  // namespace brave_shields
@@ -15,6 +15,7 @@
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/ad_block_component_filters_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_engine.h"
+#include "brave/components/brave_shields/browser/ad_block_merged_engine.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/filter_list_catalog_entry.h"
@@ -43,10 +44,12 @@ AdBlockRegionalServiceManager::AdBlockRegionalServiceManager(
 
 void AdBlockRegionalServiceManager::Init(
     AdBlockResourceProvider* resource_provider,
-    AdBlockFilterListCatalogProvider* catalog_provider) {
+    AdBlockFilterListCatalogProvider* catalog_provider,
+    AdBlockMergedEngine* merged_engine) {
   DCHECK(!initialized_);
   resource_provider_ = resource_provider;
   catalog_provider_ = catalog_provider;
+  merged_engine_ = merged_engine;
   catalog_provider_->LoadFilterListCatalog(
       base::BindOnce(&AdBlockRegionalServiceManager::OnFilterListCatalogLoaded,
                      weak_factory_.GetWeakPtr()));
@@ -124,6 +127,9 @@ void AdBlockRegionalServiceManager::StartRegionalServices() {
             std::make_unique<AdBlockService::SourceProviderObserver>(
                 regional_service->AsWeakPtr(), regional_filters_provider.get(),
                 resource_provider_, task_runner_);
+        if (merged_engine_) {
+          observer->SetMergedEngine(merged_engine_->AsWeakPtr(), uuid);
+        }
         regional_services_.insert({uuid, std::move(regional_service)});
         regional_filters_providers_.insert(
             {uuid, std::move(regional_filters_provider)});
@@ -270,6 +276,9 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
     auto observer = std::make_unique<AdBlockService::SourceProviderObserver>(
         regional_service->AsWeakPtr(), regional_filters_provider.get(),
         resource_provider_, task_runner_);
+    if (merged_engine_) {
+      observer->SetMergedEngine(merged_engine_->AsWeakPtr(), uuid);
+    }
     regional_services_.insert({uuid, std::move(regional_service)});
     regional_filters_providers_.insert(
         {uuid, std::move(regional_filters_provider)});
@@ -281,6 +290,9 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
 
     DCHECK(it != regional_services_.end());
     regional_services_.erase(it);
+    // The engine itself is destroyed later on the adblock task runner, but it
+    // stops being consulted right away.
+    AdBlockEngine::BumpGeneration();
 
     auto it2 = regional_filters_providers_.find(uuid);
     DCHECK(it2 != regional_filters_providers_.end());
@@ -296,26 +308,18 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
                      weak_factory_.GetWeakPtr(), uuid, enabled));
 }
 
-absl::optional<base::Value> AdBlockRegionalServiceManager::UrlCosmeticResources(
-    const std::string& url) {
+cosmetic_filters::mojom::UrlCosmeticResourcesPtr
+AdBlockRegionalServiceManager::UrlCosmeticResources(const std::string& url) {
   base::AutoLock lock(regional_services_lock_);
-  auto it = regional_services_.begin();
-  if (it == regional_services_.end()) {
-    return absl::optional<base::Value>();
-  }
-  absl::optional<base::Value> first_value =
-      it->second->UrlCosmeticResources(url);
-  DCHECK(first_value->is_dict());
+  cosmetic_filters::mojom::UrlCosmeticResourcesPtr first_value;
 
-  for (; it != regional_services_.end(); it++) {
-    absl::optional<base::Value> next_value =
-        it->second->UrlCosmeticResources(url);
-    DCHECK(next_value->is_dict());
+  for (auto& regional_service : regional_services_) {
+    cosmetic_filters::mojom::UrlCosmeticResourcesPtr next_value =
+        regional_service.second->UrlCosmeticResources(url);
 
     if (first_value) {
       if (next_value) {
-        MergeResourcesInto(std::move(next_value->GetDict()),
-                           first_value->GetIfDict(), false);
+        MergeResourcesInto(std::move(next_value), first_value.get(), false);
       }
     } else {
       first_value = std::move(next_value);
@@ -325,20 +329,20 @@ absl::optional<base::Value> AdBlockRegionalServiceManager::UrlCosmeticResources(
   return first_value;
 }
 
-base::Value::List AdBlockRegionalServiceManager::HiddenClassIdSelectors(
+std::vector<std::string> AdBlockRegionalServiceManager::HiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
-  base::Value::List first_value;
+  std::vector<std::string> first_value;
 
   base::AutoLock lock(regional_services_lock_);
   for (auto& regional_service : regional_services_) {
-    base::Value::List next_value =
+    std::vector<std::string> next_value =
         regional_service.second->HiddenClassIdSelectors(classes, ids,
                                                         exceptions);
 
     for (auto& value : next_value) {
-      first_value.Append(std::move(value));
+      first_value.push_back(std::move(value));
     }
   }
 
@@ -32,6 +32,7 @@ using brave_component_updater::BraveComponent;
 
 namespace brave_shields {
 
+class AdBlockMergedEngine;
 class AdBlockRegionalService;
 class FilterListCatalogEntry;
 
@@ -75,14 +76,17 @@ class AdBlockRegionalServiceManager
   bool IsFilterListEnabled(const std::string& uuid) const;
   void EnableFilterList(const std::string& uuid, bool enabled);
 
-  absl::optional<base::Value> UrlCosmeticResources(const std::string& url);
-  base::Value::List HiddenClassIdSelectors(
+  cosmetic_filters::mojom::UrlCosmeticResourcesPtr UrlCosmeticResources(
+      const std::string& url);
+  std::vector<std::string> HiddenClassIdSelectors(
       const std::vector<std::string>& classes,
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
 
+  // `merged_engine` is only set when `kBraveAdblockMergedEngine` is enabled.
   void Init(AdBlockResourceProvider* resource_provider,
-            AdBlockFilterListCatalogProvider* catalog_provider);
+            AdBlockFilterListCatalogProvider* catalog_provider,
+            AdBlockMergedEngine* merged_engine);
 
   // AdBlockFilterListCatalogProvider::Observer
   void OnFilterListCatalogLoaded(const std::string& catalog_json) override;
@@ -112,6 +116,7 @@ class AdBlockRegionalServiceManager
   raw_ptr<component_updater::ComponentUpdateService> component_update_service_;
   raw_ptr<AdBlockResourceProvider> resource_provider_;
   raw_ptr<AdBlockFilterListCatalogProvider> catalog_provider_;
+  raw_ptr<AdBlockMergedEngine> merged_engine_ = nullptr;
 
   base::WeakPtrFactory<AdBlockRegionalServiceManager> weak_factory_{this};
 };
@@ -15,14 +15,19 @@
 #include "base/files/file_path.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/bind_post_task.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/threading/thread_restrictions.h"
 #include "brave/components/brave_shields/browser/ad_block_component_filters_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_provider.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
 #include "brave/components/brave_shields/browser/ad_block_default_resource_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_engine.h"
 #include "brave/components/brave_shields/browser/ad_block_filter_list_catalog_provider.h"
+#include "brave/components/brave_shields/browser/ad_block_merged_engine.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager.h"
@@ -40,6 +45,8 @@
 namespace {
 
 const char kAdBlockComponentName[] = "Brave Ad Block Updater";
+// Merged engine source id for the user's custom filters.
+const char kCustomFiltersSourceId[] = "custom";
 const char kAdBlockComponentId[] = "iodkpdagapdfkphljnddpjlldadblomo";
 const char kAdBlockComponentBase64PublicKey[] =
     "MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEAsD/B/MGdz0gh7WkcFARn"
@@ -77,6 +84,50 @@ AdBlockService::SourceProviderObserver::SourceProviderObserver(
 AdBlockService::SourceProviderObserver::~SourceProviderObserver() {
   filters_provider_->RemoveObserver(this);
   resource_provider_->RemoveObserver(this);
+  // `merged_engine_` is bound to the adblock task runner, so it can't be
+  // checked for validity here.
+  if (!merged_source_id_.empty()) {
+    task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&AdBlockMergedEngine::RemoveSource,
+                                  merged_engine_, merged_source_id_));
+  }
+}
+
+void AdBlockService::SourceProviderObserver::SetMergedEngine(
+    base::WeakPtr<AdBlockMergedEngine> merged_engine,
+    const std::string& source_id) {
+  DCHECK(!source_id.empty());
+  merged_engine_ = merged_engine;
+  merged_source_id_ = source_id;
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          &AdBlockMergedEngine::AddSource, merged_engine_, merged_source_id_,
+          base::BindPostTask(
+              base::SequencedTaskRunnerHandle::Get(),
+              base::BindRepeating(
+                  &SourceProviderObserver::ReloadListForMergedEngine,
+                  weak_factory_.GetWeakPtr()))));
+}
+
+void AdBlockService::SourceProviderObserver::ReloadListForMergedEngine() {
+  filters_provider_->ReloadDATBuffer(base::BindOnce(
+      &SourceProviderObserver::UpdateMergedEngineSource,
+      weak_factory_.GetWeakPtr()));
+}
+
+void AdBlockService::SourceProviderObserver::UpdateMergedEngineSource(
+    bool deserialize,
+    const DATFileDataBuffer& dat_buf) {
+  // Serialized engines can't be merged with other lists.
+  if (deserialize) {
+    return;
+  }
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&AdBlockMergedEngine::UpdateSource, merged_engine_,
+                     merged_source_id_,
+                     base::MakeRefCounted<base::RefCountedBytes>(dat_buf)));
 }
 
 void AdBlockService::SourceProviderObserver::OnDATLoaded(
@@ -92,6 +143,15 @@ void AdBlockService::SourceProviderObserver::OnDATLoaded(
 
 void AdBlockService::SourceProviderObserver::OnResourcesLoaded(
     const std::string& resources_json) {
+  if (!merged_source_id_.empty()) {
+    task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&AdBlockMergedEngine::UpdateResources,
+                                  merged_engine_, resources_json));
+    if (!dat_buf_.empty()) {
+      UpdateMergedEngineSource(deserialize_, dat_buf_);
+    }
+  }
+
   if (dat_buf_.empty()) {
     task_runner_->PostTask(
         FROM_HERE, base::BindOnce(&AdBlockEngine::AddResources, adblock_engine_,
@@ -137,6 +197,59 @@ void AdBlockService::ShouldStartRequest(
     std::string* rewritten_url) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
 
+  // Only fresh checks are cached. Follow-up checks, such as those made for
+  // CNAME-uncloaked requests, carry results in from a previous check.
+  const bool cacheable = did_match_rule && did_match_exception &&
+                         did_match_important && mock_data_url &&
+                         rewritten_url && !*did_match_rule &&
+                         !*did_match_exception && !*did_match_important &&
+                         rewritten_url->empty();
+  if (!cacheable) {
+    ShouldStartRequestUncached(url, resource_type, tab_host,
+                               aggressive_blocking, did_match_rule,
+                               did_match_exception, did_match_important,
+                               mock_data_url, rewritten_url);
+    return;
+  }
+
+  const uint64_t generation = AdBlockEngine::GetGeneration();
+  if (auto decision = decision_cache_->Get(url, resource_type, tab_host,
+                                           aggressive_blocking, generation)) {
+    *did_match_rule = decision->did_match_rule;
+    *did_match_exception = decision->did_match_exception;
+    *did_match_important = decision->did_match_important;
+    if (!decision->mock_data_url.empty()) {
+      *mock_data_url = decision->mock_data_url;
+    }
+    *rewritten_url = decision->rewritten_url;
+    return;
+  }
+
+  ShouldStartRequestUncached(url, resource_type, tab_host, aggressive_blocking,
+                             did_match_rule, did_match_exception,
+                             did_match_important, mock_data_url,
+                             rewritten_url);
+
+  AdBlockDecisionCache::Decision decision;
+  decision.did_match_rule = *did_match_rule;
+  decision.did_match_exception = *did_match_exception;
+  decision.did_match_important = *did_match_important;
+  decision.mock_data_url = *mock_data_url;
+  decision.rewritten_url = *rewritten_url;
+  decision_cache_->Put(url, resource_type, tab_host, aggressive_blocking,
+                       generation, decision);
+}
+
+void AdBlockService::ShouldStartRequestUncached(
+    const GURL& url,
+    blink::mojom::ResourceType resource_type,
+    const std::string& tab_host,
+    bool aggressive_blocking,
+    bool* did_match_rule,
+    bool* did_match_exception,
+    bool* did_match_important,
+    std::string* mock_data_url,
+    std::string* rewritten_url) {
   GURL request_url;
 
   if (aggressive_blocking ||
@@ -156,6 +269,23 @@ void AdBlockService::ShouldStartRequest(
     }
   }
 
+  if (merged_service_ && merged_service_->IsUpToDate()) {
+    // Regional, subscription and custom lists are all compiled into the merged
+    // engine. The default list is kept apart because of its first-party
+    // exemption above. While the merged engine is being recompiled, the
+    // per-list engines below are used instead.
+    std::string matched_source;
+    request_url =
+        rewritten_url && !rewritten_url->empty() ? GURL(*rewritten_url) : url;
+    merged_service_->ShouldStartRequest(
+        request_url, resource_type, tab_host, aggressive_blocking,
+        did_match_rule, did_match_exception, did_match_important, mock_data_url,
+        rewritten_url, &matched_source);
+    DVLOG_IF(2, !matched_source.empty())
+        << "Request to " << url.spec() << " matched list " << matched_source;
+    return;
+  }
+
   request_url =
       rewritten_url && !rewritten_url->empty() ? GURL(*rewritten_url) : url;
   regional_service_manager()->ShouldStartRequest(
@@ -200,88 +330,77 @@ absl::optional<std::string> AdBlockService::GetCspDirectives(
   return csp_directives;
 }
 
-absl::optional<base::Value> AdBlockService::UrlCosmeticResources(
-    const std::string& url) {
+cosmetic_filters::mojom::UrlCosmeticResourcesPtr
+AdBlockService::UrlCosmeticResources(const std::string& url) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  absl::optional<base::Value> resources =
+  const uint64_t engine_generation = AdBlockEngine::GetGeneration();
+  cosmetic_filters::mojom::UrlCosmeticResourcesPtr resources =
       default_service()->UrlCosmeticResources(url);
 
-  if (!resources || !resources->is_dict()) {
+  if (!resources) {
     return resources;
   }
+  resources->engine_generation = engine_generation;
 
-  absl::optional<base::Value> regional_resources =
+  cosmetic_filters::mojom::UrlCosmeticResourcesPtr regional_resources =
       regional_service_manager()->UrlCosmeticResources(url);
 
-  if (regional_resources && regional_resources->is_dict()) {
-    MergeResourcesInto(std::move(regional_resources->GetDict()),
-                       resources->GetIfDict(),
+  if (regional_resources) {
+    MergeResourcesInto(std::move(regional_resources), resources.get(),
                        /*force_hide=*/true);
   }
 
-  absl::optional<base::Value> custom_resources =
+  cosmetic_filters::mojom::UrlCosmeticResourcesPtr custom_resources =
       custom_filters_service()->UrlCosmeticResources(url);
 
-  if (custom_resources && custom_resources->is_dict()) {
-    MergeResourcesInto(std::move(custom_resources->GetDict()),
-                       resources->GetIfDict(),
+  if (custom_resources) {
+    MergeResourcesInto(std::move(custom_resources), resources.get(),
                        /*force_hide=*/true);
   }
 
-  absl::optional<base::Value> subscription_resources =
+  cosmetic_filters::mojom::UrlCosmeticResourcesPtr subscription_resources =
       subscription_service_manager()->UrlCosmeticResources(url);
 
-  if (subscription_resources && subscription_resources->is_dict()) {
-    MergeResourcesInto(std::move(subscription_resources->GetDict()),
-                       resources->GetIfDict(),
+  if (subscription_resources) {
+    MergeResourcesInto(std::move(subscription_resources), resources.get(),
                        /*force_hide=*/true);
   }
 
   return resources;
 }
 
-// The return value here is formatted differently from the rest of the adblock
-// service instances. We need to distinguish between selectors returned from
-// the default engine and those returned by other engines, but still comply
-// with the virtual method signature.
-// This can be improved once interfaces are decoupled in
-// https://github.com/brave/brave-core/pull/10994.
-// For now, this returns a dict with two properties:
-//  - "hide_selectors" - wraps the result from the default engine
-//  - "force_hide_selectors" - wraps appended results from all other engines
-base::Value::Dict AdBlockService::HiddenClassIdSelectors(
+// We need to distinguish between selectors returned from the default engine,
+// which end up in `hide_selectors`, and those returned by all other engines,
+// which are appended to `force_hide_selectors`.
+void AdBlockService::HiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
-    const std::vector<std::string>& exceptions) {
+    const std::vector<std::string>& exceptions,
+    std::vector<std::string>* hide_selectors,
+    std::vector<std::string>* force_hide_selectors) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  base::Value::List hide_selectors =
+  DCHECK(hide_selectors);
+  DCHECK(force_hide_selectors);
+  *hide_selectors =
       default_service()->HiddenClassIdSelectors(classes, ids, exceptions);
 
-  base::Value::List regional_selectors =
-      regional_service_manager()->HiddenClassIdSelectors(classes, ids,
-                                                         exceptions);
+  *force_hide_selectors = regional_service_manager()->HiddenClassIdSelectors(
+      classes, ids, exceptions);
 
-  base::Value::List custom_selectors =
+  std::vector<std::string> custom_selectors =
       custom_filters_service()->HiddenClassIdSelectors(classes, ids,
                                                        exceptions);
-  base::Value::List subscription_selectors =
+  std::vector<std::string> subscription_selectors =
       subscription_service_manager()->HiddenClassIdSelectors(classes, ids,
                                                              exceptions);
 
-  base::Value::List force_hide_selectors = std::move(regional_selectors);
-
   for (auto& custom_selector : custom_selectors) {
-    force_hide_selectors.Append(std::move(custom_selector));
+    force_hide_selectors->push_back(std::move(custom_selector));
   }
 
   for (auto& subscription_selector : subscription_selectors) {
-    force_hide_selectors.Append(std::move(subscription_selector));
+    force_hide_selectors->push_back(std::move(subscription_selector));
   }
-
-  base::Value::Dict result;
-  result.Set("hide_selectors", std::move(hide_selectors));
-  result.Set("force_hide_selectors", std::move(force_hide_selectors));
-  return result;
 }
 
 AdBlockRegionalServiceManager* AdBlockService::regional_service_manager() {
@@ -290,7 +409,8 @@ AdBlockRegionalServiceManager* AdBlockService::regional_service_manager() {
         brave_shields::AdBlockRegionalServiceManagerFactory(
             local_state_, locale_, component_update_service_, GetTaskRunner());
     regional_service_manager_->Init(resource_provider_.get(),
-                                    filter_list_catalog_provider_.get());
+                                    filter_list_catalog_provider_.get(),
+                                    merged_service());
   }
   return regional_service_manager_.get();
 }
@@ -315,10 +435,18 @@ AdBlockEngine* AdBlockService::custom_filters_service() {
     custom_filters_service_observer_ = std::make_unique<SourceProviderObserver>(
         custom_filters_service_->AsWeakPtr(), custom_filters_provider_.get(),
         resource_provider_.get(), GetTaskRunner());
+    if (merged_service()) {
+      custom_filters_service_observer_->SetMergedEngine(
+          merged_service()->AsWeakPtr(), kCustomFiltersSourceId);
+    }
   }
   return custom_filters_service_.get();
 }
 
+AdBlockMergedEngine* AdBlockService::merged_service() {
+  return merged_service_.get();
+}
+
 brave_shields::AdBlockCustomFiltersProvider*
 AdBlockService::custom_filters_provider() {
   return custom_filters_provider_.get();
@@ -327,7 +455,8 @@ AdBlockService::custom_filters_provider() {
 brave_shields::AdBlockSubscriptionServiceManager*
 AdBlockService::subscription_service_manager() {
   if (!subscription_service_manager_->IsInitialized()) {
-    subscription_service_manager_->Init(resource_provider_.get());
+    subscription_service_manager_->Init(resource_provider_.get(),
+                                        merged_service());
   }
   return subscription_service_manager_.get();
 }
@@ -345,10 +474,20 @@ AdBlockService::AdBlockService(
       task_runner_(task_runner),
       custom_filters_service_(nullptr, base::OnTaskRunnerDeleter(task_runner_)),
       default_service_(nullptr, base::OnTaskRunnerDeleter(task_runner_)),
-      subscription_service_manager_(std::move(subscription_service_manager)) {
+      subscription_service_manager_(std::move(subscription_service_manager)),
+      merged_service_(nullptr, base::OnTaskRunnerDeleter(task_runner_)),
+      decision_cache_(new AdBlockDecisionCache(),
+                      base::OnTaskRunnerDeleter(task_runner_)) {
   // Initializes adblock-rust's domain resolution implementation
   adblock::SetDomainResolver(AdBlockServiceDomainResolver);
 
+  if (base::FeatureList::IsEnabled(features::kBraveAdblockMergedEngine)) {
+    merged_service_ =
+        std::unique_ptr<AdBlockMergedEngine, base::OnTaskRunnerDeleter>(
+            new AdBlockMergedEngine(),
+            base::OnTaskRunnerDeleter(task_runner_));
+  }
+
   default_filters_provider_ =
       std::make_unique<brave_shields::AdBlockComponentFiltersProvider>(
           component_update_service_, g_ad_block_component_id_,
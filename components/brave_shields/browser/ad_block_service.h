@@ -19,6 +19,7 @@
 #include "base/values.h"
 #include "brave/components/brave_shields/browser/ad_block_filters_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_resource_provider.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "content/public/browser/browser_thread.h"
@@ -45,7 +46,9 @@ struct FilterListMetadata;
 
 namespace brave_shields {
 
+class AdBlockDecisionCache;
 class AdBlockEngine;
+class AdBlockMergedEngine;
 class AdBlockComponentFiltersProvider;
 class AdBlockDefaultResourceProvider;
 class AdBlockRegionalServiceManager;
@@ -70,6 +73,12 @@ class AdBlockService {
     SourceProviderObserver& operator=(const SourceProviderObserver&) = delete;
     ~SourceProviderObserver() override;
 
+    // Also feeds every list loaded by this observer into `merged_engine` under
+    // `source_id`, which must not be empty. Must be called right after
+    // construction, before the first list finishes loading.
+    void SetMergedEngine(base::WeakPtr<AdBlockMergedEngine> merged_engine,
+                         const std::string& source_id);
+
    private:
     // AdBlockFiltersProvider::Observer
     void OnDATLoaded(bool deserialize,
@@ -81,9 +90,17 @@ class AdBlockService {
     void OnEngineReplaced(
         const absl::optional<adblock::FilterListMetadata> maybe_metadata);
 
+    // Loads the list again for the merged engine alone, after it dropped its
+    // copy of the list.
+    void ReloadListForMergedEngine();
+    void UpdateMergedEngineSource(bool deserialize,
+                                  const DATFileDataBuffer& dat_buf);
+
     bool deserialize_;
     DATFileDataBuffer dat_buf_;
     base::WeakPtr<AdBlockEngine> adblock_engine_;
+    base::WeakPtr<AdBlockMergedEngine> merged_engine_;
+    std::string merged_source_id_;
     raw_ptr<AdBlockFiltersProvider> filters_provider_;    // not owned
     raw_ptr<AdBlockResourceProvider> resource_provider_;  // not owned
     base::RepeatingCallback<void(const adblock::FilterListMetadata&)>
@@ -116,15 +133,19 @@ class AdBlockService {
       const GURL& url,
       blink::mojom::ResourceType resource_type,
       const std::string& tab_host);
-  absl::optional<base::Value> UrlCosmeticResources(const std::string& url);
-  base::Value::Dict HiddenClassIdSelectors(
-      const std::vector<std::string>& classes,
-      const std::vector<std::string>& ids,
-      const std::vector<std::string>& exceptions);
+  cosmetic_filters::mojom::UrlCosmeticResourcesPtr UrlCosmeticResources(
+      const std::string& url);
+  void HiddenClassIdSelectors(const std::vector<std::string>& classes,
+                              const std::vector<std::string>& ids,
+                              const std::vector<std::string>& exceptions,
+                              std::vector<std::string>* hide_selectors,
+                              std::vector<std::string>* force_hide_selectors);
 
   AdBlockRegionalServiceManager* regional_service_manager();
   AdBlockEngine* custom_filters_service();
   AdBlockEngine* default_service();
+  // Only set when the `kBraveAdblockMergedEngine` feature is enabled.
+  AdBlockMergedEngine* merged_service();
   AdBlockSubscriptionServiceManager* subscription_service_manager();
 
   AdBlockCustomFiltersProvider* custom_filters_provider();
@@ -147,6 +168,16 @@ class AdBlockService {
 
   AdBlockResourceProvider* resource_provider();
 
+  void ShouldStartRequestUncached(const GURL& url,
+                                  blink::mojom::ResourceType resource_type,
+                                  const std::string& tab_host,
+                                  bool aggressive_blocking,
+                                  bool* did_match_rule,
+                                  bool* did_match_exception,
+                                  bool* did_match_important,
+                                  std::string* mock_data_url,
+                                  std::string* rewritten_url);
+
   void UseSourceProvidersForTest(AdBlockFiltersProvider* source_provider,
                                  AdBlockResourceProvider* resource_provider);
   void UseCustomSourceProvidersForTest(
@@ -178,6 +209,12 @@ class AdBlockService {
       default_service_;
   std::unique_ptr<brave_shields::AdBlockSubscriptionServiceManager>
       subscription_service_manager_;
+  std::unique_ptr<brave_shields::AdBlockMergedEngine, base::OnTaskRunnerDeleter>
+      merged_service_;
+
+  // Only accessed on `task_runner_`.
+  std::unique_ptr<AdBlockDecisionCache, base::OnTaskRunnerDeleter>
+      decision_cache_;
 
   std::unique_ptr<SourceProviderObserver> default_service_observer_;
   std::unique_ptr<SourceProviderObserver> custom_filters_service_observer_;
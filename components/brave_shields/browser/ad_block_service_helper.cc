@@ -8,7 +8,6 @@
 #include <utility>
 
 #include "base/strings/strcat.h"
-#include "base/values.h"
 
 namespace brave_shields {
 
@@ -35,71 +34,41 @@ void MergeCspDirectiveInto(absl::optional<std::string> from,
   *into = absl::optional<std::string>(from_str + ", " + into_str);
 }
 
-// Merges the contents of the first UrlCosmeticResources Value into the second
-// one provided.
+// Merges the contents of the first UrlCosmeticResources into the second one
+// provided.
 //
 // If `force_hide` is true, the contents of `from`'s `hide_selectors` field
-// will be moved into a possibly new field of `into` called
-// `force_hide_selectors`.
-void MergeResourcesInto(base::Value::Dict from,
-                        base::Value::Dict* into,
+// will be moved into the `force_hide_selectors` field of `into`.
+void MergeResourcesInto(cosmetic_filters::mojom::UrlCosmeticResourcesPtr from,
+                        cosmetic_filters::mojom::UrlCosmeticResources* into,
                         bool force_hide) {
   DCHECK(into);
-  base::Value::List* resources_hide_selectors = nullptr;
-  if (force_hide) {
-    resources_hide_selectors = into->FindList("force_hide_selectors");
-    if (!resources_hide_selectors) {
-      resources_hide_selectors =
-          into->Set("force_hide_selectors", base::Value::List())->GetIfList();
-    }
-  } else {
-    resources_hide_selectors = into->FindList("hide_selectors");
+  DCHECK(from);
+  std::vector<std::string>& resources_hide_selectors =
+      force_hide ? into->force_hide_selectors : into->hide_selectors;
+  for (auto& selector : from->hide_selectors) {
+    resources_hide_selectors.push_back(std::move(selector));
   }
-  base::Value::List* from_resources_hide_selectors =
-      from.FindList("hide_selectors");
-  if (resources_hide_selectors && from_resources_hide_selectors) {
-    for (auto& selector : *from_resources_hide_selectors) {
-      resources_hide_selectors->Append(std::move(selector));
-    }
+  for (auto& selector : from->force_hide_selectors) {
+    into->force_hide_selectors.push_back(std::move(selector));
   }
 
-  base::Value::Dict* resources_style_selectors =
-      into->FindDict("style_selectors");
-  base::Value::Dict* from_resources_style_selectors =
-      from.FindDict("style_selectors");
-  if (resources_style_selectors && from_resources_style_selectors) {
-    for (auto [key, value] : *from_resources_style_selectors) {
-      base::Value::List* resources_entry =
-          resources_style_selectors->FindList(key);
-      if (resources_entry) {
-        DCHECK(value.is_list());
-        for (auto& item : value.GetList()) {
-          resources_entry->Append(std::move(item));
-        }
-      } else {
-        resources_style_selectors->Set(key, std::move(value));
-      }
+  for (auto& [key, value] : from->style_selectors) {
+    std::vector<std::string>& resources_entry = into->style_selectors[key];
+    for (auto& item : value) {
+      resources_entry.push_back(std::move(item));
     }
   }
 
-  base::Value::List* resources_exceptions = into->FindList("exceptions");
-  base::Value::List* from_resources_exceptions = from.FindList("exceptions");
-  if (resources_exceptions && from_resources_exceptions) {
-    for (auto& exception : *from_resources_exceptions) {
-      resources_exceptions->Append(std::move(exception));
-    }
+  for (auto& exception : from->exceptions) {
+    into->exceptions.push_back(std::move(exception));
   }
 
-  auto* resources_injected_script = into->FindString("injected_script");
-  auto* from_resources_injected_script = from.FindString("injected_script");
-  if (resources_injected_script && from_resources_injected_script) {
-    *resources_injected_script = base::StrCat(
-        {*resources_injected_script, "\n", *from_resources_injected_script});
-  }
+  into->injected_script = base::StrCat(
+      {into->injected_script, "\n", from->injected_script});
 
-  auto from_resources_generichide = from.FindBool("generichide");
-  if (from_resources_generichide && *from_resources_generichide) {
-    into->Set("generichide", true);
+  if (from->generichide) {
+    into->generichide = true;
   }
 }
 
@@ -11,7 +11,7 @@
 #include <vector>
 
 #include "base/files/file_path.h"
-#include "base/values.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace brave_shields {
@@ -19,8 +19,8 @@ namespace brave_shields {
 void MergeCspDirectiveInto(absl::optional<std::string> from,
                            absl::optional<std::string>* into);
 
-void MergeResourcesInto(base::Value::Dict from,
-                        base::Value::Dict* into,
+void MergeResourcesInto(cosmetic_filters::mojom::UrlCosmeticResourcesPtr from,
+                        cosmetic_filters::mojom::UrlCosmeticResources* into,
                         bool force_hide);
 
 }  // namespace brave_shields
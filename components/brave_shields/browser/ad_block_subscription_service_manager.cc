@@ -22,6 +22,7 @@
 #include "base/values.h"
 #include "brave/components/adblock_rust_ffi/src/wrapper.h"
 #include "brave/components/brave_shields/browser/ad_block_engine.h"
+#include "brave/components/brave_shields/browser/ad_block_merged_engine.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_filters_provider.h"
 #include "brave/components/brave_shields/browser/ad_block_subscription_service_manager_observer.h"
@@ -127,8 +128,10 @@ AdBlockSubscriptionServiceManager::AdBlockSubscriptionServiceManager(
 }
 
 void AdBlockSubscriptionServiceManager::Init(
-    AdBlockResourceProvider* resource_provider) {
+    AdBlockResourceProvider* resource_provider,
+    AdBlockMergedEngine* merged_engine) {
   resource_provider_ = resource_provider;
+  merged_engine_ = merged_engine;
   initialized_ = true;
 }
 
@@ -245,6 +248,7 @@ void AdBlockSubscriptionServiceManager::CreateSubscription(
       resource_provider_, task_runner_,
       base::BindRepeating(&AdBlockSubscriptionServiceManager::OnListMetadata,
                           weak_ptr_factory_.GetWeakPtr(), sub_url));
+  ObserveForMergedEngine(observer.get(), sub_url, info.enabled);
 
   {
     base::AutoLock lock(subscription_services_lock_);
@@ -291,6 +295,16 @@ void AdBlockSubscriptionServiceManager::EnableSubscription(const GURL& sub_url,
   info->enabled = enabled;
 
   UpdateSubscriptionPrefs(sub_url, *info);
+  // `ShouldStartRequest` skips disabled subscriptions, so decisions cached
+  // before the toggle no longer hold.
+  AdBlockEngine::BumpGeneration();
+
+  if (merged_engine_) {
+    task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&AdBlockMergedEngine::SetSourceEnabled,
+                       merged_engine_->AsWeakPtr(), sub_url.spec(), enabled));
+  }
 }
 
 void AdBlockSubscriptionServiceManager::DeleteSubscription(
@@ -350,6 +364,20 @@ void AdBlockSubscriptionServiceManager::OnGetDownloadManager(
       base::DoNothing());
 }
 
+void AdBlockSubscriptionServiceManager::ObserveForMergedEngine(
+    AdBlockService::SourceProviderObserver* observer,
+    const GURL& sub_url,
+    bool enabled) {
+  if (!merged_engine_)
+    return;
+
+  observer->SetMergedEngine(merged_engine_->AsWeakPtr(), sub_url.spec());
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&AdBlockMergedEngine::SetSourceEnabled,
+                     merged_engine_->AsWeakPtr(), sub_url.spec(), enabled));
+}
+
 void AdBlockSubscriptionServiceManager::OnListMetadata(
     const GURL& sub_url,
     const adblock::FilterListMetadata& metadata) {
@@ -440,6 +468,7 @@ void AdBlockSubscriptionServiceManager::LoadSubscriptionServices() {
           base::BindRepeating(
               &AdBlockSubscriptionServiceManager::OnListMetadata,
               weak_ptr_factory_.GetWeakPtr(), sub_url));
+      ObserveForMergedEngine(observer.get(), sub_url, info.enabled);
 
       subscription_services_.insert(
           std::make_pair(sub_url, std::move(subscription_service)));
@@ -553,21 +582,20 @@ void AdBlockSubscriptionServiceManager::AddResources(
   }
 }
 
-absl::optional<base::Value>
+cosmetic_filters::mojom::UrlCosmeticResourcesPtr
 AdBlockSubscriptionServiceManager::UrlCosmeticResources(
     const std::string& url) {
-  absl::optional<base::Value> first_value = absl::nullopt;
+  cosmetic_filters::mojom::UrlCosmeticResourcesPtr first_value;
 
   base::AutoLock lock(subscription_services_lock_);
   for (auto& subscription_service : subscription_services_) {
     auto info = GetInfo(subscriptions_, subscription_service.first);
     if (info && info->enabled) {
-      absl::optional<base::Value> next_value =
+      cosmetic_filters::mojom::UrlCosmeticResourcesPtr next_value =
           subscription_service.second->UrlCosmeticResources(url);
       if (first_value) {
         if (next_value) {
-          MergeResourcesInto(std::move(next_value->GetDict()),
-                             first_value->GetIfDict(), false);
+          MergeResourcesInto(std::move(next_value), first_value.get(), false);
         }
       } else {
         first_value = std::move(next_value);
@@ -578,22 +606,23 @@ AdBlockSubscriptionServiceManager::UrlCosmeticResources(
   return first_value;
 }
 
-base::Value::List AdBlockSubscriptionServiceManager::HiddenClassIdSelectors(
+std::vector<std::string>
+AdBlockSubscriptionServiceManager::HiddenClassIdSelectors(
     const std::vector<std::string>& classes,
     const std::vector<std::string>& ids,
     const std::vector<std::string>& exceptions) {
-  base::Value::List first_value;
+  std::vector<std::string> first_value;
 
   base::AutoLock lock(subscription_services_lock_);
   for (auto& subscription_service : subscription_services_) {
     auto info = GetInfo(subscriptions_, subscription_service.first);
     if (info && info->enabled) {
-      base::Value::List next_value =
+      std::vector<std::string> next_value =
           subscription_service.second->HiddenClassIdSelectors(classes, ids,
                                                               exceptions);
 
       for (auto& item : next_value) {
-        first_value.Append(std::move(item));
+        first_value.push_back(std::move(item));
       }
     }
   }
@@ -36,6 +36,7 @@ class JSONValueConverter;
 }
 
 namespace brave_shields {
+class AdBlockMergedEngine;
 class AdBlockResourceProvider;
 class AdBlockSubscriptionServiceManagerObserver;
 class AdBlockSubscriptionFiltersProvider;
@@ -108,8 +109,9 @@ class AdBlockSubscriptionServiceManager {
   void EnableTag(const std::string& tag, bool enabled);
   void AddResources(const std::string& resources);
 
-  absl::optional<base::Value> UrlCosmeticResources(const std::string& url);
-  base::Value::List HiddenClassIdSelectors(
+  cosmetic_filters::mojom::UrlCosmeticResourcesPtr UrlCosmeticResources(
+      const std::string& url);
+  std::vector<std::string> HiddenClassIdSelectors(
       const std::vector<std::string>& classes,
       const std::vector<std::string>& ids,
       const std::vector<std::string>& exceptions);
@@ -124,7 +126,9 @@ class AdBlockSubscriptionServiceManager {
   void AddObserver(AdBlockSubscriptionServiceManagerObserver* observer);
   void RemoveObserver(AdBlockSubscriptionServiceManagerObserver* observer);
 
-  void Init(AdBlockResourceProvider* resource_provider);
+  // `merged_engine` is only set when `kBraveAdblockMergedEngine` is enabled.
+  void Init(AdBlockResourceProvider* resource_provider,
+            AdBlockMergedEngine* merged_engine);
   bool IsInitialized();
 
  private:
@@ -146,6 +150,11 @@ class AdBlockSubscriptionServiceManager {
   void OnGetDownloadManager(
       AdBlockSubscriptionDownloadManager* download_manager);
 
+  // Forwards lists loaded by `observer` to the merged engine, if any.
+  void ObserveForMergedEngine(AdBlockService::SourceProviderObserver* observer,
+                              const GURL& sub_url,
+                              bool enabled);
+
   void OnListMetadata(const GURL& sub_url,
                       const adblock::FilterListMetadata& metadata);
 
@@ -161,6 +170,7 @@ class AdBlockSubscriptionServiceManager {
   raw_ptr<PrefService> local_state_ GUARDED_BY_CONTEXT(sequence_checker_);
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   raw_ptr<AdBlockResourceProvider> resource_provider_;
+  raw_ptr<AdBlockMergedEngine> merged_engine_ = nullptr;
   raw_ptr<brave_component_updater::BraveComponent::Delegate>
       delegate_;  // NOT OWNED
   base::WeakPtr<AdBlockSubscriptionDownloadManager> download_manager_;
@@ -0,0 +1,399 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_store.h"
+
+#include <algorithm>
+
+#include "base/big_endian.h"
+#include "base/files/file_path.h"
+#include "base/json/json_reader.h"
+#include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Layout, all integers big endian:
+//   header:   magic, version, target count
+//   index:    (target offset, rulesets offset) per target, sorted by target
+//   targets:  string per target
+//   rulesets: count, then per ruleset the exclusion patterns followed by the
+//             rules; a rule is a kind byte, then `from` and `to` for
+//             kRuleKindReplace
+// A string is its length followed by its bytes, a list of strings is a
+// count followed by the strings.
+constexpr char kMagic[] = {'H', 'T', 'S', 'E'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kHeaderSize = sizeof(kMagic) + 2 * sizeof(uint32_t);
+constexpr size_t kIndexEntrySize = 2 * sizeof(uint32_t);
+
+constexpr uint8_t kRuleKindDefault = 0;
+constexpr uint8_t kRuleKindReplace = 1;
+
+// HTTPS Everywhere uses $1-style back references, RE2 expects \1.
+std::string ToRE2Rewrite(const std::string& to) {
+  std::string corrected(to);
+  std::replace(corrected.begin(), corrected.end(), '$', '\\');
+  return corrected;
+}
+
+void AppendUint32(uint32_t value, std::string* out) {
+  char buffer[sizeof(uint32_t)];
+  base::WriteBigEndian(buffer, value);
+  out->append(buffer, sizeof(buffer));
+}
+
+void AppendString(base::StringPiece value, std::string* out) {
+  AppendUint32(value.size(), out);
+  out->append(value.data(), value.size());
+}
+
+void OverwriteUint32(size_t offset, uint32_t value, std::string* out) {
+  base::WriteBigEndian(&(*out)[offset], value);
+}
+
+// Serializes the rulesets of one target, mirroring how they used to be
+// evaluated straight from the JSON. Returns false if nothing is left.
+bool AppendRulesets(const std::string& json, std::string* out) {
+  absl::optional<base::Value> value = base::JSONReader::Read(json);
+  if (!value || !value->is_list()) {
+    return false;
+  }
+
+  std::string rulesets;
+  uint32_t ruleset_count = 0;
+  for (const auto& ruleset_value : value->GetList()) {
+    const base::Value::Dict* ruleset = ruleset_value.GetIfDict();
+    if (!ruleset) {
+      continue;
+    }
+
+    // A ruleset without rules ends the evaluation with no upgrade, so it and
+    // anything after it can't change the outcome.
+    const base::Value::List* rules = ruleset->FindList("r");
+    if (!rules) {
+      break;
+    }
+
+    std::vector<std::string> exclusions;
+    if (const base::Value::List* exclusion_values = ruleset->FindList("e")) {
+      for (const auto& exclusion_value : *exclusion_values) {
+        const base::Value::Dict* exclusion = exclusion_value.GetIfDict();
+        const std::string* pattern =
+            exclusion ? exclusion->FindString("p") : nullptr;
+        if (pattern) {
+          exclusions.push_back(ToRE2Rewrite(*pattern));
+        }
+      }
+    }
+    AppendUint32(exclusions.size(), &rulesets);
+    for (const auto& exclusion : exclusions) {
+      AppendString(exclusion, &rulesets);
+    }
+
+    const size_t rule_count_offset = rulesets.size();
+    uint32_t rule_count = 0;
+    AppendUint32(0, &rulesets);
+    for (const auto& rule_value : *rules) {
+      const base::Value::Dict* rule = rule_value.GetIfDict();
+      if (!rule) {
+        continue;
+      }
+      if (rule->Find("d")) {
+        rulesets.push_back(kRuleKindDefault);
+        rule_count++;
+        continue;
+      }
+      const std::string* from = rule->FindString("f");
+      const std::string* to = rule->FindString("t");
+      if (!from || !to) {
+        continue;
+      }
+      rulesets.push_back(kRuleKindReplace);
+      AppendString(*from, &rulesets);
+      AppendString(ToRE2Rewrite(*to), &rulesets);
+      rule_count++;
+    }
+    OverwriteUint32(rule_count_offset, rule_count, &rulesets);
+    ruleset_count++;
+  }
+
+  if (ruleset_count == 0) {
+    return false;
+  }
+  AppendUint32(ruleset_count, out);
+  out->append(rulesets);
+  return true;
+}
+
+// Bounds-checked reads straight out of the compiled data.
+class Reader {
+ public:
+  explicit Reader(base::span<const uint8_t> data, size_t offset = 0)
+      : data_(data), offset_(offset) {}
+
+  bool ReadByte(uint8_t* out) {
+    if (offset_ >= data_.size()) {
+      return false;
+    }
+    *out = data_[offset_++];
+    return true;
+  }
+
+  bool ReadUint32(uint32_t* out) {
+    if (offset_ > data_.size() || data_.size() - offset_ < sizeof(uint32_t)) {
+      return false;
+    }
+    base::ReadBigEndian(&data_[offset_], out);
+    offset_ += sizeof(uint32_t);
+    return true;
+  }
+
+  bool ReadString(base::StringPiece* out) {
+    uint32_t length;
+    if (!ReadUint32(&length) || data_.size() - offset_ < length) {
+      return false;
+    }
+    *out = base::StringPiece(reinterpret_cast<const char*>(&data_[offset_]),
+                             length);
+    offset_ += length;
+    return true;
+  }
+
+ private:
+  base::span<const uint8_t> data_;
+  size_t offset_;
+};
+
+}  // namespace
+
+struct HTTPSERuleStore::CompiledRuleset {
+  struct Rule {
+    // Null for a default rule, which just switches the scheme.
+    std::unique_ptr<re2::RE2> from;
+    std::string to;
+  };
+
+  std::vector<std::unique_ptr<re2::RE2>> exclusions;
+  std::vector<Rule> rules;
+};
+
+HTTPSERuleStore::HTTPSERuleStore()
+    : compiled_rulesets_(kCompiledRulesetsCacheSize) {}
+
+HTTPSERuleStore::~HTTPSERuleStore() = default;
+
+// static
+std::string HTTPSERuleStore::Compile(
+    std::vector<std::pair<std::string, std::string>> targets) {
+  std::sort(targets.begin(), targets.end());
+
+  std::string index;
+  std::string body;
+  uint32_t target_count = 0;
+  for (const auto& [target, json] : targets) {
+    std::string rulesets;
+    if (!AppendRulesets(json, &rulesets)) {
+      continue;
+    }
+    // Offsets are fixed up below, once the size of the index is known.
+    AppendUint32(body.size(), &index);
+    AppendString(target, &body);
+    AppendUint32(body.size(), &index);
+    body.append(rulesets);
+    target_count++;
+  }
+
+  std::string data(kMagic, sizeof(kMagic));
+  AppendUint32(kVersion, &data);
+  AppendUint32(target_count, &data);
+  const uint32_t body_offset = kHeaderSize + index.size();
+  data.append(index);
+  for (size_t offset = kHeaderSize; offset < body_offset;
+       offset += sizeof(uint32_t)) {
+    uint32_t value;
+    base::ReadBigEndian(reinterpret_cast<const uint8_t*>(&data[offset]),
+                        &value);
+    OverwriteUint32(offset, value + body_offset, &data);
+  }
+  data.append(body);
+  return data;
+}
+
+bool HTTPSERuleStore::Load(const base::FilePath& path) {
+  Reset();
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  if (!mapped_file->Initialize(path)) {
+    return false;
+  }
+  if (!SetData(base::make_span(mapped_file->data(), mapped_file->length()))) {
+    LOG(ERROR) << "Malformed HTTPSE rules file " << path;
+    return false;
+  }
+  mapped_file_ = std::move(mapped_file);
+  return true;
+}
+
+bool HTTPSERuleStore::LoadFromString(std::string data) {
+  Reset();
+  owned_data_ = std::move(data);
+  if (!SetData(base::as_bytes(base::make_span(owned_data_)))) {
+    owned_data_.clear();
+    return false;
+  }
+  return true;
+}
+
+bool HTTPSERuleStore::SetData(base::span<const uint8_t> data) {
+  if (data.size() < kHeaderSize ||
+      !std::equal(std::begin(kMagic), std::end(kMagic), data.begin())) {
+    return false;
+  }
+  Reader reader(data, sizeof(kMagic));
+  uint32_t version;
+  uint32_t target_count;
+  if (!reader.ReadUint32(&version) || version != kVersion ||
+      !reader.ReadUint32(&target_count) ||
+      (data.size() - kHeaderSize) / kIndexEntrySize < target_count) {
+    return false;
+  }
+  data_ = data;
+  target_count_ = target_count;
+  return true;
+}
+
+void HTTPSERuleStore::Reset() {
+  data_ = base::span<const uint8_t>();
+  target_count_ = 0;
+  compiled_rulesets_.Clear();
+  mapped_file_.reset();
+  owned_data_.clear();
+}
+
+uint32_t HTTPSERuleStore::FindRulesets(base::StringPiece target) const {
+  size_t low = 0;
+  size_t high = target_count_;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2;
+    Reader reader(data_, kHeaderSize + middle * kIndexEntrySize);
+    uint32_t target_offset;
+    uint32_t rulesets_offset;
+    base::StringPiece candidate;
+    if (!reader.ReadUint32(&target_offset) ||
+        !reader.ReadUint32(&rulesets_offset) ||
+        !Reader(data_, target_offset).ReadString(&candidate)) {
+      return 0;
+    }
+    const int comparison = candidate.compare(target);
+    if (comparison == 0) {
+      return rulesets_offset;
+    }
+    if (comparison < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return 0;
+}
+
+const HTTPSERuleStore::CompiledRulesets* HTTPSERuleStore::GetCompiledRulesets(
+    uint32_t offset) {
+  auto it = compiled_rulesets_.Get(offset);
+  if (it != compiled_rulesets_.end()) {
+    return it->second.get();
+  }
+
+  auto rulesets = std::make_unique<CompiledRulesets>();
+  Reader reader(data_, offset);
+  uint32_t ruleset_count;
+  if (!reader.ReadUint32(&ruleset_count)) {
+    return nullptr;
+  }
+  for (uint32_t i = 0; i < ruleset_count; i++) {
+    auto ruleset = std::make_unique<CompiledRuleset>();
+    uint32_t exclusion_count;
+    if (!reader.ReadUint32(&exclusion_count)) {
+      return nullptr;
+    }
+    for (uint32_t j = 0; j < exclusion_count; j++) {
+      base::StringPiece pattern;
+      if (!reader.ReadString(&pattern)) {
+        return nullptr;
+      }
+      ruleset->exclusions.push_back(std::make_unique<re2::RE2>(pattern));
+    }
+
+    uint32_t rule_count;
+    if (!reader.ReadUint32(&rule_count)) {
+      return nullptr;
+    }
+    for (uint32_t j = 0; j < rule_count; j++) {
+      uint8_t kind;
+      if (!reader.ReadByte(&kind)) {
+        return nullptr;
+      }
+      CompiledRuleset::Rule rule;
+      if (kind == kRuleKindReplace) {
+        base::StringPiece from;
+        base::StringPiece to;
+        if (!reader.ReadString(&from) || !reader.ReadString(&to)) {
+          return nullptr;
+        }
+        rule.from = std::make_unique<re2::RE2>(from);
+        rule.to = std::string(to);
+      } else if (kind != kRuleKindDefault) {
+        return nullptr;
+      }
+      ruleset->rules.push_back(std::move(rule));
+    }
+    rulesets->push_back(std::move(ruleset));
+  }
+
+  return compiled_rulesets_.Put(offset, std::move(rulesets))->second.get();
+}
+
+std::string HTTPSERuleStore::ApplyRules(const std::string& target,
+                                        const std::string& url) {
+  if (!is_loaded()) {
+    return "";
+  }
+  const uint32_t offset = FindRulesets(target);
+  if (!offset) {
+    return "";
+  }
+
+  const CompiledRulesets* rulesets = GetCompiledRulesets(offset);
+  UMA_HISTOGRAM_BOOLEAN("Brave.HTTPSE.RulesetsValid", rulesets != nullptr);
+  if (!rulesets) {
+    return "";
+  }
+
+  for (const auto& ruleset : *rulesets) {
+    for (const auto& exclusion : ruleset->exclusions) {
+      if (re2::RE2::FullMatch(url, *exclusion)) {
+        return "";
+      }
+    }
+
+    for (const auto& rule : ruleset->rules) {
+      if (!rule.from) {
+        std::string new_url(url);
+        return new_url.insert(4, "s");
+      }
+      std::string new_url(url);
+      if (re2::RE2::Replace(&new_url, *rule.from, rule.to) && new_url != url) {
+        return new_url;
+      }
+    }
+  }
+  return "";
+}
+
+}  // namespace brave_shields
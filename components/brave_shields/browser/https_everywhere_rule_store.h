@@ -0,0 +1,90 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_STORE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_STORE_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/lru_cache.h"
+#include "base/containers/span.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+class FilePath;
+}
+
+namespace re2 {
+class RE2;
+}
+
+namespace brave_shields {
+
+// Read-only store for the HTTPS Everywhere rulesets.
+//
+// The component ships the rulesets as one JSON blob per lookup target in a
+// leveldb. `Compile` turns them into a flat file, once per component version,
+// holding the sorted targets and every ruleset with its patterns already
+// parsed and rewritten for RE2. `Load` then memory-maps that file, so lookups
+// are a binary search plus reading a few strings in place. The regular
+// expressions of recently used rulesets are kept compiled.
+//
+// Not thread safe; used on the HTTPSE engine's sequence only.
+class HTTPSERuleStore {
+ public:
+  HTTPSERuleStore();
+  HTTPSERuleStore(const HTTPSERuleStore&) = delete;
+  HTTPSERuleStore& operator=(const HTTPSERuleStore&) = delete;
+  ~HTTPSERuleStore();
+
+  // Builds the flat format from (target, JSON rulesets) pairs as stored in
+  // the leveldb. Targets whose JSON can't be parsed are dropped.
+  static std::string Compile(
+      std::vector<std::pair<std::string, std::string>> targets);
+
+  // Maps a file written from `Compile`. Returns false, leaving the store
+  // empty, if it is missing or malformed.
+  bool Load(const base::FilePath& path);
+  // Same as `Load`, for data that was never written to disk.
+  bool LoadFromString(std::string data);
+
+  bool is_loaded() const { return !data_.empty(); }
+
+  // Applies the rulesets for `target` (a lookup key such as "com.example" or
+  // "com.example.*") to `url`. Returns the upgraded URL, or an empty string
+  // if there is no ruleset for `target` or none of its rules apply.
+  std::string ApplyRules(const std::string& target, const std::string& url);
+
+  static constexpr size_t kCompiledRulesetsCacheSize = 256;
+
+ private:
+  struct CompiledRuleset;
+  using CompiledRulesets = std::vector<std::unique_ptr<CompiledRuleset>>;
+
+  bool SetData(base::span<const uint8_t> data);
+  void Reset();
+  // Returns the offset of the rulesets for `target`, or 0 if there is none.
+  uint32_t FindRulesets(base::StringPiece target) const;
+  const CompiledRulesets* GetCompiledRulesets(uint32_t offset);
+
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+  std::string owned_data_;
+  base::span<const uint8_t> data_;
+  uint32_t target_count_ = 0;
+
+  // Keyed by the offset of the rulesets in `data_`.
+  base::HashingLRUCache<uint32_t, std::unique_ptr<CompiledRulesets>>
+      compiled_rulesets_;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_HTTPS_EVERYWHERE_RULE_STORE_H_
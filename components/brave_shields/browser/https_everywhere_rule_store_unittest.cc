@@ -0,0 +1,84 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_store.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+std::string CompileForTest() {
+  return HTTPSERuleStore::Compile({
+      {"com.example", R"([{"r": [{"d": 1}]}])"},
+      {"com.example.*",
+       R"([{"e": [{"p": "^http://login\\.example\\.com/"}],
+            "r": [{"f": "^http://(www\\.)?example\\.com/",
+                   "t": "https://www.example.com/"},
+                  {"f": "^http://(\\w+)\\.example\\.com/",
+                   "t": "https://$1.example.com/"}]}])"},
+      {"org.stopped", R"([{"e": []}, {"r": [{"d": 1}]}])"},
+      {"org.broken", "not json"},
+  });
+}
+
+}  // namespace
+
+TEST(HTTPSERuleStoreTest, DefaultRule) {
+  HTTPSERuleStore store;
+  ASSERT_TRUE(store.LoadFromString(CompileForTest()));
+  EXPECT_EQ(store.ApplyRules("com.example", "http://example.com/a"),
+            "https://example.com/a");
+  EXPECT_EQ(store.ApplyRules("com.other", "http://other.com/"), "");
+}
+
+TEST(HTTPSERuleStoreTest, ReplaceRulesAndExclusions) {
+  HTTPSERuleStore store;
+  ASSERT_TRUE(store.LoadFromString(CompileForTest()));
+  EXPECT_EQ(store.ApplyRules("com.example.*", "http://www.example.com/x"),
+            "https://www.example.com/x");
+  EXPECT_EQ(store.ApplyRules("com.example.*", "http://cdn.example.com/x"),
+            "https://cdn.example.com/x");
+  // Matched by an exclusion.
+  EXPECT_EQ(store.ApplyRules("com.example.*", "http://login.example.com/"),
+            "");
+  // Served from the compiled cache the second time around.
+  EXPECT_EQ(store.ApplyRules("com.example.*", "http://cdn.example.com/y"),
+            "https://cdn.example.com/y");
+}
+
+TEST(HTTPSERuleStoreTest, RulesetWithoutRulesStopsEvaluation) {
+  HTTPSERuleStore store;
+  ASSERT_TRUE(store.LoadFromString(CompileForTest()));
+  EXPECT_EQ(store.ApplyRules("org.stopped", "http://stopped.org/"), "");
+  EXPECT_EQ(store.ApplyRules("org.broken", "http://broken.org/"), "");
+}
+
+TEST(HTTPSERuleStoreTest, LoadFromFile) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath path = temp_dir.GetPath().AppendASCII("httpse.rules");
+
+  HTTPSERuleStore store;
+  EXPECT_FALSE(store.Load(path));
+
+  ASSERT_TRUE(base::WriteFile(path, "garbage"));
+  EXPECT_FALSE(store.Load(path));
+  EXPECT_FALSE(store.is_loaded());
+
+  ASSERT_TRUE(base::WriteFile(path, CompileForTest()));
+  ASSERT_TRUE(store.Load(path));
+  EXPECT_EQ(store.ApplyRules("com.example", "http://example.com/"),
+            "https://example.com/");
+}
+
+}  // namespace brave_shields
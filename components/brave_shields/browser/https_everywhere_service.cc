@@ -13,24 +13,25 @@
 #include "base/base_paths.h"
 #include "base/bind.h"
 #include "base/files/file_util.h"
-#include "base/json/json_reader.h"
+#include "base/files/important_file_writer.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
-#include "base/values.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
-#include "third_party/re2/src/re2/re2.h"
 #include "third_party/zlib/google/zip.h"
 
 #define DAT_FILE "httpse.leveldb.zip"
 #define DAT_FILE_VERSION "6.0"
+#define RULES_FILE "httpse.rules"
 #define HTTPSE_URLS_REDIRECTS_COUNT_QUEUE   1
 #define HTTPSE_URL_MAX_REDIRECTS_COUNT      5
 
 namespace {
 
+constexpr size_t kRecentlyUsedCacheSize = 256;
+
 std::vector<std::string> Split(const std::string& s, char delim) {
   std::stringstream ss(s);
   std::string item;
@@ -66,22 +67,12 @@ std::vector<std::string> ExpandDomainForLookup(const std::string& domain) {
   }
   return resultDomains;
 }
-std::string leveldbGet(leveldb::DB* db, const std::string &key) {
-  if (!db) {
-    return "";
-  }
-
-  std::string value;
-  leveldb::Status s = db->Get(leveldb::ReadOptions(), key, &value);
-  return s.ok() ? value : "";
-}
-
 }  // namespace
 
 namespace brave_shields {
 
 HTTPSEverywhereService::Engine::Engine(HTTPSEverywhereService* service)
-    : level_db_(nullptr), service_(service) {
+    : service_(service) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
 
@@ -89,6 +80,32 @@ void HTTPSEverywhereService::Engine::Init(const base::FilePath& base_dir) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   base::FilePath zip_db_file_path =
       base_dir.AppendASCII(DAT_FILE_VERSION).AppendASCII(DAT_FILE);
+  base::FilePath rules_file_path =
+      zip_db_file_path.DirName().AppendASCII(RULES_FILE);
+
+  // The rules only need compiling once per component version, which gets its
+  // own install directory.
+  if (rule_store_.Load(rules_file_path)) {
+    return;
+  }
+
+  SCOPED_UMA_HISTOGRAM_TIMER("Brave.HTTPSE.CompileRules");
+  std::string rules = CompileRules(zip_db_file_path);
+  if (rules.empty()) {
+    return;
+  }
+  if (!base::ImportantFileWriter::WriteFileAtomically(rules_file_path,
+                                                      rules) ||
+      !rule_store_.Load(rules_file_path)) {
+    LOG(ERROR) << "Failed to write HTTPSE rules file "
+               << rules_file_path.value().c_str();
+    rule_store_.LoadFromString(std::move(rules));
+  }
+}
+
+std::string HTTPSEverywhereService::Engine::CompileRules(
+    const base::FilePath& zip_db_file_path) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   base::FilePath unzipped_level_db_path = zip_db_file_path.RemoveExtension();
   base::FilePath destination = zip_db_file_path.DirName();
   // Unzip doesn't allow overwriting existing files, so delete previously
@@ -97,29 +114,41 @@ void HTTPSEverywhereService::Engine::Init(const base::FilePath& base_dir) {
   if (!deleted) {
     LOG(ERROR) << "Failed to delete unzipped database directory "
                << unzipped_level_db_path.value().c_str();
-    return;
+    return std::string();
   }
 
   if (!zip::Unzip(zip_db_file_path, destination)) {
     LOG(ERROR) << "Failed to unzip database file "
                << zip_db_file_path.value().c_str();
-    return;
+    return std::string();
   }
 
-  CloseDatabase();
-
+  leveldb::DB* level_db = nullptr;
   leveldb::Options options;
   leveldb::Status status =
       leveldb::DB::Open(options,
                         unzipped_level_db_path.AsUTF8Unsafe(),
-                        &level_db_);
-  if (!status.ok() || !level_db_) {
+                        &level_db);
+  if (!status.ok() || !level_db) {
     LOG(ERROR) << "Level db open error "
                << unzipped_level_db_path.value().c_str()
                << ", error: " << status.ToString();
-    CloseDatabase();
-    return;
+    delete level_db;
+    return std::string();
   }
+
+  std::vector<std::pair<std::string, std::string>> targets;
+  std::unique_ptr<leveldb::Iterator> it(
+      level_db->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    targets.emplace_back(it->key().ToString(), it->value().ToString());
+  }
+  it.reset();
+  delete level_db;
+
+  // Everything needed is in the compiled rules from now on.
+  base::DeletePathRecursively(unzipped_level_db_path);
+  return HTTPSERuleStore::Compile(std::move(targets));
 }
 
 bool HTTPSEverywhereService::Engine::GetHTTPSURL(
@@ -131,7 +160,7 @@ bool HTTPSEverywhereService::Engine::GetHTTPSURL(
   if (!url->is_valid())
     return false;
 
-  if (!level_db_ || url->scheme() == url::kHttpsScheme) {
+  if (!rule_store_.is_loaded() || url->scheme() == url::kHttpsScheme) {
     return false;
   }
 
@@ -139,7 +168,8 @@ bool HTTPSEverywhereService::Engine::GetHTTPSURL(
     return false;
   }
 
-  if (service_->recently_used_cache().get(url->spec(), new_url)) {
+  if (auto cached_url = service_->recently_used_cache().Get(url->spec())) {
+    *new_url = std::move(*cached_url);
     service_->AddHTTPSEUrlToRedirectList(request_identifier);
     return true;
   }
@@ -154,130 +184,24 @@ bool HTTPSEverywhereService::Engine::GetHTTPSURL(
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.HTTPSE.GetHTTPSURL");
   const std::vector<std::string> domains =
       ExpandDomainForLookup(candidate_url.host());
-  for (auto domain : domains) {
-    std::string value = leveldbGet(level_db_, domain);
-    if (!value.empty()) {
-      *new_url = ApplyHTTPSRule(candidate_url.spec(), value);
-      if (0 != new_url->length()) {
-        service_->recently_used_cache().add(candidate_url.spec(), *new_url);
-        service_->AddHTTPSEUrlToRedirectList(request_identifier);
-        return true;
-      }
+  for (const auto& domain : domains) {
+    *new_url = rule_store_.ApplyRules(domain, candidate_url.spec());
+    if (!new_url->empty()) {
+      service_->recently_used_cache().Put(candidate_url.spec(), *new_url);
+      service_->AddHTTPSEUrlToRedirectList(request_identifier);
+      return true;
     }
   }
-  service_->recently_used_cache().remove(candidate_url.spec());
+  service_->recently_used_cache().Erase(candidate_url.spec());
   return false;
 }
 
-std::string HTTPSEverywhereService::Engine::ApplyHTTPSRule(
-    const std::string& originalUrl,
-    const std::string& rule) {
-  absl::optional<base::Value> json_object = base::JSONReader::Read(rule);
-  if (absl::nullopt == json_object || !json_object->is_list()) {
-    return "";
-  }
-
-  const base::Value::List& topValues = json_object->GetList();
-  for (const auto& topValue : topValues) {
-    if (!topValue.is_dict()) {
-      continue;
-    }
-    const base::Value::Dict* childTopDictionary = topValue.GetIfDict();
-    if (nullptr == childTopDictionary) {
-      continue;
-    }
-
-    const base::Value* exclusion = childTopDictionary->Find("e");
-    if (nullptr != exclusion) {
-      const base::Value::List* eValues = exclusion->GetIfList();
-      if (nullptr != eValues) {
-        for (const auto& eValue : *eValues) {
-          const base::Value::Dict* pDictionary = eValue.GetIfDict();
-          if (nullptr == pDictionary) {
-            continue;
-          }
-          const base::Value* patternValue = pDictionary->Find("p");
-          if (!patternValue) {
-            continue;
-          }
-          if (!patternValue->is_string()) {
-            continue;
-          }
-          std::string pattern =
-              CorrecttoRuleToRE2Engine(patternValue->GetString());
-          if (RE2::FullMatch(originalUrl, pattern)) {
-            return "";
-          }
-        }
-      }
-    }
-
-    const base::Value* rules = childTopDictionary->Find("r");
-    if (!rules) {
-      return "";
-    }
-    const base::Value::List* rValues = rules->GetIfList();
-    if (nullptr == rValues) {
-      return "";
-    }
-
-    for (const auto& rValue : *rValues) {
-      const base::Value::Dict* pDictionary = rValue.GetIfDict();
-      if (nullptr == pDictionary) {
-        continue;
-      }
-      const base::Value* patternValue = pDictionary->Find("d");
-      if (patternValue) {
-        std::string newUrl(originalUrl);
-        return newUrl.insert(4, "s");
-      }
-
-      const base::Value* from_value = pDictionary->Find("f");
-      const base::Value* to_value = pDictionary->Find("t");
-      if (!from_value || !to_value) {
-        continue;
-      }
-      if (!from_value->is_string() || !to_value->is_string()) {
-        continue;
-      }
-
-      std::string to = CorrecttoRuleToRE2Engine(to_value->GetString());
-      std::string newUrl(originalUrl);
-      RE2 regExp(from_value->GetString());
-
-      if (RE2::Replace(&newUrl, regExp, to) && newUrl != originalUrl) {
-        return newUrl;
-      }
-    }
-  }
-  return "";
-}
-
-std::string HTTPSEverywhereService::Engine::CorrecttoRuleToRE2Engine(
-    const std::string& to) {
-  std::string correctedto(to);
-  size_t pos = to.find("$");
-  while (std::string::npos != pos) {
-    correctedto[pos] = '\\';
-    pos = correctedto.find("$");
-  }
-
-  return correctedto;
-}
-
-void HTTPSEverywhereService::Engine::CloseDatabase() {
-  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (level_db_) {
-    delete level_db_;
-    level_db_ = nullptr;
-  }
-}
-
 bool HTTPSEverywhereService::g_ignore_port_for_test_(false);
 
 HTTPSEverywhereService::HTTPSEverywhereService(
     scoped_refptr<base::SequencedTaskRunner> task_runner)
     : BaseBraveShieldsService(task_runner),
+      recently_used_cache_(kRecentlyUsedCacheSize),
       engine_(new Engine(this), base::OnTaskRunnerDeleter(task_runner)) {}
 
 HTTPSEverywhereService::~HTTPSEverywhereService() {
@@ -310,14 +234,15 @@ bool HTTPSEverywhereService::GetHTTPSURLFromCacheOnly(
     return false;
   }
 
-  if (recently_used_cache_.get(url->spec(), cached_url)) {
+  if (auto cached = recently_used_cache_.Get(url->spec())) {
+    *cached_url = std::move(*cached);
     AddHTTPSEUrlToRedirectList(request_identifier);
     return true;
   }
   return false;
 }
 
-HTTPSERecentlyUsedCache<std::string>&
+brave::ShardedLRUCache<std::string, std::string>&
 HTTPSEverywhereService::recently_used_cache() {
   return recently_used_cache_;
 }
@@ -14,12 +14,9 @@
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
+#include "brave/base/containers/sharded_lru_cache.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
-#include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
-
-namespace leveldb {
-class DB;
-}
+#include "brave/components/brave_shields/browser/https_everywhere_rule_store.h"
 
 class HTTPSEverywhereServiceTest;
 
@@ -63,12 +60,12 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
                      std::string* new_url);
 
    private:
-    std::string ApplyHTTPSRule(const std::string& originalUrl,
-                               const std::string& rule);
-    std::string CorrecttoRuleToRE2Engine(const std::string& to);
-    void CloseDatabase();
+    // Unpacks the leveldb shipped with the component and compiles its rules
+    // into the format read by `HTTPSERuleStore`. Returns an empty string on
+    // failure.
+    std::string CompileRules(const base::FilePath& zip_db_file_path);
 
-    leveldb::DB* level_db_;
+    HTTPSERuleStore rule_store_;
     HTTPSEverywhereService* service_;  // not owned
     SEQUENCE_CHECKER(sequence_checker_);
   };
@@ -92,11 +89,13 @@ class HTTPSEverywhereService : public BaseBraveShieldsService {
 
   void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
   bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  HTTPSERecentlyUsedCache<std::string>& recently_used_cache();
+  brave::ShardedLRUCache<std::string, std::string>& recently_used_cache();
 
   base::Lock httpse_get_urls_redirects_count_mutex_;
   std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
-  HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
+  // Upgraded URLs by original URL, shared by the engine sequence and
+  // `GetHTTPSURLFromCacheOnly`.
+  brave::ShardedLRUCache<std::string, std::string> recently_used_cache_;
   std::unique_ptr<Engine, base::OnTaskRunnerDeleter> engine_;
 
   SEQUENCE_CHECKER(sequence_checker_);
@@ -47,6 +47,12 @@ BASE_FEATURE(kBraveAdblockCosmeticFilteringChildFrames,
 BASE_FEATURE(kBraveAdblockCspRules,
              "BraveAdblockCspRules",
              base::FEATURE_ENABLED_BY_DEFAULT);
+// When enabled, network requests are matched against a single engine compiled
+// from all enabled regional, subscription and custom filter lists instead of
+// querying one engine per list.
+BASE_FEATURE(kBraveAdblockMergedEngine,
+             "BraveAdblockMergedEngine",
+             base::FEATURE_DISABLED_BY_DEFAULT);
 // When enabled, Brave will block domains listed in the user's selected adblock
 // filters and present a security interstitial with choice to proceed and
 // optionally whitelist the domain.
@@ -75,9 +81,10 @@ BASE_FEATURE(kBraveReduceLanguage,
 BASE_FEATURE(kBraveDarkModeBlock,
              "BraveDarkModeBlock",
              base::FEATURE_ENABLED_BY_DEFAULT);
-// load the cosmetic filter rules using sync ipc
-BASE_FEATURE(kCosmeticFilteringSyncLoad,
-             "CosmeticFilterSyncLoad",
+// compute the cosmetic filter rules for a frame when its navigation starts
+// and push them to the renderer before the document commits
+BASE_FEATURE(kCosmeticFilteringPrefetch,
+             "CosmeticFilterPrefetch",
              base::FEATURE_ENABLED_BY_DEFAULT);
 
 // Enables extra TRACE_EVENTs in content filter js. The feature is
@@ -21,12 +21,13 @@ BASE_DECLARE_FEATURE(kBraveAdblockCookieListOptIn);
 BASE_DECLARE_FEATURE(kBraveAdblockCosmeticFiltering);
 BASE_DECLARE_FEATURE(kBraveAdblockCosmeticFilteringChildFrames);
 BASE_DECLARE_FEATURE(kBraveAdblockCspRules);
+BASE_DECLARE_FEATURE(kBraveAdblockMergedEngine);
 BASE_DECLARE_FEATURE(kBraveDomainBlock);
 BASE_DECLARE_FEATURE(kBraveDomainBlock1PES);
 BASE_DECLARE_FEATURE(kBraveExtensionNetworkBlocking);
 BASE_DECLARE_FEATURE(kBraveReduceLanguage);
 BASE_DECLARE_FEATURE(kBraveDarkModeBlock);
-BASE_DECLARE_FEATURE(kCosmeticFilteringSyncLoad);
+BASE_DECLARE_FEATURE(kCosmeticFilteringPrefetch);
 BASE_DECLARE_FEATURE(kCosmeticFilteringExtraPerfMetrics);
 BASE_DECLARE_FEATURE(kCosmeticFilteringJsPerformance);
 extern const base::FeatureParam<std::string>
@@ -7,6 +7,8 @@
 
 #include <utility>
 
+#include "base/barrier_callback.h"
+#include "base/feature_list.h"
 #include "base/strings/strcat.h"
 #include "brave/components/brave_wallet/browser/blockchain_registry.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_service.h"
@@ -16,6 +18,7 @@
 #include "brave/components/brave_wallet/browser/keyring_service.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
 #include "brave/components/brave_wallet/common/eth_address.h"
+#include "brave/components/brave_wallet/common/features.h"
 #include "brave/components/brave_wallet/common/hex_utils.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
@@ -170,6 +173,13 @@ void AssetDiscoveryManager::OnGetAllTokensDiscoverAssets(
     return;
   }
 
+  if (base::FeatureList::IsEnabled(
+          features::kBraveWalletAssetDiscoveryBalanceScanFeature)) {
+    ScanTokenBalances(std::move(tokens_to_search), triggered_by_accounts_added,
+                      chain_id, account_addresses);
+    return;
+  }
+
   auto callback = base::BindOnce(&AssetDiscoveryManager::OnGetTransferLogs,
                                  weak_ptr_factory_.GetWeakPtr(),
                                  base::OwnedRef(std::move(tokens_to_search)),
@@ -248,6 +258,89 @@ void AssetDiscoveryManager::OnGetTransferLogs(
                          triggered_by_accounts_added);
 }
 
+void AssetDiscoveryManager::ScanTokenBalances(
+    base::flat_map<std::string, mojom::BlockchainTokenPtr> tokens_to_search,
+    bool triggered_by_accounts_added,
+    const std::string& chain_id,
+    const std::vector<std::string>& account_addresses) {
+  std::vector<std::string> contract_addresses;
+  contract_addresses.reserve(tokens_to_search.size());
+  for (const auto& [contract_address, _] : tokens_to_search) {
+    contract_addresses.push_back(contract_address);
+  }
+
+  auto barrier_callback = base::BarrierCallback<TokenBalances>(
+      account_addresses.size(),
+      base::BindOnce(&AssetDiscoveryManager::OnScanTokenBalances,
+                     weak_ptr_factory_.GetWeakPtr(),
+                     base::OwnedRef(std::move(tokens_to_search)),
+                     triggered_by_accounts_added, chain_id));
+  for (const auto& account_address : account_addresses) {
+    auto callback = base::BindOnce(
+        [](base::RepeatingCallback<void(TokenBalances)> barrier_callback,
+           const std::vector<absl::optional<std::string>>& balances,
+           mojom::ProviderError error, const std::string& error_message) {
+          if (error != mojom::ProviderError::kSuccess) {
+            barrier_callback.Run(absl::nullopt);
+            return;
+          }
+          barrier_callback.Run(balances);
+        },
+        barrier_callback);
+    json_rpc_service_->GetERC20TokenBalances(
+        contract_addresses, account_address, chain_id, std::move(callback));
+  }
+}
+
+void AssetDiscoveryManager::OnScanTokenBalances(
+    base::flat_map<std::string, mojom::BlockchainTokenPtr>& tokens_to_search,
+    bool triggered_by_accounts_added,
+    const std::string& chain_id,
+    std::vector<TokenBalances> balances_per_account) {
+  // Balances are ordered as |tokens_to_search|.
+  std::vector<bool> has_balance(tokens_to_search.size(), false);
+  bool has_result = false;
+  for (const auto& balances : balances_per_account) {
+    if (!balances || balances->size() != tokens_to_search.size()) {
+      continue;
+    }
+
+    has_result = true;
+    for (size_t i = 0; i < balances->size(); ++i) {
+      uint256_t balance = 0;
+      if (balances->at(i) && HexValueToUint256(*balances->at(i), &balance) &&
+          balance > 0) {
+        has_balance[i] = true;
+      }
+    }
+  }
+
+  if (!has_result) {
+    CompleteDiscoverAssets(chain_id, std::vector<mojom::BlockchainTokenPtr>(),
+                           mojom::ProviderError::kInternalError,
+                           l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR),
+                           triggered_by_accounts_added);
+    return;
+  }
+
+  std::vector<mojom::BlockchainTokenPtr> discovered_assets;
+  size_t i = 0;
+  for (auto& [contract_address, token] : tokens_to_search) {
+    if (!has_balance[i++]) {
+      continue;
+    }
+
+    if (!BraveWalletService::AddUserAsset(token.Clone(), prefs_)) {
+      continue;
+    }
+    discovered_assets.push_back(std::move(token));
+  }
+
+  CompleteDiscoverAssets(chain_id, std::move(discovered_assets),
+                         mojom::ProviderError::kSuccess, "",
+                         triggered_by_accounts_added);
+}
+
 void AssetDiscoveryManager::CompleteDiscoverAssets(
     const std::string& chain_id,
     std::vector<mojom::BlockchainTokenPtr> discovered_assets_for_chain,
@@ -16,6 +16,7 @@
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
 #include "mojo/public/cpp/bindings/receiver.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 class PrefService;
 
@@ -110,6 +111,26 @@ class AssetDiscoveryManager : public mojom::KeyringServiceObserver {
       mojom::ProviderError error,
       const std::string& error_message);
 
+  // Balances of tokens to search for an account, absl::nullopt if they could
+  // not be obtained.
+  using TokenBalances =
+      absl::optional<std::vector<absl::optional<std::string>>>;
+
+  // Used instead of eth_getLogs when
+  // kBraveWalletAssetDiscoveryBalanceScanFeature is enabled. Discovers tokens
+  // with a balance in any of the accounts, in aggregated balanceOf calls.
+  void ScanTokenBalances(
+      base::flat_map<std::string, mojom::BlockchainTokenPtr> tokens_to_search,
+      bool triggered_by_accounts_added,
+      const std::string& chain_id,
+      const std::vector<std::string>& account_addresses);
+
+  void OnScanTokenBalances(
+      base::flat_map<std::string, mojom::BlockchainTokenPtr>& tokens_to_search,
+      bool triggered_by_accounts_added,
+      const std::string& chain_id,
+      std::vector<TokenBalances> balances_per_account);
+
   void CompleteDiscoverAssets(
       const std::string& chain_id,
       std::vector<mojom::BlockchainTokenPtr> discovered_assets,
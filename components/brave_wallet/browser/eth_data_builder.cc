@@ -87,6 +87,11 @@ bool BalanceOf(const std::string& address, std::string* data) {
   return brave_wallet::ConcatHexStrings(function_hash, params, data);
 }
 
+std::vector<uint8_t> BalanceOf(const EthAddress& address) {
+  return eth_abi::TupleEncoder().AddAddress(address).EncodeWithSelector(
+      kBalanceOfSelector);
+}
+
 bool Approve(const std::string& spender_address,
              uint256_t amount,
              std::string* data) {
@@ -395,6 +400,26 @@ std::vector<uint8_t> GetWalletAddr(const std::string& domain,
 
 }  // namespace unstoppable_domains
 
+namespace multicall3 {
+
+std::vector<uint8_t> Call3(const EthAddress& target,
+                           const std::vector<uint8_t>& call_data) {
+  // (address target, bool allowFailure, bytes callData)
+  return eth_abi::TupleEncoder()
+      .AddAddress(target)
+      .AddUint256(1)
+      .AddBytes(call_data)
+      .Encode();
+}
+
+std::vector<uint8_t> Aggregate3(
+    const std::vector<std::vector<uint8_t>>& calls) {
+  return eth_abi::TupleEncoder().AddTupleArray(calls).EncodeWithSelector(
+      kAggregate3Selector);
+}
+
+}  // namespace multicall3
+
 namespace ens {
 
 std::string Resolver(const std::string& domain) {
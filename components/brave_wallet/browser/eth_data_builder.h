@@ -18,12 +18,16 @@ namespace brave_wallet {
 
 namespace erc20 {
 
+// balanceOf(address)
+constexpr uint8_t kBalanceOfSelector[] = {0x70, 0xa0, 0x82, 0x31};
+
 // Allows transferring ERC20 tokens
 bool Transfer(const std::string& to_address,
               uint256_t amount,
               std::string* data);
 // Returns the balance of an address
 bool BalanceOf(const std::string& address, std::string* data);
+std::vector<uint8_t> BalanceOf(const EthAddress& address);
 // Approves the use of funds to an address
 bool Approve(const std::string& spender_address,
              uint256_t amount,
@@ -101,6 +105,26 @@ std::vector<uint8_t> GetWalletAddr(const std::string& domain,
 
 }  // namespace unstoppable_domains
 
+namespace multicall3 {
+
+// Multicall3 is deployed at the same address on most EVM chains.
+// https://github.com/mds1/multicall
+constexpr char kMulticall3Address[] =
+    "0xcA11bde05977b3631167028862bE2a173976CA11";
+
+// aggregate3((address,bool,bytes)[])
+constexpr uint8_t kAggregate3Selector[] = {0x82, 0xad, 0x56, 0xcb};
+
+// Encodes a Call3 struct for |Aggregate3|. A failed call is reported in the
+// results instead of reverting all calls.
+std::vector<uint8_t> Call3(const EthAddress& target,
+                           const std::vector<uint8_t>& call_data);
+
+// Aggregates calls encoded with |Call3| in a single call.
+std::vector<uint8_t> Aggregate3(const std::vector<std::vector<uint8_t>>& calls);
+
+}  // namespace multicall3
+
 namespace ens {
 
 std::string Resolver(const std::string& domain);
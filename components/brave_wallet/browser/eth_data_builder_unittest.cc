@@ -8,6 +8,7 @@
 #include "base/ranges/algorithm.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/eth_abi_utils.h"
+#include "brave/components/brave_wallet/common/eth_address.h"
 #include "brave/components/brave_wallet/common/hash_utils.h"
 #include "brave/components/brave_wallet/common/hex_utils.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -45,6 +46,11 @@ TEST(EthCallDataBuilderTest, BalanceOf) {
   ASSERT_EQ(data,
             "0x70a08231000000000000000000000000000000004e02f254184E904300e0775E"
             "4b8eeCB1");
+
+  EXPECT_EQ(ToHex(BalanceOf(EthAddress::FromHex(
+                "0xBFb30a082f650C2A15D0632f0e87bE4F8e64460f"))),
+            "0x70a08231000000000000000000000000bfb30a082f650c2a15d0632f0e87be4f"
+            "8e64460f");
 }
 
 TEST(EthCallDataBuilderTest, Approve) {
@@ -431,6 +437,36 @@ TEST(EthCallDataBuilderTest, MakeFilLookupKeyList) {
 
 }  // namespace unstoppable_domains
 
+namespace multicall3 {
+
+TEST(EthCallDataBuilderTest, Aggregate3) {
+  auto call = Call3(
+      EthAddress::FromHex("0x6B175474E89094C44Da98b954EedeAC495271d0F"),
+      erc20::BalanceOf(EthAddress::FromHex(
+          "0xBFb30a082f650C2A15D0632f0e87bE4F8e64460f")));
+  EXPECT_EQ(ToHex(Aggregate3({call})),
+            "0x82ad56cb"
+            "0000000000000000000000000000000000000000000000000000000000000020"
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000000000000000000000000000000000000000000020"
+            // target
+            "0000000000000000000000006b175474e89094c44da98b954eedeac495271d0f"
+            // allowFailure
+            "0000000000000000000000000000000000000000000000000000000000000001"
+            // callData
+            "0000000000000000000000000000000000000000000000000000000000000060"
+            "0000000000000000000000000000000000000000000000000000000000000024"
+            "70a08231000000000000000000000000bfb30a082f650c2a15d0632f0e87be4f"
+            "8e64460f00000000000000000000000000000000000000000000000000000000");
+
+  EXPECT_EQ(ToHex(Aggregate3({})),
+            "0x82ad56cb"
+            "0000000000000000000000000000000000000000000000000000000000000020"
+            "0000000000000000000000000000000000000000000000000000000000000000");
+}
+
+}  // namespace multicall3
+
 namespace ens {
 
 TEST(EthCallDataBuilderTest, Resolver) {
@@ -9,6 +9,7 @@
 #include <string>
 #include <utility>
 
+#include "base/files/file_path.h"
 #include "base/test/bind.h"
 #include "base/test/task_environment.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
@@ -19,6 +20,7 @@
 #include "brave/components/brave_wallet/browser/eth_tx_state_manager.h"
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 #include "brave/components/brave_wallet/browser/tx_meta.h"
+#include "brave/components/brave_wallet/browser/tx_store.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
 #include "brave/components/brave_wallet/common/eth_address.h"
@@ -102,7 +104,9 @@ TEST_F(EthNonceTrackerUnitTest, GetNonce) {
       base::BindLambdaForTesting([&](bool success) { run_loop.Quit(); }));
   run_loop.Run();
 
-  EthTxStateManager tx_state_manager(GetPrefs(), &service);
+  TxStore tx_store(GetPrefs(), base::FilePath());
+  EthTxStateManager tx_state_manager(GetPrefs(), &tx_store, &service);
+  task_environment_.RunUntilIdle();
   EthNonceTracker nonce_tracker(&tx_state_manager, &service);
 
   SetTransactionCount(2);
@@ -147,7 +151,9 @@ TEST_F(EthNonceTrackerUnitTest, NonceLock) {
       brave_wallet::mojom::kLocalhostChainId, mojom::CoinType::ETH,
       base::BindLambdaForTesting([&](bool success) { run_loop.Quit(); }));
   run_loop.Run();
-  EthTxStateManager tx_state_manager(GetPrefs(), &service);
+  TxStore tx_store(GetPrefs(), base::FilePath());
+  EthTxStateManager tx_state_manager(GetPrefs(), &tx_store, &service);
+  task_environment_.RunUntilIdle();
   EthNonceTracker nonce_tracker(&tx_state_manager, &service);
 
   SetTransactionCount(4);
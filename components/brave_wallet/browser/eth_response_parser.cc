@@ -11,6 +11,7 @@
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/eth_abi_decoder.h"
 #include "brave/components/brave_wallet/browser/json_rpc_response_parser.h"
+#include "brave/components/brave_wallet/common/eth_abi_utils.h"
 #include "brave/components/brave_wallet/common/eth_address.h"
 #include "brave/components/brave_wallet/common/hex_utils.h"
 #include "net/base/data_url.h"
@@ -286,6 +287,34 @@ absl::optional<std::string> ParseUnstoppableDomainsProxyReaderGet(
   return value;
 }
 
+absl::optional<std::vector<absl::optional<std::vector<uint8_t>>>>
+ParseMulticall3Aggregate3Result(const std::string& json) {
+  auto bytes_result = ParseDecodedBytesResult(json);
+  if (!bytes_result)
+    return absl::nullopt;
+
+  auto tuples = eth_abi::ExtractTupleArrayFromTuple(*bytes_result, 0);
+  if (!tuples)
+    return absl::nullopt;
+
+  std::vector<absl::optional<std::vector<uint8_t>>> return_data;
+  return_data.reserve(tuples->size());
+  for (const auto& tuple : *tuples) {
+    auto success = eth_abi::ExtractUint256FromTuple(tuple, 0);
+    auto data = eth_abi::ExtractBytesFromTuple(tuple, 1);
+    if (!success || !data)
+      return absl::nullopt;
+
+    if (*success == 0) {
+      return_data.push_back(absl::nullopt);
+    } else {
+      return_data.push_back(std::move(*data));
+    }
+  }
+
+  return return_data;
+}
+
 bool ParseTokenUri(const std::string& json, GURL* url) {
   std::string result;
   if (!ParseStringResult(json, &result)) {
@@ -47,6 +47,11 @@ ParseUnstoppableDomainsProxyReaderGetMany(const std::string& json);
 absl::optional<std::string> ParseUnstoppableDomainsProxyReaderGet(
     const std::string& json);
 
+// Parses the (bool success, bytes returnData)[] result of Multicall3
+// aggregate3. Return data of failed calls is absl::nullopt.
+absl::optional<std::vector<absl::optional<std::vector<uint8_t>>>>
+ParseMulticall3Aggregate3Result(const std::string& json);
+
 // Get the JSON included in a data URI with a mime type application/json
 bool ParseDataURIAndExtractJSON(const GURL url, std::string* json);
 
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "brave/components/brave_wallet/browser/eth_response_parser.h"
+#include "brave/components/brave_wallet/common/hex_utils.h"
 #include "brave/components/ipfs/ipfs_utils.h"
 #include "components/grit/brave_components_strings.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -341,6 +342,50 @@ TEST(EthResponseParserUnitTest, ParseUnstoppableDomainsProxyReaderGetMany) {
   ASSERT_FALSE(values);
 }
 
+TEST(EthResponseParserUnitTest, ParseMulticall3Aggregate3Result) {
+  std::string json =
+      "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":"
+      // offset for array
+      "\"0x0000000000000000000000000000000000000000000000000000000000000020"
+      // count for array
+      "0000000000000000000000000000000000000000000000000000000000000002"
+      // offsets for array elements
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "00000000000000000000000000000000000000000000000000000000000000c0"
+      // success
+      "0000000000000000000000000000000000000000000000000000000000000001"
+      // offset for returnData
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      // count for returnData
+      "0000000000000000000000000000000000000000000000000000000000000020"
+      // returnData
+      "0000000000000000000000000000000000000000000000000de0b6b3a7640000"
+      // failure
+      "0000000000000000000000000000000000000000000000000000000000000000"
+      // offset for returnData
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      // count for empty returnData
+      "0000000000000000000000000000000000000000000000000000000000000000\"}";
+
+  auto results = ParseMulticall3Aggregate3Result(json);
+  ASSERT_TRUE(results);
+  ASSERT_EQ(2u, results->size());
+  ASSERT_TRUE(results->at(0));
+  EXPECT_EQ(
+      ToHex(*results->at(0)),
+      "0x0000000000000000000000000000000000000000000000000de0b6b3a7640000");
+  EXPECT_FALSE(results->at(1));
+
+  json =
+      "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":"
+      "\"0x000000000000000000000000000000000000000000000000000000000000002000";
+  EXPECT_FALSE(ParseMulticall3Aggregate3Result(json));
+
+  // No contract at the Multicall3 address.
+  json = "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"0x\"}";
+  EXPECT_FALSE(ParseMulticall3Aggregate3Result(json));
+}
+
 TEST(EthResponseParserUnitTest, ParseUnstoppableDomainsProxyReaderGet) {
   std::string json =
       "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":"
@@ -29,13 +29,15 @@ class EthTxMeta;
 class TxService;
 class JsonRpcService;
 class KeyringService;
+class TxStore;
 
 class EthTxManager : public TxManager, public EthBlockTracker::Observer {
  public:
   EthTxManager(TxService* tx_service,
                JsonRpcService* json_rpc_service,
                KeyringService* keyring_service,
-               PrefService* prefs);
+               PrefService* prefs,
+               TxStore* tx_store);
   ~EthTxManager() override;
   EthTxManager(const EthTxManager&) = delete;
   EthTxManager operator=(const EthTxManager&) = delete;
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/callback_helpers.h"
+#include "base/files/file_path.h"
 #include "base/json/json_reader.h"
 #include "base/test/bind.h"
 #include "base/test/scoped_feature_list.h"
@@ -254,8 +255,9 @@ class EthTxManagerUnitTest : public testing::Test {
         std::make_unique<JsonRpcService>(shared_url_loader_factory_, &prefs_);
     keyring_service_ =
         std::make_unique<KeyringService>(json_rpc_service_.get(), &prefs_);
-    tx_service_ = std::make_unique<TxService>(json_rpc_service_.get(),
-                                              keyring_service_.get(), &prefs_);
+    tx_service_ = std::make_unique<TxService>(
+        json_rpc_service_.get(), keyring_service_.get(), &prefs_,
+        base::FilePath());
 
     base::RunLoop run_loop;
     json_rpc_service_->SetNetwork(brave_wallet::mojom::kLocalhostChainId,
@@ -2199,13 +2201,13 @@ TEST_F(EthTxManagerUnitTest, Reset) {
   auto tx = EthTransaction::FromTxData(tx_data, false);
   meta.set_tx(std::make_unique<EthTransaction>(*tx));
   eth_tx_manager()->tx_state_manager_->AddOrUpdateTx(meta);
-  EXPECT_TRUE(GetPrefs()->HasPrefPath(kBraveWalletTransactions));
+  EXPECT_TRUE(eth_tx_manager()->tx_state_manager_->GetTx("001"));
 
   tx_service_->Reset();
 
   EXPECT_FALSE(eth_tx_manager()->known_no_pending_tx_);
   EXPECT_FALSE(eth_tx_manager()->block_tracker_->IsRunning());
-  EXPECT_FALSE(GetPrefs()->HasPrefPath(kBraveWalletTransactions));
+  EXPECT_FALSE(eth_tx_manager()->tx_state_manager_->GetTx("001"));
 }
 
 }  //  namespace brave_wallet
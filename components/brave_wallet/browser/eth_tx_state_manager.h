@@ -28,11 +28,13 @@ namespace brave_wallet {
 class TxMeta;
 class EthTxMeta;
 class JsonRpcService;
+class TxStore;
 
 class EthTxStateManager : public TxStateManager {
  public:
-  explicit EthTxStateManager(PrefService* prefs,
-                             JsonRpcService* json_rpc_service);
+  EthTxStateManager(PrefService* prefs,
+                    TxStore* tx_store,
+                    JsonRpcService* json_rpc_service);
   ~EthTxStateManager() override;
   EthTxStateManager(const EthTxStateManager&) = delete;
   EthTxStateManager operator=(const EthTxStateManager&) = delete;
@@ -19,6 +19,7 @@
 #include "brave/components/brave_wallet/browser/eip2930_transaction.h"
 #include "brave/components/brave_wallet/browser/eth_tx_meta.h"
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
+#include "brave/components/brave_wallet/browser/tx_store.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/eth_address.h"
 #include "components/prefs/pref_service.h"
@@ -44,8 +45,10 @@ class EthTxStateManagerUnitTest : public testing::Test {
     brave_wallet::RegisterProfilePrefs(prefs_.registry());
     json_rpc_service_ = std::make_unique<JsonRpcService>(
         shared_url_loader_factory_, GetPrefs());
+    tx_store_ = std::make_unique<TxStore>(GetPrefs(), base::FilePath());
     eth_tx_state_manager_ = std::make_unique<EthTxStateManager>(
-        GetPrefs(), json_rpc_service_.get());
+        GetPrefs(), tx_store_.get(), json_rpc_service_.get());
+    task_environment_.RunUntilIdle();
   }
 
   void SetNetwork(const std::string& chain_id) {
@@ -65,6 +68,7 @@ class EthTxStateManagerUnitTest : public testing::Test {
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
   sync_preferences::TestingPrefServiceSyncable prefs_;
   std::unique_ptr<JsonRpcService> json_rpc_service_;
+  std::unique_ptr<TxStore> tx_store_;
   std::unique_ptr<EthTxStateManager> eth_tx_state_manager_;
 };
 
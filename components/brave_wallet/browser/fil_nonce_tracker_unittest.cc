@@ -7,6 +7,7 @@
 
 #include <utility>
 
+#include "base/files/file_path.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/test/bind.h"
 #include "base/test/task_environment.h"
@@ -15,6 +16,7 @@
 #include "brave/components/brave_wallet/browser/fil_tx_meta.h"
 #include "brave/components/brave_wallet/browser/fil_tx_state_manager.h"
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
+#include "brave/components/brave_wallet/browser/tx_store.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "components/sync_preferences/testing_pref_service_syncable.h"
 #include "services/data_decoder/public/cpp/test_support/in_process_data_decoder.h"
@@ -90,7 +92,9 @@ TEST_F(FilNonceTrackerUnitTest, GetNonce) {
       base::BindLambdaForTesting([&](bool success) { run_loop.Quit(); }));
   run_loop.Run();
 
-  FilTxStateManager tx_state_manager(GetPrefs(), &service);
+  TxStore tx_store(GetPrefs(), base::FilePath());
+  FilTxStateManager tx_state_manager(GetPrefs(), &tx_store, &service);
+  task_environment_.RunUntilIdle();
   FilNonceTracker nonce_tracker(&tx_state_manager, &service);
 
   SetTransactionCount(2);
@@ -134,7 +138,9 @@ TEST_F(FilNonceTrackerUnitTest, NonceLock) {
       mojom::kLocalhostChainId, mojom::CoinType::FIL,
       base::BindLambdaForTesting([&](bool success) { run_loop.Quit(); }));
   run_loop.Run();
-  FilTxStateManager tx_state_manager(GetPrefs(), &service);
+  TxStore tx_store(GetPrefs(), base::FilePath());
+  FilTxStateManager tx_state_manager(GetPrefs(), &tx_store, &service);
+  task_environment_.RunUntilIdle();
   FilNonceTracker nonce_tracker(&tx_state_manager, &service);
 
   SetTransactionCount(4);
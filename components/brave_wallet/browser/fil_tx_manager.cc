@@ -29,8 +29,11 @@ namespace brave_wallet {
 FilTxManager::FilTxManager(TxService* tx_service,
                            JsonRpcService* json_rpc_service,
                            KeyringService* keyring_service,
-                           PrefService* prefs)
-    : TxManager(std::make_unique<FilTxStateManager>(prefs, json_rpc_service),
+                           PrefService* prefs,
+                           TxStore* tx_store)
+    : TxManager(std::make_unique<FilTxStateManager>(prefs,
+                                                    tx_store,
+                                                    json_rpc_service),
                 std::make_unique<FilBlockTracker>(json_rpc_service),
                 tx_service,
                 json_rpc_service,
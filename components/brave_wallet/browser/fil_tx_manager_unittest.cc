@@ -9,6 +9,7 @@
 
 #include <utility>
 
+#include "base/files/file_path.h"
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/test/bind.h"
@@ -79,8 +80,9 @@ class FilTxManagerUnitTest : public testing::Test {
         std::make_unique<JsonRpcService>(shared_url_loader_factory_, &prefs_);
     keyring_service_ =
         std::make_unique<KeyringService>(json_rpc_service_.get(), &prefs_);
-    tx_service_ = std::make_unique<TxService>(json_rpc_service_.get(),
-                                              keyring_service_.get(), &prefs_);
+    tx_service_ = std::make_unique<TxService>(
+        json_rpc_service_.get(), keyring_service_.get(), &prefs_,
+        base::FilePath());
 
     base::RunLoop run_loop;
     json_rpc_service_->SetNetwork(brave_wallet::mojom::kLocalhostChainId,
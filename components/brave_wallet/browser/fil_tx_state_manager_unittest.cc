@@ -15,6 +15,7 @@
 #include "brave/components/brave_wallet/browser/fil_transaction.h"
 #include "brave/components/brave_wallet/browser/fil_tx_meta.h"
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
+#include "brave/components/brave_wallet/browser/tx_store.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "components/sync_preferences/testing_pref_service_syncable.h"
 #include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
@@ -37,8 +38,10 @@ class FilTxStateManagerUnitTest : public testing::Test {
     brave_wallet::RegisterProfilePrefs(prefs_.registry());
     json_rpc_service_ = std::make_unique<JsonRpcService>(
         shared_url_loader_factory_, GetPrefs());
+    tx_store_ = std::make_unique<TxStore>(GetPrefs(), base::FilePath());
     fil_tx_state_manager_ = std::make_unique<FilTxStateManager>(
-        GetPrefs(), json_rpc_service_.get());
+        GetPrefs(), tx_store_.get(), json_rpc_service_.get());
+    task_environment_.RunUntilIdle();
   }
 
   void SetNetwork(const std::string& chain_id) {
@@ -52,6 +55,7 @@ class FilTxStateManagerUnitTest : public testing::Test {
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
   sync_preferences::TestingPrefServiceSyncable prefs_;
   std::unique_ptr<JsonRpcService> json_rpc_service_;
+  std::unique_ptr<TxStore> tx_store_;
   std::unique_ptr<FilTxStateManager> fil_tx_state_manager_;
 };
 
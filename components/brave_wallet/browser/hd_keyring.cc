@@ -56,6 +56,8 @@ size_t HDKeyring::GetAccountsNumber() const {
 
 void HDKeyring::RemoveAccount() {
   accounts_.pop_back();
+  if (account_addresses_.size() > accounts_.size())
+    account_addresses_.resize(accounts_.size());
 }
 
 bool HDKeyring::AddImportedAddress(const std::string& address,
@@ -97,7 +99,11 @@ bool HDKeyring::RemoveImportedAccount(const std::string& address) {
 std::string HDKeyring::GetAddress(size_t index) const {
   if (accounts_.empty() || index >= accounts_.size())
     return std::string();
-  return GetAddressInternal(accounts_[index].get());
+  while (account_addresses_.size() <= index) {
+    account_addresses_.push_back(
+        GetAddressInternal(accounts_[account_addresses_.size()].get()));
+  }
+  return account_addresses_[index];
 }
 
 std::string HDKeyring::GetDiscoveryAddress(size_t index) const {
@@ -67,6 +67,9 @@ class HDKeyring {
   std::unique_ptr<HDKeyBase> root_;
   std::unique_ptr<HDKeyBase> master_key_;
   std::vector<std::unique_ptr<HDKeyBase>> accounts_;
+  // Addresses of |accounts_| computed so far, as account lookups by address
+  // would otherwise hash the public key of every account.
+  mutable std::vector<std::string> account_addresses_;
   // (address, key)
   base::flat_map<std::string, std::unique_ptr<HDKeyBase>> imported_accounts_;
 
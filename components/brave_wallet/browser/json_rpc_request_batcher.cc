@@ -0,0 +1,232 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/json_rpc_request_batcher.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/check.h"
+#include "base/containers/contains.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "brave/components/brave_wallet/browser/json_rpc_requests_helper.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_status_code.h"
+
+namespace brave_wallet {
+
+namespace {
+
+// Whether |api_request_result| for a batch means that the endpoint does not
+// support batches, rather than that the requests themselves failed.
+bool IsBatchRejected(const JsonRpcRequestBatcher::APIRequestResult&
+                         api_request_result,
+                     const base::Value* response) {
+  if (api_request_result.Is2XXResponseCode()) {
+    return !response || !response->is_list();
+  }
+
+  const int response_code = api_request_result.response_code();
+  return response_code >= 400 && response_code < 500 &&
+         response_code != net::HTTP_TOO_MANY_REQUESTS;
+}
+
+}  // namespace
+
+JsonRpcRequestBatcher::JsonRpcRequestBatcher(
+    APIRequestHelper* api_request_helper)
+    : api_request_helper_(api_request_helper) {
+  DCHECK(api_request_helper_);
+}
+
+JsonRpcRequestBatcher::~JsonRpcRequestBatcher() = default;
+
+void JsonRpcRequestBatcher::Request(const GURL& network_url,
+                                    const std::string& json_payload,
+                                    RequestCallback callback) {
+  DCHECK(network_url.is_valid());
+
+  auto& callbacks = pending_callbacks_[RequestKey(network_url, json_payload)];
+  callbacks.push_back(std::move(callback));
+  if (callbacks.size() > 1) {
+    // An identical request is already queued or in flight.
+    return;
+  }
+
+  if (base::Contains(batch_unsupported_network_urls_, network_url)) {
+    SendRequest(network_url, json_payload);
+    return;
+  }
+
+  queued_json_payloads_[network_url].push_back(json_payload);
+  ScheduleFlush();
+}
+
+void JsonRpcRequestBatcher::ScheduleFlush() {
+  if (is_flush_scheduled_) {
+    return;
+  }
+
+  is_flush_scheduled_ = true;
+  base::SequencedTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(&JsonRpcRequestBatcher::Flush,
+                                weak_ptr_factory_.GetWeakPtr()));
+}
+
+void JsonRpcRequestBatcher::Flush() {
+  is_flush_scheduled_ = false;
+
+  auto queued_json_payloads = std::move(queued_json_payloads_);
+  queued_json_payloads_.clear();
+
+  for (auto& [network_url, json_payloads] : queued_json_payloads) {
+    for (size_t i = 0; i < json_payloads.size(); i += kMaxBatchSize) {
+      const auto begin = json_payloads.begin() + i;
+      const auto end =
+          json_payloads.begin() + std::min(i + kMaxBatchSize,
+                                           json_payloads.size());
+      if (end - begin == 1) {
+        // A batch of one is sent as is.
+        SendRequest(network_url, *begin);
+        continue;
+      }
+
+      SendBatch(network_url, std::vector<std::string>(begin, end));
+    }
+  }
+}
+
+void JsonRpcRequestBatcher::SendRequest(const GURL& network_url,
+                                        const std::string& json_payload) {
+  api_request_helper_->Request(
+      "POST", network_url, json_payload, "application/json", true,
+      base::BindOnce(&JsonRpcRequestBatcher::OnRequestResponse,
+                     weak_ptr_factory_.GetWeakPtr(), network_url,
+                     json_payload),
+      MakeCommonJsonRpcHeaders(json_payload));
+}
+
+void JsonRpcRequestBatcher::SendBatch(const GURL& network_url,
+                                      std::vector<std::string> json_payloads) {
+  // Each request in the batch gets its index as id, so the responses can be
+  // matched up again whatever ids the requests were built with.
+  base::Value::List batch;
+  std::vector<std::string> batched_json_payloads;
+  std::vector<base::Value> ids;
+  for (auto& json_payload : json_payloads) {
+    auto request = base::JSONReader::Read(json_payload);
+    if (!request || !request->is_dict()) {
+      SendRequest(network_url, json_payload);
+      continue;
+    }
+
+    ids.push_back(request->GetDict().Extract("id").value_or(base::Value()));
+    request->GetDict().Set("id", static_cast<int>(batch.size()));
+    batch.Append(std::move(*request));
+    batched_json_payloads.push_back(std::move(json_payload));
+  }
+
+  if (batched_json_payloads.empty()) {
+    return;
+  }
+
+  if (batched_json_payloads.size() == 1) {
+    SendRequest(network_url, batched_json_payloads.front());
+    return;
+  }
+
+  std::string batch_json_payload;
+  base::JSONWriter::Write(batch, &batch_json_payload);
+
+  api_request_helper_->Request(
+      "POST", network_url, batch_json_payload, "application/json", true,
+      base::BindOnce(&JsonRpcRequestBatcher::OnBatchResponse,
+                     weak_ptr_factory_.GetWeakPtr(), network_url,
+                     std::move(batched_json_payloads), std::move(ids)),
+      MakeCommonJsonRpcHeaders(batch_json_payload));
+}
+
+void JsonRpcRequestBatcher::OnRequestResponse(
+    const GURL& network_url,
+    const std::string& json_payload,
+    APIRequestResult api_request_result) {
+  RunCallbacks(network_url, json_payload, api_request_result);
+}
+
+void JsonRpcRequestBatcher::OnBatchResponse(
+    const GURL& network_url,
+    std::vector<std::string> json_payloads,
+    std::vector<base::Value> ids,
+    APIRequestResult api_request_result) {
+  DCHECK_EQ(json_payloads.size(), ids.size());
+
+  auto response = base::JSONReader::Read(api_request_result.body());
+  if (IsBatchRejected(api_request_result, response ? &*response : nullptr)) {
+    batch_unsupported_network_urls_.insert(network_url);
+    for (const auto& json_payload : json_payloads) {
+      SendRequest(network_url, json_payload);
+    }
+    return;
+  }
+
+  if (!api_request_result.Is2XXResponseCode()) {
+    // The requests would have failed the same way if sent on their own.
+    for (const auto& json_payload : json_payloads) {
+      RunCallbacks(network_url, json_payload, api_request_result);
+    }
+    return;
+  }
+
+  std::vector<bool> has_response(json_payloads.size(), false);
+  for (auto& entry : response->GetList()) {
+    if (!entry.is_dict()) {
+      continue;
+    }
+
+    const absl::optional<int> index = entry.GetDict().FindInt("id");
+    if (!index || *index < 0 ||
+        static_cast<size_t>(*index) >= json_payloads.size() ||
+        has_response[*index]) {
+      continue;
+    }
+
+    has_response[*index] = true;
+    entry.GetDict().Set("id", ids[*index].Clone());
+    std::string body;
+    base::JSONWriter::Write(entry, &body);
+    RunCallbacks(network_url, json_payloads[*index],
+                 APIRequestResult(api_request_result.response_code(),
+                                  std::move(body), api_request_result.headers(),
+                                  api_request_result.error_code(),
+                                  api_request_result.final_url()));
+  }
+
+  // Requests left without a response in the batch are retried on their own.
+  for (size_t i = 0; i < json_payloads.size(); ++i) {
+    if (!has_response[i]) {
+      SendRequest(network_url, json_payloads[i]);
+    }
+  }
+}
+
+void JsonRpcRequestBatcher::RunCallbacks(
+    const GURL& network_url,
+    const std::string& json_payload,
+    const APIRequestResult& api_request_result) {
+  auto iter = pending_callbacks_.find(RequestKey(network_url, json_payload));
+  if (iter == pending_callbacks_.end()) {
+    return;
+  }
+
+  auto callbacks = std::move(iter->second);
+  pending_callbacks_.erase(iter);
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(api_request_result);
+  }
+}
+
+}  // namespace brave_wallet
@@ -0,0 +1,86 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_REQUEST_BATCHER_H_
+#define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_REQUEST_BATCHER_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/values.h"
+#include "brave/components/api_request_helper/api_request_helper.h"
+#include "url/gurl.h"
+
+namespace brave_wallet {
+
+// Coalesces read-only JSON-RPC requests into JSON-RPC 2.0 batches.
+//
+// Requests made to the same network during the current task are queued and
+// sent together once the task completes, in batches of at most
+// |kMaxBatchSize| requests. The response array is split by id and each entry
+// is handed to its original callback as if it had been requested on its own.
+// A request identical to one that is already queued or in flight is not sent
+// again and shares its response instead.
+//
+// Networks that reject batches are remembered, their requests are resent one
+// by one and later requests to them are no longer batched.
+class JsonRpcRequestBatcher {
+ public:
+  using APIRequestHelper = api_request_helper::APIRequestHelper;
+  using APIRequestResult = api_request_helper::APIRequestResult;
+  using RequestCallback = base::OnceCallback<void(APIRequestResult)>;
+
+  static constexpr size_t kMaxBatchSize = 20;
+
+  explicit JsonRpcRequestBatcher(APIRequestHelper* api_request_helper);
+  ~JsonRpcRequestBatcher();
+  JsonRpcRequestBatcher(const JsonRpcRequestBatcher&) = delete;
+  JsonRpcRequestBatcher& operator=(const JsonRpcRequestBatcher&) = delete;
+
+  void Request(const GURL& network_url,
+               const std::string& json_payload,
+               RequestCallback callback);
+
+ private:
+  using RequestKey = std::pair<GURL, std::string>;
+
+  void ScheduleFlush();
+  void Flush();
+  void SendRequest(const GURL& network_url, const std::string& json_payload);
+  void SendBatch(const GURL& network_url,
+                 std::vector<std::string> json_payloads);
+  void OnRequestResponse(const GURL& network_url,
+                         const std::string& json_payload,
+                         APIRequestResult api_request_result);
+  void OnBatchResponse(const GURL& network_url,
+                       std::vector<std::string> json_payloads,
+                       std::vector<base::Value> ids,
+                       APIRequestResult api_request_result);
+  void RunCallbacks(const GURL& network_url,
+                    const std::string& json_payload,
+                    const APIRequestResult& api_request_result);
+
+  raw_ptr<APIRequestHelper> api_request_helper_ = nullptr;
+
+  // Payloads waiting for the next flush, in request order.
+  base::flat_map<GURL, std::vector<std::string>> queued_json_payloads_;
+  // Callbacks of queued and in flight requests.
+  std::map<RequestKey, std::vector<RequestCallback>> pending_callbacks_;
+  base::flat_set<GURL> batch_unsupported_network_urls_;
+  bool is_flush_scheduled_ = false;
+
+  base::WeakPtrFactory<JsonRpcRequestBatcher> weak_ptr_factory_{this};
+};
+
+}  // namespace brave_wallet
+
+#endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_REQUEST_BATCHER_H_
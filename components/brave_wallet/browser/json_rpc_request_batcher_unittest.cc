@@ -0,0 +1,203 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/json_rpc_request_batcher.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/json/json_writer.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/test/values_test_util.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/data_decoder/public/cpp/test_support/in_process_data_decoder.h"
+#include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_wallet {
+
+namespace {
+
+constexpr char kNetworkUrl[] = "https://rpc.example.com/";
+
+std::string MakeRequest(const std::string& address) {
+  return base::StringPrintf(
+      R"({"id":1,"jsonrpc":"2.0","method":"eth_getBalance",)"
+      R"("params":["%s","latest"]})",
+      address.c_str());
+}
+
+base::Value MakeResponse(const std::string& address) {
+  return base::test::ParseJson(base::StringPrintf(
+      R"({"id":1,"jsonrpc":"2.0","result":"%s"})", address.c_str()));
+}
+
+// Responds to a request with its first param as result.
+base::Value RespondTo(const base::Value& request) {
+  base::Value::Dict response;
+  response.Set("jsonrpc", "2.0");
+  response.Set("id", request.GetDict().Find("id")->Clone());
+  response.Set("result",
+               request.GetDict().FindList("params")->front().Clone());
+  return base::Value(std::move(response));
+}
+
+}  // namespace
+
+class JsonRpcRequestBatcherUnitTest : public testing::Test {
+ public:
+  JsonRpcRequestBatcherUnitTest()
+      : shared_url_loader_factory_(
+            base::MakeRefCounted<network::WeakWrapperSharedURLLoaderFactory>(
+                &url_loader_factory_)),
+        api_request_helper_(TRAFFIC_ANNOTATION_FOR_TESTS,
+                            shared_url_loader_factory_),
+        batcher_(&api_request_helper_) {
+    url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+        [&](const network::ResourceRequest& request) {
+          const std::string request_body(request.request_body->elements()
+                                             ->at(0)
+                                             .As<network::DataElementBytes>()
+                                             .AsStringPiece());
+          request_bodies_.push_back(request_body);
+
+          const base::Value json_request = base::test::ParseJson(request_body);
+          base::Value json_response;
+          if (json_request.is_list() && reject_batches_) {
+            json_response = base::test::ParseJson(
+                R"({"jsonrpc":"2.0","id":null,"error":)"
+                R"({"code":-32600,"message":"Batches not supported"}})");
+          } else if (json_request.is_list()) {
+            // Respond in reverse order, as responses may come in any order.
+            const base::Value::List& requests = json_request.GetList();
+            base::Value::List responses;
+            for (size_t i = requests.size(); i > 0; --i) {
+              responses.Append(RespondTo(requests[i - 1]));
+            }
+            json_response = base::Value(std::move(responses));
+          } else {
+            json_response = RespondTo(json_request);
+          }
+
+          std::string response_body;
+          base::JSONWriter::Write(json_response, &response_body);
+          url_loader_factory_.ClearResponses();
+          url_loader_factory_.AddResponse(request.url.spec(), response_body);
+        }));
+  }
+
+  void Request(const std::string& address) {
+    batcher_.Request(
+        GURL(kNetworkUrl), MakeRequest(address),
+        base::BindLambdaForTesting(
+            [&](JsonRpcRequestBatcher::APIRequestResult api_request_result) {
+              EXPECT_TRUE(api_request_result.Is2XXResponseCode());
+              responses_.push_back(
+                  base::test::ParseJson(api_request_result.body()));
+            }));
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  data_decoder::test::InProcessDataDecoder in_process_data_decoder_;
+  network::TestURLLoaderFactory url_loader_factory_;
+  scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
+  api_request_helper::APIRequestHelper api_request_helper_;
+  JsonRpcRequestBatcher batcher_;
+
+  bool reject_batches_ = false;
+  std::vector<std::string> request_bodies_;
+  std::vector<base::Value> responses_;
+};
+
+TEST_F(JsonRpcRequestBatcherUnitTest, SendSingleRequestAsIs) {
+  Request("0x1");
+  task_environment_.RunUntilIdle();
+
+  ASSERT_EQ(1u, request_bodies_.size());
+  EXPECT_EQ(MakeRequest("0x1"), request_bodies_[0]);
+  ASSERT_EQ(1u, responses_.size());
+  EXPECT_EQ(MakeResponse("0x1"), responses_[0]);
+}
+
+TEST_F(JsonRpcRequestBatcherUnitTest, BatchRequests) {
+  Request("0x1");
+  Request("0x2");
+  Request("0x3");
+  task_environment_.RunUntilIdle();
+
+  ASSERT_EQ(1u, request_bodies_.size());
+  const base::Value batch = base::test::ParseJson(request_bodies_[0]);
+  ASSERT_TRUE(batch.is_list());
+  EXPECT_EQ(3u, batch.GetList().size());
+
+  // Each callback gets its own response with its original id.
+  ASSERT_EQ(3u, responses_.size());
+  EXPECT_EQ(MakeResponse("0x3"), responses_[0]);
+  EXPECT_EQ(MakeResponse("0x2"), responses_[1]);
+  EXPECT_EQ(MakeResponse("0x1"), responses_[2]);
+}
+
+TEST_F(JsonRpcRequestBatcherUnitTest, LimitBatchSize) {
+  const size_t request_count = JsonRpcRequestBatcher::kMaxBatchSize + 1;
+  for (size_t i = 0; i < request_count; ++i) {
+    Request(base::StringPrintf("0x%zx", i));
+  }
+  task_environment_.RunUntilIdle();
+
+  ASSERT_EQ(2u, request_bodies_.size());
+  EXPECT_EQ(JsonRpcRequestBatcher::kMaxBatchSize,
+            base::test::ParseJson(request_bodies_[0]).GetList().size());
+  EXPECT_EQ(MakeRequest(base::StringPrintf("0x%zx", request_count - 1)),
+            request_bodies_[1]);
+  EXPECT_EQ(request_count, responses_.size());
+}
+
+TEST_F(JsonRpcRequestBatcherUnitTest, DeduplicateIdenticalRequests) {
+  Request("0x1");
+  Request("0x1");
+  task_environment_.RunUntilIdle();
+
+  ASSERT_EQ(1u, request_bodies_.size());
+  EXPECT_EQ(MakeRequest("0x1"), request_bodies_[0]);
+  ASSERT_EQ(2u, responses_.size());
+  EXPECT_EQ(MakeResponse("0x1"), responses_[0]);
+  EXPECT_EQ(MakeResponse("0x1"), responses_[1]);
+
+  // Completed requests are sent again.
+  Request("0x1");
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(2u, request_bodies_.size());
+}
+
+TEST_F(JsonRpcRequestBatcherUnitTest, FallBackWhenBatchesAreRejected) {
+  reject_batches_ = true;
+
+  Request("0x1");
+  Request("0x2");
+  task_environment_.RunUntilIdle();
+
+  ASSERT_EQ(3u, request_bodies_.size());
+  EXPECT_EQ(MakeRequest("0x1"), request_bodies_[1]);
+  EXPECT_EQ(MakeRequest("0x2"), request_bodies_[2]);
+  ASSERT_EQ(2u, responses_.size());
+  EXPECT_EQ(MakeResponse("0x1"), responses_[0]);
+  EXPECT_EQ(MakeResponse("0x2"), responses_[1]);
+
+  // Requests to the network are no longer batched.
+  Request("0x3");
+  Request("0x4");
+  task_environment_.RunUntilIdle();
+
+  ASSERT_EQ(5u, request_bodies_.size());
+  EXPECT_EQ(MakeRequest("0x3"), request_bodies_[3]);
+  EXPECT_EQ(MakeRequest("0x4"), request_bodies_[4]);
+}
+
+}  // namespace brave_wallet
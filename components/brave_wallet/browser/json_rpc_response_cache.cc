@@ -0,0 +1,106 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/json_rpc_response_cache.h"
+
+#include "base/logging.h"
+
+namespace brave_wallet {
+
+JsonRpcResponseCache::JsonRpcResponseCache() : entries_(kMaxSize) {}
+
+JsonRpcResponseCache::~JsonRpcResponseCache() = default;
+
+absl::optional<std::string> JsonRpcResponseCache::Get(
+    const GURL& network_url,
+    const std::string& json_payload) {
+  auto iter = entries_.Get(Key(network_url, json_payload));
+  if (iter == entries_.end() || IsStale(network_url, iter->second)) {
+    if (iter != entries_.end()) {
+      entries_.Erase(iter);
+    }
+
+    miss_count_++;
+    return absl::nullopt;
+  }
+
+  hit_count_++;
+  DVLOG(1) << "JSON-RPC response cache hit rate: " << hit_count_ << "/"
+           << hit_count_ + miss_count_;
+  return iter->second.body;
+}
+
+void JsonRpcResponseCache::Put(const GURL& network_url,
+                               const std::string& json_payload,
+                               Scope scope,
+                               const absl::optional<uint256_t>&
+                                   request_block_number,
+                               std::string body) {
+  Entry entry;
+  entry.body = std::move(body);
+
+  switch (scope) {
+    case Scope::kBlock: {
+      entry.block_number = GetLatestBlockNumber(network_url);
+      if (!entry.block_number) {
+        // Without an observed block there is nothing to scope the entry to.
+        return;
+      }
+      if (entry.block_number != request_block_number) {
+        // A block was observed while the request was in flight, so the
+        // response may hold the state of the previous block.
+        return;
+      }
+      break;
+    }
+
+    case Scope::kDomainRecord: {
+      entry.expiration_time = base::TimeTicks::Now() + kDomainRecordTimeToLive;
+      break;
+    }
+
+    case Scope::kTimeToLive: {
+      entry.expiration_time = base::TimeTicks::Now() + kTimeToLive;
+      break;
+    }
+  }
+
+  entries_.Put(Key(network_url, json_payload), std::move(entry));
+}
+
+void JsonRpcResponseCache::OnLatestBlock(const GURL& network_url,
+                                         uint256_t block_number) {
+  // Block scoped entries for |network_url| are dropped lazily by |Get|, which
+  // also covers reorgs and endpoints that lag behind.
+  latest_blocks_[network_url] = {block_number, base::TimeTicks::Now()};
+}
+
+void JsonRpcResponseCache::Clear() {
+  entries_.Clear();
+  latest_blocks_.clear();
+}
+
+absl::optional<uint256_t> JsonRpcResponseCache::GetLatestBlockNumber(
+    const GURL& network_url) const {
+  auto iter = latest_blocks_.find(network_url);
+  if (iter == latest_blocks_.end() ||
+      base::TimeTicks::Now() - iter->second.observed_time >=
+          kLatestBlockMaxAge) {
+    return absl::nullopt;
+  }
+
+  return iter->second.block_number;
+}
+
+bool JsonRpcResponseCache::IsStale(const GURL& network_url,
+                                   const Entry& entry) const {
+  if (entry.block_number) {
+    return GetLatestBlockNumber(network_url) != entry.block_number;
+  }
+
+  return base::TimeTicks::Now() >= entry.expiration_time;
+}
+
+}  // namespace brave_wallet
@@ -0,0 +1,99 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_RESPONSE_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_RESPONSE_CACHE_H_
+
+#include <string>
+#include <utility>
+
+#include "base/containers/flat_map.h"
+#include "base/containers/lru_cache.h"
+#include "base/time/time.h"
+#include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
+#include "brave/components/brave_wallet/common/brave_wallet_types.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/gurl.h"
+
+namespace brave_wallet {
+
+// Caches the response bodies of read-only JSON-RPC requests, keyed by network
+// and request payload, i.e. by chain, method and params.
+//
+// Block scoped entries hold chain state such as balances. Blocks are observed
+// by the block trackers, which only run while transactions are pending, so
+// these entries are only cached while the latest block of their network keeps
+// being observed and are stale as soon as another block is observed or the
+// observations stop. Domain records, which are looked up on networks that no
+// tracker follows, and results that do not change once set, such as token
+// URIs, expire after a time to live instead.
+class JsonRpcResponseCache {
+ public:
+  enum class Scope { kBlock, kDomainRecord, kTimeToLive };
+
+  static constexpr size_t kMaxSize = 256;
+  // How long an observed block stays the latest one without being observed
+  // again, i.e. a tracker may miss one poll before block scoped entries are
+  // dropped.
+  static constexpr base::TimeDelta kLatestBlockMaxAge =
+      base::Seconds(2 * kBlockTrackerDefaultTimeInSeconds);
+  static constexpr base::TimeDelta kDomainRecordTimeToLive = base::Minutes(5);
+  static constexpr base::TimeDelta kTimeToLive = base::Hours(1);
+
+  JsonRpcResponseCache();
+  ~JsonRpcResponseCache();
+  JsonRpcResponseCache(const JsonRpcResponseCache&) = delete;
+  JsonRpcResponseCache& operator=(const JsonRpcResponseCache&) = delete;
+
+  absl::optional<std::string> Get(const GURL& network_url,
+                                  const std::string& json_payload);
+  // |request_block_number| is the latest block of |network_url| when the
+  // request was sent. Block scoped entries are only cached if it is still the
+  // latest block, as the response may predate a block observed since.
+  void Put(const GURL& network_url,
+           const std::string& json_payload,
+           Scope scope,
+           const absl::optional<uint256_t>& request_block_number,
+           std::string body);
+
+  void OnLatestBlock(const GURL& network_url, uint256_t block_number);
+  // Returns the latest block of |network_url| if it is still being observed.
+  absl::optional<uint256_t> GetLatestBlockNumber(
+      const GURL& network_url) const;
+
+  void Clear();
+
+  size_t size() const { return entries_.size(); }
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+
+ private:
+  using Key = std::pair<GURL, std::string>;
+
+  struct Entry {
+    std::string body;
+    // Set for block scoped entries.
+    absl::optional<uint256_t> block_number;
+    // Set for entries with a time to live.
+    base::TimeTicks expiration_time;
+  };
+
+  struct LatestBlock {
+    uint256_t block_number;
+    base::TimeTicks observed_time;
+  };
+
+  bool IsStale(const GURL& network_url, const Entry& entry) const;
+
+  base::LRUCache<Key, Entry> entries_;
+  base::flat_map<GURL, LatestBlock> latest_blocks_;
+
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+};
+
+}  // namespace brave_wallet
+
+#endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_JSON_RPC_RESPONSE_CACHE_H_
@@ -0,0 +1,170 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/json_rpc_response_cache.h"
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_wallet {
+
+namespace {
+
+constexpr char kPayload[] = R"({"id":1,"jsonrpc":"2.0","method":"eth_call"})";
+constexpr char kBody[] = R"({"id":1,"jsonrpc":"2.0","result":"0x1"})";
+
+}  // namespace
+
+class JsonRpcResponseCacheUnitTest : public testing::Test {
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  JsonRpcResponseCache cache_;
+  const GURL network_url_{"https://mainnet.example.com/"};
+};
+
+TEST_F(JsonRpcResponseCacheUnitTest, DoNotCacheBlockScopedWithoutBlock) {
+  cache_.Put(network_url_, kPayload, JsonRpcResponseCache::Scope::kBlock,
+             absl::nullopt, kBody);
+
+  EXPECT_FALSE(cache_.Get(network_url_, kPayload));
+  EXPECT_EQ(0u, cache_.size());
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, InvalidateBlockScopedOnNewBlock) {
+  cache_.OnLatestBlock(network_url_, 100);
+  cache_.Put(network_url_, kPayload, JsonRpcResponseCache::Scope::kBlock, 100,
+             kBody);
+
+  EXPECT_EQ(kBody, cache_.Get(network_url_, kPayload));
+
+  // Observing the same block again keeps the entry.
+  cache_.OnLatestBlock(network_url_, 100);
+  EXPECT_EQ(kBody, cache_.Get(network_url_, kPayload));
+
+  // Blocks of other networks do not affect the entry.
+  cache_.OnLatestBlock(GURL("https://polygon.example.com/"), 101);
+  EXPECT_EQ(kBody, cache_.Get(network_url_, kPayload));
+
+  cache_.OnLatestBlock(network_url_, 101);
+  EXPECT_FALSE(cache_.Get(network_url_, kPayload));
+  EXPECT_EQ(0u, cache_.size());
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, DoNotCacheBlockScopedFromPreviousBlock) {
+  // The request is sent at block 100.
+  cache_.OnLatestBlock(network_url_, 100);
+  const absl::optional<uint256_t> request_block_number =
+      cache_.GetLatestBlockNumber(network_url_);
+  EXPECT_EQ(request_block_number, uint256_t(100));
+
+  // Block 101 is observed before the response arrives, which may then hold
+  // the state of block 100.
+  cache_.OnLatestBlock(network_url_, 101);
+  cache_.Put(network_url_, kPayload, JsonRpcResponseCache::Scope::kBlock,
+             request_block_number, kBody);
+
+  EXPECT_FALSE(cache_.Get(network_url_, kPayload));
+  EXPECT_EQ(0u, cache_.size());
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, KeepBlockScopedWhileBlockIsObserved) {
+  cache_.OnLatestBlock(network_url_, 100);
+  cache_.Put(network_url_, kPayload, JsonRpcResponseCache::Scope::kBlock, 100,
+             kBody);
+
+  // A tracker polling the same block keeps the entry alive.
+  for (int i = 0; i < 3; ++i) {
+    task_environment_.FastForwardBy(JsonRpcResponseCache::kLatestBlockMaxAge -
+                                    base::Seconds(1));
+    EXPECT_EQ(kBody, cache_.Get(network_url_, kPayload));
+    cache_.OnLatestBlock(network_url_, 100);
+  }
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, DropBlockScopedOnceBlocksAreNotObserved) {
+  cache_.OnLatestBlock(network_url_, 100);
+  cache_.Put(network_url_, kPayload, JsonRpcResponseCache::Scope::kBlock, 100,
+             kBody);
+
+  // The tracker stopped, the balance may have changed since.
+  task_environment_.FastForwardBy(JsonRpcResponseCache::kLatestBlockMaxAge);
+  EXPECT_FALSE(cache_.Get(network_url_, kPayload));
+
+  // Nor is anything cached until blocks are observed again.
+  cache_.Put(network_url_, kPayload, JsonRpcResponseCache::Scope::kBlock, 100,
+             kBody);
+  EXPECT_EQ(0u, cache_.size());
+
+  cache_.OnLatestBlock(network_url_, 100);
+  cache_.Put(network_url_, kPayload, JsonRpcResponseCache::Scope::kBlock, 100,
+             kBody);
+  EXPECT_EQ(kBody, cache_.Get(network_url_, kPayload));
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, ExpireDomainRecord) {
+  // Domain records are cached on networks without any observed block.
+  cache_.Put(network_url_, kPayload,
+             JsonRpcResponseCache::Scope::kDomainRecord, absl::nullopt, kBody);
+
+  task_environment_.FastForwardBy(
+      JsonRpcResponseCache::kDomainRecordTimeToLive - base::Seconds(1));
+  EXPECT_EQ(kBody, cache_.Get(network_url_, kPayload));
+
+  task_environment_.FastForwardBy(base::Seconds(1));
+  EXPECT_FALSE(cache_.Get(network_url_, kPayload));
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, ExpireTimeToLive) {
+  cache_.Put(network_url_, kPayload, JsonRpcResponseCache::Scope::kTimeToLive,
+             absl::nullopt, kBody);
+
+  // New blocks do not affect entries with a time to live.
+  cache_.OnLatestBlock(network_url_, 100);
+  cache_.OnLatestBlock(network_url_, 101);
+  task_environment_.FastForwardBy(JsonRpcResponseCache::kTimeToLive -
+                                  base::Seconds(1));
+  EXPECT_EQ(kBody, cache_.Get(network_url_, kPayload));
+
+  task_environment_.FastForwardBy(base::Seconds(1));
+  EXPECT_FALSE(cache_.Get(network_url_, kPayload));
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, KeyByNetworkAndPayload) {
+  cache_.Put(network_url_, kPayload, JsonRpcResponseCache::Scope::kTimeToLive,
+             absl::nullopt, kBody);
+
+  EXPECT_FALSE(cache_.Get(GURL("https://polygon.example.com/"), kPayload));
+  EXPECT_FALSE(cache_.Get(
+      network_url_, R"({"id":1,"jsonrpc":"2.0","method":"eth_chainId"})"));
+  EXPECT_EQ(kBody, cache_.Get(network_url_, kPayload));
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, EvictLeastRecentlyUsed) {
+  for (size_t i = 0; i <= JsonRpcResponseCache::kMaxSize; ++i) {
+    cache_.Put(network_url_, base::NumberToString(i),
+               JsonRpcResponseCache::Scope::kTimeToLive, absl::nullopt, kBody);
+  }
+
+  EXPECT_EQ(JsonRpcResponseCache::kMaxSize, cache_.size());
+  EXPECT_FALSE(cache_.Get(network_url_, "0"));
+  EXPECT_EQ(kBody, cache_.Get(network_url_, "1"));
+}
+
+TEST_F(JsonRpcResponseCacheUnitTest, CountHitsAndMisses) {
+  EXPECT_FALSE(cache_.Get(network_url_, kPayload));
+  cache_.Put(network_url_, kPayload, JsonRpcResponseCache::Scope::kTimeToLive,
+             absl::nullopt, kBody);
+  EXPECT_TRUE(cache_.Get(network_url_, kPayload));
+  EXPECT_TRUE(cache_.Get(network_url_, kPayload));
+
+  EXPECT_EQ(2u, cache_.hit_count());
+  EXPECT_EQ(1u, cache_.miss_count());
+}
+
+}  // namespace brave_wallet
@@ -6,29 +6,36 @@
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
 
 #include <memory>
+#include <tuple>
 #include <unordered_set>
 #include <utility>
 
+#include "base/barrier_callback.h"
 #include "base/base64.h"
 #include "base/bind.h"
 #include "base/feature_list.h"
 #include "base/json/json_writer.h"
 #include "base/no_destructor.h"
 #include "base/notreached.h"
+#include "base/ranges/algorithm.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "brave/components/brave_wallet/browser/blockchain_registry.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_service.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_utils.h"
 #include "brave/components/brave_wallet/browser/ens_resolver_task.h"
+#include "brave/components/brave_wallet/browser/eth_abi_decoder.h"
 #include "brave/components/brave_wallet/browser/eth_data_builder.h"
 #include "brave/components/brave_wallet/browser/eth_requests.h"
 #include "brave/components/brave_wallet/browser/eth_response_parser.h"
 #include "brave/components/brave_wallet/browser/eth_topics_builder.h"
 #include "brave/components/brave_wallet/browser/fil_requests.h"
 #include "brave/components/brave_wallet/browser/fil_response_parser.h"
+#include "brave/components/brave_wallet/browser/json_rpc_request_batcher.h"
 #include "brave/components/brave_wallet/browser/json_rpc_requests_helper.h"
+#include "brave/components/brave_wallet/browser/json_rpc_response_cache.h"
 #include "brave/components/brave_wallet/browser/json_rpc_response_parser.h"
 #include "brave/components/brave_wallet/browser/pref_names.h"
 #include "brave/components/brave_wallet/browser/solana_keyring.h"
@@ -52,6 +59,8 @@
 #include "components/grit/brave_components_strings.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_status_code.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
 #include "third_party/re2/src/re2/re2.h"
 #include "ui/base/l10n/l10n_util.h"
@@ -131,6 +140,11 @@ bool EnsL2FeatureEnabled() {
       brave_wallet::features::kBraveWalletENSL2Feature);
 }
 
+bool JsonRpcResponseCacheEnabled() {
+  return base::FeatureList::IsEnabled(
+      brave_wallet::features::kBraveWalletJsonRpcResponseCacheFeature);
+}
+
 bool EnsOffchainPrefEnabled(PrefService* local_state_prefs) {
   return decentralized_dns::GetEnsOffchainResolveMethod(local_state_prefs) ==
          EnsOffchainResolveMethod::kEnabled;
@@ -162,6 +176,9 @@ JsonRpcService::JsonRpcService(
     PrefService* local_state_prefs)
     : api_request_helper_(new APIRequestHelper(GetNetworkTrafficAnnotationTag(),
                                                url_loader_factory)),
+      request_batcher_(
+          std::make_unique<JsonRpcRequestBatcher>(api_request_helper_.get())),
+      response_cache_(std::make_unique<JsonRpcResponseCache>()),
       prefs_(prefs),
       local_state_prefs_(local_state_prefs),
       weak_ptr_factory_(this) {
@@ -194,6 +211,8 @@ void JsonRpcService::SetAPIRequestHelperForTesting(
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory) {
   api_request_helper_ = std::make_unique<APIRequestHelper>(
       GetNetworkTrafficAnnotationTag(), url_loader_factory);
+  request_batcher_ =
+      std::make_unique<JsonRpcRequestBatcher>(api_request_helper_.get());
   if (EnsL2FeatureEnabled()) {
     api_request_helper_ens_offchain_ = std::make_unique<APIRequestHelper>(
         GetENSOffchainNetworkTrafficAnnotationTag(), url_loader_factory);
@@ -282,6 +301,63 @@ void JsonRpcService::RequestInternal(
                                std::move(conversion_callback));
 }
 
+void JsonRpcService::RequestCached(
+    const std::string& json_payload,
+    const GURL& network_url,
+    JsonRpcResponseCache::Scope scope,
+    bool batch,
+    RequestIntermediateCallback callback,
+    APIRequestHelper::ResponseConversionCallback conversion_callback =
+        base::NullCallback()) {
+  DCHECK(network_url.is_valid());
+  // Batched responses are not passed through |conversion_callback|.
+  DCHECK(!batch || !conversion_callback);
+
+  if (JsonRpcResponseCacheEnabled()) {
+    if (auto body = response_cache_->Get(network_url, json_payload)) {
+      base::SequencedTaskRunnerHandle::Get()->PostTask(
+          FROM_HERE,
+          base::BindOnce(std::move(callback),
+                         APIRequestResult(net::HTTP_OK, std::move(*body), {},
+                                          net::OK, network_url)));
+      return;
+    }
+
+    callback = base::BindOnce(
+        &JsonRpcService::OnRequestCachedResult, weak_ptr_factory_.GetWeakPtr(),
+        json_payload, network_url, scope,
+        response_cache_->GetLatestBlockNumber(network_url),
+        std::move(callback));
+  }
+
+  if (batch) {
+    request_batcher_->Request(network_url, json_payload, std::move(callback));
+    return;
+  }
+
+  RequestInternal(json_payload, true, network_url, std::move(callback),
+                  std::move(conversion_callback));
+}
+
+void JsonRpcService::OnRequestCachedResult(
+    const std::string& json_payload,
+    const GURL& network_url,
+    JsonRpcResponseCache::Scope scope,
+    const absl::optional<uint256_t>& request_block_number,
+    RequestIntermediateCallback callback,
+    APIRequestResult api_request_result) {
+  // Only successful results are cached, errors are retried the next time.
+  if (api_request_result.Is2XXResponseCode()) {
+    auto result = ParseResultValue(api_request_result.body());
+    if (result && !result->is_none()) {
+      response_cache_->Put(network_url, json_payload, scope,
+                           request_block_number, api_request_result.body());
+    }
+  }
+
+  std::move(callback).Run(std::move(api_request_result));
+}
+
 void JsonRpcService::Request(const std::string& json_payload,
                              bool auto_retry_on_network_change,
                              base::Value id,
@@ -634,11 +710,11 @@ void JsonRpcService::SetCustomNetworkForTesting(const std::string& chain_id,
 }
 
 void JsonRpcService::GetBlockNumber(GetBlockNumberCallback callback) {
-  auto internal_callback =
-      base::BindOnce(&JsonRpcService::OnGetBlockNumber,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_blockNumber(), true,
-                  network_urls_[mojom::CoinType::ETH],
+  const GURL& network_url = network_urls_[mojom::CoinType::ETH];
+  auto internal_callback = base::BindOnce(&JsonRpcService::OnGetBlockNumber,
+                                          weak_ptr_factory_.GetWeakPtr(),
+                                          network_url, std::move(callback));
+  RequestInternal(eth::eth_blockNumber(), true, network_url,
                   std::move(internal_callback));
 }
 
@@ -667,7 +743,8 @@ void JsonRpcService::OnGetFilStateSearchMsgLimited(
                           "");
 }
 
-void JsonRpcService::OnGetBlockNumber(GetBlockNumberCallback callback,
+void JsonRpcService::OnGetBlockNumber(const GURL& network_url,
+                                      GetBlockNumberCallback callback,
                                       APIRequestResult api_request_result) {
   if (!api_request_result.Is2XXResponseCode()) {
     std::move(callback).Run(
@@ -685,6 +762,7 @@ void JsonRpcService::OnGetBlockNumber(GetBlockNumberCallback callback,
     return;
   }
 
+  response_cache_->OnLatestBlock(network_url, block_number);
   std::move(callback).Run(block_number, mojom::ProviderError::kSuccess, "");
 }
 
@@ -745,8 +823,9 @@ void JsonRpcService::GetBalance(const std::string& address,
     auto internal_callback =
         base::BindOnce(&JsonRpcService::OnEthGetBalance,
                        weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-    RequestInternal(eth::eth_getBalance(address, kEthereumBlockTagLatest), true,
-                    network_url, std::move(internal_callback));
+    RequestCached(eth::eth_getBalance(address, kEthereumBlockTagLatest),
+                  network_url, JsonRpcResponseCache::Scope::kBlock, true,
+                  std::move(internal_callback));
     return;
   } else if (coin == mojom::CoinType::FIL) {
     auto internal_callback =
@@ -946,9 +1025,9 @@ void JsonRpcService::GetTransactionReceipt(const std::string& tx_hash,
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetTransactionReceipt,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_getTransactionReceipt(tx_hash), true,
-                  network_urls_[mojom::CoinType::ETH],
-                  std::move(internal_callback));
+  request_batcher_->Request(network_urls_[mojom::CoinType::ETH],
+                            eth::eth_getTransactionReceipt(tx_hash),
+                            std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetTransactionReceipt(
@@ -1022,9 +1101,10 @@ void JsonRpcService::GetERC20TokenBalance(
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetERC20TokenBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(
+  RequestCached(
       eth::eth_call("", contract, "", "", "", data, kEthereumBlockTagLatest),
-      true, network_url, std::move(internal_callback));
+      network_url, JsonRpcResponseCache::Scope::kBlock, true,
+      std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetERC20TokenBalance(
@@ -1057,6 +1137,140 @@ void JsonRpcService::OnGetERC20TokenBalance(
   std::move(callback).Run(args->at(0), mojom::ProviderError::kSuccess, "");
 }
 
+void JsonRpcService::GetERC20TokenBalances(
+    const std::vector<std::string>& contracts,
+    const std::string& address,
+    const std::string& chain_id,
+    GetERC20TokenBalancesCallback callback) {
+  auto network_url = GetNetworkURL(prefs_, chain_id, mojom::CoinType::ETH);
+  auto owner = EthAddress::FromHex(address);
+  if (!network_url.is_valid() || !owner.IsValid()) {
+    std::move(callback).Run(
+        {}, mojom::ProviderError::kInvalidParams,
+        l10n_util::GetStringUTF8(IDS_WALLET_INVALID_PARAMETERS));
+    return;
+  }
+
+  const auto balance_of = erc20::BalanceOf(owner);
+  std::vector<std::vector<uint8_t>> calls;
+  calls.reserve(contracts.size());
+  for (const auto& contract : contracts) {
+    auto target = EthAddress::FromHex(contract);
+    if (!target.IsValid()) {
+      std::move(callback).Run(
+          {}, mojom::ProviderError::kInvalidParams,
+          l10n_util::GetStringUTF8(IDS_WALLET_INVALID_PARAMETERS));
+      return;
+    }
+    calls.push_back(multicall3::Call3(target, balance_of));
+  }
+
+  if (calls.empty()) {
+    std::move(callback).Run({}, mojom::ProviderError::kSuccess, "");
+    return;
+  }
+
+  // Selector, offset and size of the calls array.
+  constexpr size_t kAggregate3CallDataSize =
+      eth_abi::kSelectorLength + 2 * eth_abi::kRowLength;
+  std::vector<std::vector<std::vector<uint8_t>>> chunks(1);
+  uint64_t chunk_gas = 0;
+  size_t chunk_call_data_size = kAggregate3CallDataSize;
+  for (auto& call : calls) {
+    // Offset to the call and the call itself.
+    const size_t call_data_size = eth_abi::kRowLength + call.size();
+    if (!chunks.back().empty() &&
+        (chunk_gas + kERC20BalanceOfGas > kMulticall3MaxGas ||
+         chunk_call_data_size + call_data_size > kMulticall3MaxCallDataSize)) {
+      chunks.emplace_back();
+      chunk_gas = 0;
+      chunk_call_data_size = kAggregate3CallDataSize;
+    }
+    chunks.back().push_back(std::move(call));
+    chunk_gas += kERC20BalanceOfGas;
+    chunk_call_data_size += call_data_size;
+  }
+
+  std::vector<size_t> chunk_sizes;
+  for (const auto& chunk : chunks) {
+    chunk_sizes.push_back(chunk.size());
+  }
+
+  auto barrier_callback = base::BarrierCallback<Aggregate3Result>(
+      chunks.size(),
+      base::BindOnce(&JsonRpcService::OnGetERC20TokenBalances,
+                     weak_ptr_factory_.GetWeakPtr(), std::move(chunk_sizes),
+                     std::move(callback)));
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    auto internal_callback = base::BindOnce(
+        [](base::RepeatingCallback<void(Aggregate3Result)> barrier_callback,
+           size_t chunk_index, APIRequestResult api_request_result) {
+          barrier_callback.Run({chunk_index, std::move(api_request_result)});
+        },
+        barrier_callback, i);
+    // Chunks are sent in a single batch where the network supports it.
+    RequestCached(eth::eth_call(multicall3::kMulticall3Address,
+                                ToHex(multicall3::Aggregate3(chunks[i]))),
+                  network_url, JsonRpcResponseCache::Scope::kBlock, true,
+                  std::move(internal_callback));
+  }
+}
+
+void JsonRpcService::OnGetERC20TokenBalances(
+    std::vector<size_t> chunk_sizes,
+    GetERC20TokenBalancesCallback callback,
+    std::vector<Aggregate3Result> results) {
+  base::ranges::sort(results, {}, &Aggregate3Result::first);
+
+  std::vector<absl::optional<std::string>> balances;
+  bool has_result = false;
+  mojom::ProviderError error = mojom::ProviderError::kInternalError;
+  std::string error_message =
+      l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR);
+  for (const auto& [chunk_index, api_request_result] : results) {
+    const size_t chunk_size = chunk_sizes[chunk_index];
+    absl::optional<std::vector<absl::optional<std::vector<uint8_t>>>>
+        return_data;
+    if (api_request_result.Is2XXResponseCode()) {
+      return_data =
+          eth::ParseMulticall3Aggregate3Result(api_request_result.body());
+      if (!return_data) {
+        ParseErrorResult<mojom::ProviderError>(api_request_result.body(),
+                                               &error, &error_message);
+      }
+    }
+
+    // A failed chunk only fails the balances of its own calls.
+    if (!return_data || return_data->size() != chunk_size) {
+      balances.insert(balances.end(), chunk_size, absl::nullopt);
+      continue;
+    }
+
+    has_result = true;
+    for (const auto& data : *return_data) {
+      // Reverted calls and contracts without balanceOf have no balance.
+      if (!data) {
+        balances.push_back(absl::nullopt);
+        continue;
+      }
+      auto decoded = ABIDecode({"uint256"}, *data);
+      if (!decoded || std::get<1>(*decoded).size() != 1) {
+        balances.push_back(absl::nullopt);
+        continue;
+      }
+      balances.push_back(std::get<1>(*decoded)[0]);
+    }
+  }
+
+  if (!has_result) {
+    std::move(callback).Run({}, error, error_message);
+    return;
+  }
+
+  std::move(callback).Run(std::move(balances), mojom::ProviderError::kSuccess,
+                          "");
+}
+
 void JsonRpcService::GetERC20TokenAllowance(
     const std::string& contract_address,
     const std::string& owner_address,
@@ -1073,10 +1287,11 @@ void JsonRpcService::GetERC20TokenAllowance(
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetERC20TokenAllowance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_call("", contract_address, "", "", "", data,
-                                kEthereumBlockTagLatest),
-                  true, network_urls_[mojom::CoinType::ETH],
-                  std::move(internal_callback));
+  RequestCached(eth::eth_call("", contract_address, "", "", "", data,
+                              kEthereumBlockTagLatest),
+                network_urls_[mojom::CoinType::ETH],
+                JsonRpcResponseCache::Scope::kBlock, false,
+                std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetERC20TokenAllowance(
@@ -1125,9 +1340,10 @@ void JsonRpcService::EnsRegistryGetResolver(const std::string& domain,
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnEnsRegistryGetResolver,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_call("", contract_address, "", "", "", data,
-                                kEthereumBlockTagLatest),
-                  true, GetEnsRpcUrl(), std::move(internal_callback));
+  RequestCached(eth::eth_call("", contract_address, "", "", "", data,
+                              kEthereumBlockTagLatest),
+                GetEnsRpcUrl(), JsonRpcResponseCache::Scope::kDomainRecord,
+                false, std::move(internal_callback));
 }
 
 void JsonRpcService::OnEnsRegistryGetResolver(
@@ -1212,9 +1428,10 @@ void JsonRpcService::ContinueEnsGetContentHash(
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnEnsGetContentHash,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_call("", resolver_address, "", "", "", data,
-                                kEthereumBlockTagLatest),
-                  true, GetEnsRpcUrl(), std::move(internal_callback));
+  RequestCached(eth::eth_call("", resolver_address, "", "", "", data,
+                              kEthereumBlockTagLatest),
+                GetEnsRpcUrl(), JsonRpcResponseCache::Scope::kDomainRecord,
+                false, std::move(internal_callback));
 }
 
 void JsonRpcService::OnEnsGetContentHash(EnsGetContentHashCallback callback,
@@ -1507,9 +1724,10 @@ void JsonRpcService::ContinueEnsGetEthAddr(const std::string& domain,
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnEnsGetEthAddr,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(eth::eth_call("", resolver_address, "", "", "", data,
-                                kEthereumBlockTagLatest),
-                  true, GetEnsRpcUrl(), std::move(internal_callback));
+  RequestCached(eth::eth_call("", resolver_address, "", "", "", data,
+                              kEthereumBlockTagLatest),
+                GetEnsRpcUrl(), JsonRpcResponseCache::Scope::kDomainRecord,
+                false, std::move(internal_callback));
 }
 
 void JsonRpcService::OnEnsGetEthAddr(EnsGetEthAddrCallback callback,
@@ -1575,9 +1793,9 @@ void JsonRpcService::UnstoppableDomainsResolveDns(
     auto eth_call = eth::eth_call(
         "", GetUnstoppableDomainsProxyReaderContractAddress(chain_id), "", "",
         "", *data, kEthereumBlockTagLatest);
-    RequestInternal(std::move(eth_call), true,
-                    GetUnstoppableDomainsRpcUrl(chain_id),
-                    std::move(internal_callback));
+    RequestCached(std::move(eth_call), GetUnstoppableDomainsRpcUrl(chain_id),
+                  JsonRpcResponseCache::Scope::kDomainRecord, false,
+                  std::move(internal_callback));
   }
 }
 
@@ -1641,9 +1859,9 @@ void JsonRpcService::UnstoppableDomainsGetWalletAddr(
     auto eth_call =
         eth::eth_call(GetUnstoppableDomainsProxyReaderContractAddress(chain_id),
                       ToHex(call_data));
-    RequestInternal(std::move(eth_call), true,
-                    GetUnstoppableDomainsRpcUrl(chain_id),
-                    std::move(internal_callback));
+    RequestCached(std::move(eth_call), GetUnstoppableDomainsRpcUrl(chain_id),
+                  JsonRpcResponseCache::Scope::kDomainRecord, false,
+                  std::move(internal_callback));
   }
 }
 
@@ -1892,9 +2110,10 @@ void JsonRpcService::GetERC721OwnerOf(const std::string& contract,
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetERC721OwnerOf,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(
+  RequestCached(
       eth::eth_call("", contract, "", "", "", data, kEthereumBlockTagLatest),
-      true, network_url, std::move(internal_callback));
+      network_url, JsonRpcResponseCache::Scope::kBlock, true,
+      std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetERC721OwnerOf(GetERC721OwnerOfCallback callback,
@@ -2060,9 +2279,10 @@ void JsonRpcService::OnGetSupportsInterfaceTokenMetadata(
       base::BindOnce(&JsonRpcService::OnGetTokenUri,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
 
-  RequestInternal(eth::eth_call("", contract_address, "", "", "",
-                                function_signature, kEthereumBlockTagLatest),
-                  true, network_url, std::move(internal_callback));
+  RequestCached(eth::eth_call("", contract_address, "", "", "",
+                              function_signature, kEthereumBlockTagLatest),
+                network_url, JsonRpcResponseCache::Scope::kTimeToLive, false,
+                std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetTokenUri(GetTokenMetadataCallback callback,
@@ -2288,9 +2508,10 @@ void JsonRpcService::GetSupportsInterface(
       base::BindOnce(&JsonRpcService::OnGetSupportsInterface,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
   DCHECK(network_urls_.contains(mojom::CoinType::ETH));
-  RequestInternal(eth::eth_call("", contract_address, "", "", "", data,
-                                kEthereumBlockTagLatest),
-                  true, network_url, std::move(internal_callback));
+  RequestCached(eth::eth_call("", contract_address, "", "", "", data,
+                              kEthereumBlockTagLatest),
+                network_url, JsonRpcResponseCache::Scope::kBlock, true,
+                std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetSupportsInterface(
@@ -2407,6 +2628,7 @@ void JsonRpcService::Reset() {
 
   add_chain_pending_requests_.clear();
   switch_chain_requests_.clear();
+  response_cache_->Clear();
   // Reject pending suggest token requests when network changed.
   for (auto& callback : switch_chain_callbacks_) {
     base::Value formed_response = GetProviderErrorDictionary(
@@ -2435,9 +2657,10 @@ void JsonRpcService::GetSolanaBalance(const std::string& pubkey,
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetSolanaBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(solana::getBalance(pubkey), true, network_url,
-                  std::move(internal_callback),
-                  base::BindOnce(&ConvertUint64ToString, "/result/value"));
+  RequestCached(solana::getBalance(pubkey), network_url,
+                JsonRpcResponseCache::Scope::kBlock, false,
+                std::move(internal_callback),
+                base::BindOnce(&ConvertUint64ToString, "/result/value"));
 }
 
 void JsonRpcService::GetSPLTokenAccountBalance(
@@ -2466,8 +2689,9 @@ void JsonRpcService::GetSPLTokenAccountBalance(
   auto internal_callback =
       base::BindOnce(&JsonRpcService::OnGetSPLTokenAccountBalance,
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(solana::getTokenAccountBalance(*associated_token_account),
-                  true, network_url, std::move(internal_callback));
+  RequestCached(solana::getTokenAccountBalance(*associated_token_account),
+                network_url, JsonRpcResponseCache::Scope::kBlock, false,
+                std::move(internal_callback));
 }
 
 void JsonRpcService::OnGetSolanaBalance(GetSolanaBalanceCallback callback,
@@ -2619,17 +2843,18 @@ void JsonRpcService::OnSendSolanaTransaction(
 
 void JsonRpcService::GetSolanaLatestBlockhash(
     GetSolanaLatestBlockhashCallback callback) {
-  auto internal_callback =
-      base::BindOnce(&JsonRpcService::OnGetSolanaLatestBlockhash,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(callback));
-  RequestInternal(solana::getLatestBlockhash(), true,
-                  network_urls_[mojom::CoinType::SOL],
+  const GURL& network_url = network_urls_[mojom::CoinType::SOL];
+  auto internal_callback = base::BindOnce(
+      &JsonRpcService::OnGetSolanaLatestBlockhash,
+      weak_ptr_factory_.GetWeakPtr(), network_url, std::move(callback));
+  RequestInternal(solana::getLatestBlockhash(), true, network_url,
                   std::move(internal_callback),
                   base::BindOnce(&ConvertUint64ToString,
                                  "/result/value/lastValidBlockHeight"));
 }
 
 void JsonRpcService::OnGetSolanaLatestBlockhash(
+    const GURL& network_url,
     GetSolanaLatestBlockhashCallback callback,
     APIRequestResult api_request_result) {
   if (!api_request_result.Is2XXResponseCode()) {
@@ -2651,6 +2876,8 @@ void JsonRpcService::OnGetSolanaLatestBlockhash(
     return;
   }
 
+  // The last valid block height moves with every new block.
+  response_cache_->OnLatestBlock(network_url, last_valid_block_height);
   std::move(callback).Run(blockhash, last_valid_block_height,
                           mojom::SolanaProviderError::kSuccess, "");
 }
@@ -19,6 +19,7 @@
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/browser/ens_resolver_task.h"
+#include "brave/components/brave_wallet/browser/json_rpc_response_cache.h"
 #include "brave/components/brave_wallet/browser/sns_resolver_task.h"
 #include "brave/components/brave_wallet/browser/solana_transaction.h"
 #include "brave/components/brave_wallet/browser/unstoppable_domains_multichain_calls.h"
@@ -43,6 +44,7 @@ class PrefService;
 namespace brave_wallet {
 
 class EnsResolverTask;
+class JsonRpcRequestBatcher;
 
 class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
  public:
@@ -159,6 +161,18 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
                             const std::string& address,
                             const std::string& chain_id,
                             GetERC20TokenBalanceCallback callback) override;
+  // Queries balances through Multicall3 aggregate3 eth_calls, each holding as
+  // many balanceOf calls as the limits below allow.
+  void GetERC20TokenBalances(const std::vector<std::string>& contracts,
+                             const std::string& address,
+                             const std::string& chain_id,
+                             GetERC20TokenBalancesCallback callback) override;
+  // Gas and calldata limits of each aggregated eth_call, below what nodes
+  // commonly accept for eth_call.
+  static constexpr uint64_t kMulticall3MaxGas = 25000000;
+  static constexpr size_t kMulticall3MaxCallDataSize = 64 * 1024;
+  // Upper bound of the gas used by balanceOf of common ERC20 tokens.
+  static constexpr uint64_t kERC20BalanceOfGas = 60000;
   void GetERC20TokenAllowance(const std::string& contract_address,
                               const std::string& owner_address,
                               const std::string& spender_address,
@@ -355,6 +369,9 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
 
   void SetAPIRequestHelperForTesting(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
+  JsonRpcResponseCache* GetResponseCacheForTesting() {
+    return response_cache_.get();
+  }
 
   // Solana JSON RPCs
   void GetSolanaBalance(const std::string& pubkey,
@@ -416,7 +433,8 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
       APIRequestResult api_request_result);
   void OnGetFilBlockHeight(GetFilBlockHeightCallback callback,
                            APIRequestResult api_request_result);
-  void OnGetBlockNumber(GetBlockNumberCallback callback,
+  void OnGetBlockNumber(const GURL& network_url,
+                        GetBlockNumberCallback callback,
                         APIRequestResult api_request_result);
   void OnGetFeeHistory(GetFeeHistoryCallback callback,
                        APIRequestResult api_request_result);
@@ -436,6 +454,11 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
                             APIRequestResult api_request_result);
   void OnGetERC20TokenBalance(GetERC20TokenBalanceCallback callback,
                               APIRequestResult api_request_result);
+  // Index of the aggregated call and its result.
+  using Aggregate3Result = std::pair<size_t, APIRequestResult>;
+  void OnGetERC20TokenBalances(std::vector<size_t> chunk_sizes,
+                               GetERC20TokenBalancesCallback callback,
+                               std::vector<Aggregate3Result> results);
   void OnGetERC20TokenAllowance(GetERC20TokenAllowanceCallback callback,
                                 APIRequestResult api_request_result);
   void OnUnstoppableDomainsResolveDns(const std::string& domain,
@@ -500,6 +523,23 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
       const GURL& network_url,
       RequestIntermediateCallback callback,
       APIRequestHelper::ResponseConversionCallback conversion_callback);
+  // Like |RequestInternal| for read-only requests, answering from
+  // |response_cache_| when possible. |batch| lets |request_batcher_| batch the
+  // request.
+  void RequestCached(
+      const std::string& json_payload,
+      const GURL& network_url,
+      JsonRpcResponseCache::Scope scope,
+      bool batch,
+      RequestIntermediateCallback callback,
+      APIRequestHelper::ResponseConversionCallback conversion_callback);
+  void OnRequestCachedResult(const std::string& json_payload,
+                             const GURL& network_url,
+                             JsonRpcResponseCache::Scope scope,
+                             const absl::optional<uint256_t>&
+                                 request_block_number,
+                             RequestIntermediateCallback callback,
+                             APIRequestResult api_request_result);
   void OnEthChainIdValidatedForOrigin(const std::string& chain_id,
                                       const GURL& rpc_url,
                                       APIRequestResult api_request_result);
@@ -551,7 +591,8 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
                                    APIRequestResult api_request_result);
   void OnSendSolanaTransaction(SendSolanaTransactionCallback callback,
                                APIRequestResult api_request_result);
-  void OnGetSolanaLatestBlockhash(GetSolanaLatestBlockhashCallback callback,
+  void OnGetSolanaLatestBlockhash(const GURL& network_url,
+                                  GetSolanaLatestBlockhashCallback callback,
                                   APIRequestResult api_request_result);
   void OnGetSolanaSignatureStatuses(GetSolanaSignatureStatusesCallback callback,
                                     APIRequestResult api_request_result);
@@ -565,6 +606,10 @@ class JsonRpcService : public KeyedService, public mojom::JsonRpcService {
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   std::unique_ptr<APIRequestHelper> api_request_helper_;
   std::unique_ptr<APIRequestHelper> api_request_helper_ens_offchain_;
+  // Batches read-only requests such as balance lookups, see
+  // |JsonRpcRequestBatcher|.
+  std::unique_ptr<JsonRpcRequestBatcher> request_batcher_;
+  std::unique_ptr<JsonRpcResponseCache> response_cache_;
   base::flat_map<mojom::CoinType, GURL> network_urls_;
   // <mojom::CoinType, chain_id>
   base::flat_map<mojom::CoinType, std::string> chain_ids_;
@@ -15,12 +15,14 @@
 #include "base/base64.h"
 #include "base/bind.h"
 #include "base/callback.h"
+#include "base/callback_helpers.h"
 #include "base/containers/contains.h"
 #include "base/containers/span.h"
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/notreached.h"
 #include "base/ranges/algorithm.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/task_traits.h"
 #include "base/task/thread_pool.h"
@@ -612,6 +614,10 @@ class JsonRpcEnpointHandler {
       }
     }
 
+    if (value && value->is_list()) {
+      return HandleBatch(value->GetList());
+    }
+
     return absl::nullopt;
   }
 
@@ -634,6 +640,29 @@ class JsonRpcEnpointHandler {
     return HandleSolRpcCall(dict);
   }
 
+  // Handles requests batched by JsonRpcRequestBatcher.
+  absl::optional<std::string> HandleBatch(const base::Value::List& batch) {
+    base::Value::List responses;
+    for (const auto& item : batch) {
+      if (!item.is_dict())
+        return absl::nullopt;
+
+      auto response = HandleCall(item.GetDict());
+      if (!response || *response == "timeout")
+        return response;
+
+      auto response_value = base::JSONReader::Read(*response);
+      if (!response_value || !response_value->is_dict())
+        return absl::nullopt;
+      response_value->GetDict().Set("id", item.GetDict().Find("id")->Clone());
+      responses.Append(std::move(*response_value));
+    }
+
+    std::string response;
+    base::JSONWriter::Write(responses, &response);
+    return response;
+  }
+
   absl::optional<std::string> HandleEthCall(const base::Value::Dict& dict) {
     auto* params_list = dict.FindList("params");
     if (!params_list || params_list->size() == 0 ||
@@ -684,7 +713,12 @@ class JsonRpcEnpointHandler {
 
 class JsonRpcServiceUnitTest : public testing::Test {
  public:
-  JsonRpcServiceUnitTest() = default;
+  JsonRpcServiceUnitTest() {
+    // Most tests expect every call to reach the network, the response cache
+    // is covered by JsonRpcServiceResponseCacheUnitTest.
+    response_cache_feature_list_.InitAndDisableFeature(
+        features::kBraveWalletJsonRpcResponseCacheFeature);
+  }
 
   void SetUp() override {
     Test::SetUp();
@@ -1403,6 +1437,7 @@ class JsonRpcServiceUnitTest : public testing::Test {
   network::TestURLLoaderFactory url_loader_factory_;
 
  private:
+  base::test::ScopedFeatureList response_cache_feature_list_;
   base::test::TaskEnvironment task_environment_;
   sync_preferences::TestingPrefServiceSyncable prefs_;
   sync_preferences::TestingPrefServiceSyncable local_state_prefs_;
@@ -2265,6 +2300,106 @@ TEST_F(JsonRpcServiceUnitTest, GetBalance) {
   EXPECT_TRUE(callback_called);
 }
 
+class JsonRpcServiceResponseCacheUnitTest : public JsonRpcServiceUnitTest {
+ public:
+  JsonRpcServiceResponseCacheUnitTest() = default;
+
+ private:
+  base::test::ScopedFeatureList feature_list_{
+      features::kBraveWalletJsonRpcResponseCacheFeature};
+};
+
+TEST_F(JsonRpcServiceResponseCacheUnitTest, CacheBalanceForLatestBlock) {
+  size_t request_count = 0;
+  std::string block_number = "0x10";
+  std::string balance = "0xb539d5";
+  url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
+      [&](const network::ResourceRequest& request) {
+        base::StringPiece request_string(request.request_body->elements()
+                                             ->at(0)
+                                             .As<network::DataElementBytes>()
+                                             .AsStringPiece());
+        request_count++;
+        const std::string& result =
+            request_string.find("eth_blockNumber") != std::string::npos
+                ? block_number
+                : balance;
+        url_loader_factory_.ClearResponses();
+        url_loader_factory_.AddResponse(
+            request.url.spec(),
+            "{\"jsonrpc\":\"2.0\",\"id\":1,\"result\":\"" + result + "\"}");
+      }));
+
+  auto get_balance = [&](const std::string& expected_balance) {
+    bool callback_called = false;
+    json_rpc_service_->GetBalance(
+        "0x4e02f254184E904300e0775E4b8eeCB1", mojom::CoinType::ETH,
+        mojom::kLocalhostChainId,
+        base::BindOnce(&OnStringResponse, &callback_called,
+                       mojom::ProviderError::kSuccess, "", expected_balance));
+    base::RunLoop().RunUntilIdle();
+    EXPECT_TRUE(callback_called);
+  };
+  auto get_block_number = [&]() {
+    json_rpc_service_->GetBlockNumber(base::DoNothing());
+    base::RunLoop().RunUntilIdle();
+  };
+
+  // Balances are not cached until a block has been observed.
+  get_balance("0xb539d5");
+  get_balance("0xb539d5");
+  EXPECT_EQ(2u, request_count);
+
+  get_block_number();
+  get_balance("0xb539d5");
+  EXPECT_EQ(4u, request_count);
+
+  balance = "0x1";
+  get_balance("0xb539d5");
+  EXPECT_EQ(4u, request_count);
+  EXPECT_EQ(1u, json_rpc_service_->GetResponseCacheForTesting()->hit_count());
+
+  // A new block invalidates the cached balance.
+  block_number = "0x11";
+  get_block_number();
+  get_balance("0x1");
+  EXPECT_EQ(6u, request_count);
+}
+
+TEST_F(JsonRpcServiceResponseCacheUnitTest, CacheEnsLookupsWithoutBlock) {
+#if !BUILDFLAG(IS_ANDROID)
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndDisableFeature(features::kBraveWalletENSL2Feature);
+#endif
+
+  SetUDENSInterceptor(mojom::kMainnetChainId);
+  EXPECT_TRUE(SetNetwork(mojom::kMainnetChainId, mojom::CoinType::ETH));
+
+  base::MockCallback<JsonRpcService::EnsGetEthAddrCallback> callback;
+  EXPECT_CALL(callback, Run("0x983110309620D911731Ac0932219af06091b6744", false,
+                            mojom::ProviderError::kSuccess, ""));
+  json_rpc_service_->EnsGetEthAddr("brantly-test.eth", nullptr, callback.Get());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+
+  // No block is observed for the ENS network, the resolver and the address are
+  // still answered from the cache once the endpoint goes down.
+  SetHTTPRequestTimeoutInterceptor();
+  EXPECT_CALL(callback, Run("0x983110309620D911731Ac0932219af06091b6744", false,
+                            mojom::ProviderError::kSuccess, ""));
+  json_rpc_service_->EnsGetEthAddr("brantly-test.eth", nullptr, callback.Get());
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&callback);
+  EXPECT_EQ(2u, json_rpc_service_->GetResponseCacheForTesting()->hit_count());
+
+  // Other domains still reach the endpoint.
+  EXPECT_CALL(callback,
+              Run("", false, mojom::ProviderError::kInternalError,
+                  l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR)));
+  json_rpc_service_->EnsGetEthAddr("other.eth", nullptr, callback.Get());
+  base::RunLoop().RunUntilIdle();
+}
+
 TEST_F(JsonRpcServiceUnitTest, GetFeeHistory) {
   std::string json =
       R"(
@@ -2496,6 +2631,214 @@ TEST_F(JsonRpcServiceUnitTest, GetERC20TokenAllowance) {
   EXPECT_TRUE(callback_called);
 }
 
+// Responds to Multicall3 aggregate3 calls with the target address of each call
+// as its result.
+class Multicall3Aggregate3Handler : public EthCallHandler {
+ public:
+  Multicall3Aggregate3Handler()
+      : EthCallHandler(
+            EthAddress::FromHex(multicall3::kMulticall3Address),
+            GetFunctionHashBytes4("aggregate3((address,bool,bytes)[])")) {}
+  ~Multicall3Aggregate3Handler() override = default;
+
+  absl::optional<std::string> HandleEthCall(eth_abi::Span call_data) override {
+    auto [_, args] = eth_abi::ExtractFunctionSelectorAndArgsFromCall(call_data);
+    auto calls = eth_abi::ExtractTupleArrayFromTuple(args, 0);
+    EXPECT_TRUE(calls);
+    if (!calls)
+      return absl::nullopt;
+
+    aggregated_call_sizes_.push_back(calls->size());
+
+    if (fail_with_timeout_)
+      return "timeout";
+
+    std::vector<std::vector<uint8_t>> results;
+    for (const auto& call : *calls) {
+      auto target = eth_abi::ExtractAddressFromTuple(call, 0);
+      auto allow_failure = eth_abi::ExtractUint256FromTuple(call, 1);
+      EXPECT_TRUE(allow_failure && *allow_failure == 1);
+      auto target_call_data = eth_abi::ExtractBytesFromTuple(call, 2);
+      EXPECT_TRUE(target_call_data);
+
+      if (target == failing_aggregate3_target_)
+        return MakeJsonRpcErrorResponse(-32000, "execution reverted");
+
+      if (target == failing_call_target_) {
+        results.push_back(
+            eth_abi::TupleEncoder().AddUint256(0).AddBytes({}).Encode());
+        continue;
+      }
+
+      results.push_back(
+          eth_abi::TupleEncoder()
+              .AddUint256(1)
+              .AddBytes(eth_abi::TupleEncoder().AddAddress(target).Encode())
+              .Encode());
+    }
+    return MakeJsonRpcTupleResponse(
+        eth_abi::TupleEncoder().AddTupleArray(results));
+  }
+
+  // Fails the call to |target| only.
+  void set_failing_call_target(const EthAddress& target) {
+    failing_call_target_ = target;
+  }
+
+  // Fails the whole aggregated call including a call to |target|.
+  void set_failing_aggregate3_target(const EthAddress& target) {
+    failing_aggregate3_target_ = target;
+  }
+
+  void set_fail_with_timeout(bool fail_with_timeout) {
+    fail_with_timeout_ = fail_with_timeout;
+  }
+
+  const std::vector<size_t>& aggregated_call_sizes() const {
+    return aggregated_call_sizes_;
+  }
+
+ private:
+  EthAddress failing_call_target_;
+  EthAddress failing_aggregate3_target_;
+  bool fail_with_timeout_ = false;
+  std::vector<size_t> aggregated_call_sizes_;
+};
+
+class Multicall3UnitTest : public JsonRpcServiceUnitTest {
+ public:
+  using GetERC20TokenBalancesCallback =
+      mojom::JsonRpcService::GetERC20TokenBalancesCallback;
+
+  void SetUp() override {
+    JsonRpcServiceUnitTest::SetUp();
+    endpoint_handler_ = std::make_unique<JsonRpcEnpointHandler>(
+        GetNetwork(mojom::kMainnetChainId, mojom::CoinType::ETH));
+    aggregate3_handler_ = std::make_unique<Multicall3Aggregate3Handler>();
+    endpoint_handler_->AddEthCallHandler(aggregate3_handler_.get());
+
+    url_loader_factory_.SetInterceptor(base::BindRepeating(
+        &Multicall3UnitTest::HandleRequest, base::Unretained(this)));
+  }
+
+  void HandleRequest(const network::ResourceRequest& request) {
+    request_count_++;
+    url_loader_factory_.ClearResponses();
+    auto response = endpoint_handler_->HandleRequest(request);
+    if (!response) {
+      url_loader_factory_.AddResponse(request.url.spec(), "",
+                                      net::HTTP_INTERNAL_SERVER_ERROR);
+    } else if (response == "timeout") {
+      url_loader_factory_.AddResponse(request.url.spec(), "",
+                                      net::HTTP_REQUEST_TIMEOUT);
+    } else {
+      url_loader_factory_.AddResponse(request.url.spec(), *response);
+    }
+  }
+
+ protected:
+  std::unique_ptr<JsonRpcEnpointHandler> endpoint_handler_;
+  std::unique_ptr<Multicall3Aggregate3Handler> aggregate3_handler_;
+  size_t request_count_ = 0;
+};
+
+TEST_F(Multicall3UnitTest, GetERC20TokenBalances) {
+  constexpr char kOwner[] = "0xB4B2802129071b2B9eBb8cBB01EA1E4D14B34961";
+  // Each balanceOf call takes 224 bytes of calldata, so 300 calls do not fit
+  // in a single aggregated call.
+  std::vector<std::string> contracts;
+  std::vector<absl::optional<std::string>> expected_balances;
+  for (size_t i = 1; i <= 300; ++i) {
+    contracts.push_back(base::StringPrintf("0x%040zx", i));
+    // Balance of each token is its address.
+    expected_balances.push_back(Uint256ValueToHex(i));
+  }
+
+  // A failed balanceOf call only fails its own balance.
+  aggregate3_handler_->set_failing_call_target(
+      EthAddress::FromHex(contracts[6]));
+  expected_balances[6] = absl::nullopt;
+  {
+    base::MockCallback<GetERC20TokenBalancesCallback> callback;
+    EXPECT_CALL(callback, Run(expected_balances,
+                              mojom::ProviderError::kSuccess, ""));
+    json_rpc_service_->GetERC20TokenBalances(
+        contracts, kOwner, mojom::kMainnetChainId, callback.Get());
+    base::RunLoop().RunUntilIdle();
+  }
+  EXPECT_THAT(aggregate3_handler_->aggregated_call_sizes(),
+              ElementsAreArray({292u, 8u}));
+  // Both aggregated calls are sent in a single batch.
+  EXPECT_EQ(1u, request_count_);
+
+  // A failed aggregated call only fails the balances of its calls.
+  aggregate3_handler_->set_failing_aggregate3_target(
+      EthAddress::FromHex(contracts.back()));
+  for (size_t i = 292; i < expected_balances.size(); ++i) {
+    expected_balances[i] = absl::nullopt;
+  }
+  {
+    base::MockCallback<GetERC20TokenBalancesCallback> callback;
+    EXPECT_CALL(callback, Run(expected_balances,
+                              mojom::ProviderError::kSuccess, ""));
+    json_rpc_service_->GetERC20TokenBalances(
+        contracts, kOwner, mojom::kMainnetChainId, callback.Get());
+    base::RunLoop().RunUntilIdle();
+  }
+
+  // Only a single aggregated call, which fails.
+  {
+    base::MockCallback<GetERC20TokenBalancesCallback> callback;
+    EXPECT_CALL(callback,
+                Run(std::vector<absl::optional<std::string>>(),
+                    mojom::ProviderError::kInvalidInput, "execution reverted"));
+    json_rpc_service_->GetERC20TokenBalances({contracts.back()}, kOwner,
+                                             mojom::kMainnetChainId,
+                                             callback.Get());
+    base::RunLoop().RunUntilIdle();
+  }
+
+  // Every aggregated call fails.
+  aggregate3_handler_->set_fail_with_timeout(true);
+  {
+    base::MockCallback<GetERC20TokenBalancesCallback> callback;
+    EXPECT_CALL(callback,
+                Run(std::vector<absl::optional<std::string>>(),
+                    mojom::ProviderError::kInternalError,
+                    l10n_util::GetStringUTF8(IDS_WALLET_INTERNAL_ERROR)));
+    json_rpc_service_->GetERC20TokenBalances(
+        contracts, kOwner, mojom::kMainnetChainId, callback.Get());
+    base::RunLoop().RunUntilIdle();
+  }
+
+  // No contracts.
+  request_count_ = 0;
+  {
+    base::MockCallback<GetERC20TokenBalancesCallback> callback;
+    EXPECT_CALL(callback, Run(std::vector<absl::optional<std::string>>(),
+                              mojom::ProviderError::kSuccess, ""));
+    json_rpc_service_->GetERC20TokenBalances({}, kOwner, mojom::kMainnetChainId,
+                                             callback.Get());
+    base::RunLoop().RunUntilIdle();
+  }
+  EXPECT_EQ(0u, request_count_);
+
+  // Invalid input should fail.
+  for (const auto& [invalid_contract, invalid_owner] :
+       std::vector<std::pair<std::string, std::string>>{
+           {"0xinvalid", kOwner}, {contracts[0], "0xinvalid"}}) {
+    base::MockCallback<GetERC20TokenBalancesCallback> callback;
+    EXPECT_CALL(callback,
+                Run(std::vector<absl::optional<std::string>>(),
+                    mojom::ProviderError::kInvalidParams,
+                    l10n_util::GetStringUTF8(IDS_WALLET_INVALID_PARAMETERS)));
+    json_rpc_service_->GetERC20TokenBalances(
+        {invalid_contract}, invalid_owner, mojom::kMainnetChainId,
+        callback.Get());
+    base::RunLoop().RunUntilIdle();
+  }
+}
+
 class UDGetManyCallHandler : public EthCallHandler {
  public:
   explicit UDGetManyCallHandler(const EthAddress& contract_address)
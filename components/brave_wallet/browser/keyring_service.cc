@@ -8,14 +8,17 @@
 #include <string>
 #include <utility>
 
+#include "base/barrier_callback.h"
 #include "base/base64.h"
 #include "base/command_line.h"
+#include "base/containers/contains.h"
 #include "base/hash/hash.h"
 #include "base/logging.h"
 #include "base/strings/strcat.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task/thread_pool.h"
 #include "base/value_iterators.h"
 #include "base/values.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
@@ -223,6 +226,22 @@ const base::Value::List* GetPrefForKeyringList(const PrefService& prefs,
   return nullptr;
 }
 
+std::vector<uint8_t> CreateSalt() {
+  std::vector<uint8_t> salt(kSaltSize);
+  crypto::RandBytes(salt);
+  return salt;
+}
+
+bool HasEncryptedMnemonic(const PrefService& prefs,
+                          const std::string& keyring_id) {
+  return KeyringService::GetPrefInBytesForKeyring(prefs, kEncryptedMnemonic,
+                                                  keyring_id) &&
+         KeyringService::GetPrefInBytesForKeyring(
+             prefs, kPasswordEncryptorNonce, keyring_id) &&
+         KeyringService::GetPrefInBytesForKeyring(prefs, kPasswordEncryptorSalt,
+                                                  keyring_id);
+}
+
 const base::Value::Dict* GetPrefForKeyringDict(const PrefService& prefs,
                                                const std::string& key,
                                                const std::string& id) {
@@ -236,6 +255,17 @@ const base::Value::Dict* GetPrefForKeyringDict(const PrefService& prefs,
 
 }  // namespace
 
+struct KeyringService::UnlockKeys {
+  std::string keyring_id;
+  std::unique_ptr<PasswordEncryptor> encryptor;
+  // Only set when the keyring is migrated from kPbkdf2IterationsLegacy, in
+  // which case |encryptor| is derived from the new |salt|.
+  std::unique_ptr<PasswordEncryptor> legacy_encryptor;
+  // The salt |legacy_encryptor| is derived from.
+  absl::optional<std::vector<uint8_t>> legacy_salt;
+  std::vector<uint8_t> salt;
+};
+
 KeyringService::KeyringService(JsonRpcService* json_rpc_service,
                                PrefService* prefs)
     : json_rpc_service_(json_rpc_service), prefs_(prefs) {
@@ -557,13 +587,8 @@ void KeyringService::RequestUnlock() {
   request_unlock_pending_ = true;
 }
 
-HDKeyring* KeyringService::ResumeKeyring(const std::string& keyring_id,
-                                         const std::string& password) {
+HDKeyring* KeyringService::ResumeKeyring(const std::string& keyring_id) {
   DCHECK(prefs_);
-  if (!CreateEncryptorForKeyring(password, keyring_id)) {
-    return nullptr;
-  }
-
   const std::string mnemonic = GetMnemonicForKeyringImpl(keyring_id);
   bool is_legacy_brave_wallet = false;
   const base::Value* value =
@@ -633,7 +658,7 @@ HDKeyring* KeyringService::RestoreKeyring(const std::string& keyring_id,
         GetPrefForKeyring(*prefs_, kLegacyBraveWallet, keyring_id);
     if (!current_mnemonic.empty() && current_mnemonic == mnemonic && value &&
         value->GetBool() == is_legacy_brave_wallet) {
-      return ResumeKeyring(keyring_id, password);
+      return ResumeKeyring(keyring_id);
     } else if (keyring_id == mojom::kDefaultKeyringId) {
       // We have no way to check if new mnemonic is same as current mnemonic so
       // we need to clear all prefs for fresh start
@@ -1671,6 +1696,8 @@ absl::optional<std::string> KeyringService::GetFilecoinSelectedAccount(
 }
 
 void KeyringService::Lock() {
+  // Unlock calls still deriving keys must not undo the lock.
+  ++unlock_generation_;
   if (IsLocked(mojom::kDefaultKeyringId))
     return;
 
@@ -1698,14 +1725,145 @@ bool KeyringService::IsHardwareAccount(const std::string& address) const {
 
 void KeyringService::Unlock(const std::string& password,
                             KeyringService::UnlockCallback callback) {
-  if (!ResumeKeyring(mojom::kDefaultKeyringId, password)) {
+  if (password.empty()) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  std::vector<std::string> keyring_ids = {mojom::kDefaultKeyringId};
+  if (IsFilecoinEnabled()) {
+    keyring_ids.push_back(mojom::kFilecoinKeyringId);
+    keyring_ids.push_back(mojom::kFilecoinTestnetKeyringId);
+  }
+  if (IsSolanaEnabled())
+    keyring_ids.push_back(mojom::kSolanaKeyringId);
+  // Keyrings still encrypted with keys derived using kPbkdf2IterationsLegacy
+  // are migrated, including those of disabled coins as with
+  // MaybeMigratePBKDF2Iterations.
+  const bool needs_migration =
+      !prefs_->GetBoolean(kBraveWalletKeyringEncryptionKeysMigrated);
+  for (auto* keyring_id :
+       {mojom::kFilecoinKeyringId, mojom::kFilecoinTestnetKeyringId,
+        mojom::kSolanaKeyringId}) {
+    if (needs_migration && !base::Contains(keyring_ids, keyring_id) &&
+        HasEncryptedMnemonic(*prefs_, keyring_id)) {
+      keyring_ids.push_back(keyring_id);
+    }
+  }
+
+  // Derive the keys of all keyrings in parallel so that unlocking takes the
+  // time of a single PBKDF2 run.
+  auto barrier_callback = base::BarrierCallback<UnlockKeys>(
+      keyring_ids.size(),
+      base::BindOnce(&KeyringService::OnUnlockKeysDerived,
+                     weak_ptr_factory_.GetWeakPtr(), unlock_generation_,
+                     password, std::move(callback)));
+  for (const auto& keyring_id : keyring_ids) {
+    absl::optional<std::vector<uint8_t>> legacy_salt;
+    if (needs_migration && HasEncryptedMnemonic(*prefs_, keyring_id)) {
+      legacy_salt = GetPrefInBytesForKeyring(*prefs_, kPasswordEncryptorSalt,
+                                             keyring_id);
+    }
+    auto salt =
+        legacy_salt ? CreateSalt() : GetOrCreateSaltForKeyring(keyring_id);
+
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+        base::BindOnce(&KeyringService::DeriveUnlockKeys, keyring_id, password,
+                       std::move(salt), GetPbkdf2Iterations(),
+                       std::move(legacy_salt)),
+        barrier_callback);
+  }
+}
+
+// static
+KeyringService::UnlockKeys KeyringService::DeriveUnlockKeys(
+    const std::string& keyring_id,
+    const std::string& password,
+    std::vector<uint8_t> salt,
+    int iterations,
+    absl::optional<std::vector<uint8_t>> legacy_salt) {
+  UnlockKeys keys;
+  keys.keyring_id = keyring_id;
+  if (legacy_salt) {
+    keys.legacy_encryptor = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+        password, *legacy_salt, kPbkdf2IterationsLegacy, kPbkdf2KeySize);
+  }
+  keys.encryptor = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
+      password, salt, iterations, kPbkdf2KeySize);
+  keys.legacy_salt = std::move(legacy_salt);
+  keys.salt = std::move(salt);
+  return keys;
+}
+
+void KeyringService::OnUnlockKeysDerived(uint64_t unlock_generation,
+                                         const std::string& password,
+                                         UnlockCallback callback,
+                                         std::vector<UnlockKeys> derived_keys) {
+  // Locked or reset while the keys were derived.
+  if (unlock_generation != unlock_generation_) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  // Migrated by another call while the keys were derived, such as with a
+  // double submit. The legacy keys no longer decrypt the re-encrypted
+  // mnemonic, so the keys are derived again from the current salts to check
+  // the password.
+  for (const auto& keys : derived_keys) {
+    if (keys.legacy_salt &&
+        (prefs_->GetBoolean(kBraveWalletKeyringEncryptionKeysMigrated) ||
+         GetPrefInBytesForKeyring(*prefs_, kPasswordEncryptorSalt,
+                                  keys.keyring_id) != keys.legacy_salt)) {
+      Unlock(password, std::move(callback));
+      return;
+    }
+  }
+
+  base::flat_map<std::string, std::unique_ptr<PasswordEncryptor>> encryptors;
+  for (auto& keys : derived_keys) {
+    // A keyring that fails to migrate, such as with a wrong password, has no
+    // usable encryptor as its new salt is then discarded.
+    if (keys.legacy_encryptor &&
+        (!keys.encryptor ||
+         !MigratePBKDF2IterationsForKeyring(keys.keyring_id,
+                                            keys.legacy_encryptor.get(),
+                                            keys.salt, keys.encryptor.get()))) {
+      keys.encryptor.reset();
+    }
+    encryptors[keys.keyring_id] = std::move(keys.encryptor);
+  }
+
+  // Unlocked by another call while the keys were derived, which only reports
+  // whether the password was right.
+  if (!IsLocked(mojom::kDefaultKeyringId)) {
+    auto& encryptor = encryptors[mojom::kDefaultKeyringId];
+    auto encrypted_mnemonic = GetPrefInBytesForKeyring(
+        *prefs_, kEncryptedMnemonic, mojom::kDefaultKeyringId);
+    auto nonce = GetPrefInBytesForKeyring(*prefs_, kPasswordEncryptorNonce,
+                                          mojom::kDefaultKeyringId);
+    std::move(callback).Run(
+        encryptor && encrypted_mnemonic && nonce &&
+        encryptor->Decrypt(*encrypted_mnemonic, *nonce).has_value());
+    return;
+  }
+
+  auto resume_keyring = [&](const std::string& keyring_id) {
+    auto& encryptor = encryptors[keyring_id];
+    if (!encryptor)
+      return false;
+    encryptors_[keyring_id] = std::move(encryptor);
+    return ResumeKeyring(keyring_id) != nullptr;
+  };
+
+  if (!resume_keyring(mojom::kDefaultKeyringId)) {
     encryptors_.erase(mojom::kDefaultKeyringId);
     std::move(callback).Run(false);
     return;
   }
 
   if (IsFilecoinEnabled()) {
-    if (!ResumeKeyring(mojom::kFilecoinKeyringId, password)) {
+    if (!resume_keyring(mojom::kFilecoinKeyringId)) {
       // If Filecoin keyring doesnt exist we keep encryptor pre-created
       // to be able to lazily create keyring later
       if (IsKeyringExist(mojom::kFilecoinKeyringId)) {
@@ -1716,7 +1874,7 @@ void KeyringService::Unlock(const std::string& password,
       }
     }
 
-    if (!ResumeKeyring(mojom::kFilecoinTestnetKeyringId, password)) {
+    if (!resume_keyring(mojom::kFilecoinTestnetKeyringId)) {
       if (IsKeyringExist(mojom::kFilecoinTestnetKeyringId)) {
         VLOG(1) << __func__ << " Unable to unlock filecoin testnet keyring";
         encryptors_.erase(mojom::kFilecoinTestnetKeyringId);
@@ -1726,7 +1884,7 @@ void KeyringService::Unlock(const std::string& password,
     }
   }
 
-  if (IsSolanaEnabled() && !ResumeKeyring(mojom::kSolanaKeyringId, password)) {
+  if (IsSolanaEnabled() && !resume_keyring(mojom::kSolanaKeyringId)) {
     if (IsKeyringExist(mojom::kSolanaKeyringId)) {
       VLOG(1) << __func__ << " Unable to unlock Solana keyring";
       encryptors_.erase(mojom::kSolanaKeyringId);
@@ -1754,6 +1912,7 @@ void KeyringService::IsLocked(IsLockedCallback callback) {
 }
 
 void KeyringService::Reset(bool notify_observer) {
+  ++unlock_generation_;
   StopAutoLockTimer();
   encryptors_.clear();
   keyrings_.clear();
@@ -1777,76 +1936,96 @@ void KeyringService::MaybeMigratePBKDF2Iterations(const std::string& password) {
   for (auto* keyring_id :
        {mojom::kDefaultKeyringId, mojom::kFilecoinKeyringId,
         mojom::kFilecoinTestnetKeyringId, mojom::kSolanaKeyringId}) {
+    if (!HasEncryptedMnemonic(*prefs_, keyring_id)) {
+      continue;
+    }
+
     auto legacy_encrypted_mnemonic =
         GetPrefInBytesForKeyring(*prefs_, kEncryptedMnemonic, keyring_id);
     auto legacy_nonce =
         GetPrefInBytesForKeyring(*prefs_, kPasswordEncryptorNonce, keyring_id);
     auto legacy_salt =
         GetPrefInBytesForKeyring(*prefs_, kPasswordEncryptorSalt, keyring_id);
-
-    if (!legacy_encrypted_mnemonic || !legacy_nonce || !legacy_salt) {
-      continue;
-    }
-
     auto legacy_encryptor = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
         password, *legacy_salt, kPbkdf2IterationsLegacy, kPbkdf2KeySize);
-    if (!legacy_encryptor)
+    // Don't derive the new key for a wrong password.
+    if (!legacy_encryptor ||
+        !legacy_encryptor->Decrypt(*legacy_encrypted_mnemonic, *legacy_nonce))
       continue;
 
-    auto mnemonic =
-        legacy_encryptor->Decrypt(*legacy_encrypted_mnemonic, *legacy_nonce);
-    if (!mnemonic)
-      continue;
-
-    auto salt = GetOrCreateSaltForKeyring(keyring_id, /*force_create = */ true);
-
+    auto salt = CreateSalt();
     auto encryptor = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
         password, salt, GetPbkdf2Iterations(), kPbkdf2KeySize);
     if (!encryptor)
       continue;
 
-    auto nonce =
-        GetOrCreateNonceForKeyring(keyring_id, /*force_create = */ true);
+    MigratePBKDF2IterationsForKeyring(keyring_id, legacy_encryptor.get(), salt,
+                                      encryptor.get());
+  }
+}
 
-    SetPrefInBytesForKeyring(
-        prefs_, kEncryptedMnemonic,
-        encryptor->Encrypt(base::make_span(*mnemonic), nonce), keyring_id);
+bool KeyringService::MigratePBKDF2IterationsForKeyring(
+    const std::string& keyring_id,
+    PasswordEncryptor* legacy_encryptor,
+    const std::vector<uint8_t>& salt,
+    PasswordEncryptor* encryptor) {
+  DCHECK(legacy_encryptor);
+  DCHECK(encryptor);
+  auto legacy_encrypted_mnemonic =
+      GetPrefInBytesForKeyring(*prefs_, kEncryptedMnemonic, keyring_id);
+  auto legacy_nonce =
+      GetPrefInBytesForKeyring(*prefs_, kPasswordEncryptorNonce, keyring_id);
+  if (!legacy_encrypted_mnemonic || !legacy_nonce) {
+    return false;
+  }
 
-    if (keyring_id == mojom::kDefaultKeyringId) {
-      prefs_->SetBoolean(kBraveWalletKeyringEncryptionKeysMigrated, true);
-    }
+  auto mnemonic =
+      legacy_encryptor->Decrypt(*legacy_encrypted_mnemonic, *legacy_nonce);
+  if (!mnemonic)
+    return false;
 
-    const base::Value::List* imported_accounts_legacy =
-        GetPrefForKeyringList(*prefs_, kImportedAccounts, keyring_id);
-    if (!imported_accounts_legacy)
+  SetPrefInBytesForKeyring(prefs_, kPasswordEncryptorSalt, salt, keyring_id);
+  auto nonce = GetOrCreateNonceForKeyring(keyring_id, /*force_create = */ true);
+
+  SetPrefInBytesForKeyring(
+      prefs_, kEncryptedMnemonic,
+      encryptor->Encrypt(base::make_span(*mnemonic), nonce), keyring_id);
+
+  if (keyring_id == mojom::kDefaultKeyringId) {
+    prefs_->SetBoolean(kBraveWalletKeyringEncryptionKeysMigrated, true);
+  }
+
+  const base::Value::List* imported_accounts_legacy =
+      GetPrefForKeyringList(*prefs_, kImportedAccounts, keyring_id);
+  if (!imported_accounts_legacy)
+    return true;
+  base::Value::List imported_accounts = imported_accounts_legacy->Clone();
+  for (auto& imported_account : imported_accounts) {
+    if (!imported_account.is_dict())
       continue;
-    base::Value::List imported_accounts = imported_accounts_legacy->Clone();
-    for (auto& imported_account : imported_accounts) {
-      if (!imported_account.is_dict())
-        continue;
-
-      const std::string* legacy_encrypted_private_key =
-          imported_account.GetDict().FindString(kEncryptedPrivateKey);
-      if (!legacy_encrypted_private_key)
-        continue;
-
-      auto legacy_private_key_decoded =
-          base::Base64Decode(*legacy_encrypted_private_key);
-      if (!legacy_private_key_decoded)
-        continue;
-
-      auto private_key = legacy_encryptor->Decrypt(
-          base::make_span(*legacy_private_key_decoded), *legacy_nonce);
-      if (!private_key)
-        continue;
-
-      imported_account.GetDict().Set(
-          kEncryptedPrivateKey,
-          base::Base64Encode(encryptor->Encrypt(*private_key, nonce)));
-    }
-    SetPrefForKeyring(prefs_, kImportedAccounts,
-                      base::Value(std::move(imported_accounts)), keyring_id);
+
+    const std::string* legacy_encrypted_private_key =
+        imported_account.GetDict().FindString(kEncryptedPrivateKey);
+    if (!legacy_encrypted_private_key)
+      continue;
+
+    auto legacy_private_key_decoded =
+        base::Base64Decode(*legacy_encrypted_private_key);
+    if (!legacy_private_key_decoded)
+      continue;
+
+    auto private_key = legacy_encryptor->Decrypt(
+        base::make_span(*legacy_private_key_decoded), *legacy_nonce);
+    if (!private_key)
+      continue;
+
+    imported_account.GetDict().Set(
+        kEncryptedPrivateKey,
+        base::Base64Encode(encryptor->Encrypt(*private_key, nonce)));
   }
+  SetPrefForKeyring(prefs_, kImportedAccounts,
+                    base::Value(std::move(imported_accounts)), keyring_id);
+  return true;
 }
 
 void KeyringService::StopAutoLockTimer() {
@@ -1915,8 +2094,7 @@ std::vector<uint8_t> KeyringService::GetOrCreateSaltForKeyring(
     }
   }
 
-  std::vector<uint8_t> salt(kSaltSize);
-  crypto::RandBytes(salt);
+  auto salt = CreateSalt();
   SetPrefInBytesForKeyring(prefs_, kPasswordEncryptorSalt, salt, id);
   return salt;
 }
@@ -2255,7 +2433,7 @@ bool KeyringService::ValidatePasswordInternal(const std::string& password) {
           : kPbkdf2IterationsLegacy;
 
   // TODO(apaymyshev): move this call(and other ones in this file) to
-  // background thread.
+  // background thread, as done by Unlock.
   auto encryptor = PasswordEncryptor::DeriveKeyFromPasswordUsingPbkdf2(
       password, *salt, iterations, kPbkdf2KeySize);
 
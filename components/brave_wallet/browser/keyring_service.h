@@ -283,6 +283,9 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest,
                            GetMnemonicForDefaultKeyring);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, LockAndUnlock);
+  FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest,
+                           UnlockDerivesKeysAsynchronously);
+  FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, LockDuringUnlock);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, Reset);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, AccountMetasForKeyring);
   FRIEND_TEST_ALL_PREFIXES(KeyringServiceUnitTest, CreateAndRestoreWallet);
@@ -320,6 +323,10 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   friend class AssetDiscoveryManagerUnitTest;
   friend class SolanaTransactionUnitTest;
 
+  // Encryptor of a keyring derived from the unlock password, see
+  // DeriveUnlockKeys.
+  struct UnlockKeys;
+
   absl::optional<std::string> FindImportedFilecoinKeyringId(
       const std::string& address) const;
   absl::optional<std::string> FindBasicFilecoinKeyringId(
@@ -382,11 +389,29 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
                             const std::string& mnemonic,
                             const std::string& password,
                             bool is_legacy_brave_wallet);
-  // It's used to reconstruct same default keyring between browser relaunch
-  HDKeyring* ResumeKeyring(const std::string& keyring_id,
-                           const std::string& password);
+  // It's used to reconstruct same default keyring between browser relaunch,
+  // with the encryptor of the keyring already created.
+  HDKeyring* ResumeKeyring(const std::string& keyring_id);
+
+  // Runs on the thread pool, as PBKDF2 is slow by design. A |legacy_salt| is
+  // passed for keyrings still to be migrated from the legacy iterations count.
+  static UnlockKeys DeriveUnlockKeys(
+      const std::string& keyring_id,
+      const std::string& password,
+      std::vector<uint8_t> salt,
+      int iterations,
+      absl::optional<std::vector<uint8_t>> legacy_salt);
+  void OnUnlockKeysDerived(uint64_t unlock_generation,
+                           const std::string& password,
+                           UnlockCallback callback,
+                           std::vector<UnlockKeys> derived_keys);
 
   void MaybeMigratePBKDF2Iterations(const std::string& password);
+  // Re-encrypts the keyring with |encryptor|, derived from |salt|.
+  bool MigratePBKDF2IterationsForKeyring(const std::string& keyring_id,
+                                         PasswordEncryptor* legacy_encryptor,
+                                         const std::vector<uint8_t>& salt,
+                                         PasswordEncryptor* encryptor);
 
   void NotifyAccountsChanged();
   void NotifyAccountsAdded(mojom::CoinType coin,
@@ -421,11 +446,14 @@ class KeyringService : public KeyedService, public mojom::KeyringService {
   raw_ptr<JsonRpcService> json_rpc_service_;
   raw_ptr<PrefService> prefs_ = nullptr;
   bool request_unlock_pending_ = false;
+  // Bumped by Lock and Reset so that pending Unlock calls fail.
+  uint64_t unlock_generation_ = 0;
 
   mojo::RemoteSet<mojom::KeyringServiceObserver> observers_;
   mojo::ReceiverSet<mojom::KeyringService> receivers_;
 
   base::WeakPtrFactory<KeyringService> discovery_weak_factory_{this};
+  base::WeakPtrFactory<KeyringService> weak_ptr_factory_{this};
 
   KeyringService(const KeyringService&) = delete;
   KeyringService& operator=(const KeyringService&) = delete;
@@ -23,10 +23,13 @@ namespace brave_wallet {
 class TxMeta;
 class SolanaTxMeta;
 class JsonRpcService;
+class TxStore;
 
 class SolanaTxStateManager : public TxStateManager {
  public:
-  SolanaTxStateManager(PrefService* prefs, JsonRpcService* json_rpc_service);
+  SolanaTxStateManager(PrefService* prefs,
+                       TxStore* tx_store,
+                       JsonRpcService* json_rpc_service);
   ~SolanaTxStateManager() override;
   SolanaTxStateManager(const SolanaTxStateManager&) = delete;
   SolanaTxStateManager operator=(const SolanaTxStateManager&) = delete;
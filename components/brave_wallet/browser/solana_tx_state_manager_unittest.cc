@@ -17,6 +17,7 @@
 #include "brave/components/brave_wallet/browser/solana_instruction.h"
 #include "brave/components/brave_wallet/browser/solana_transaction.h"
 #include "brave/components/brave_wallet/browser/solana_tx_meta.h"
+#include "brave/components/brave_wallet/browser/tx_store.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "brave/components/brave_wallet/common/brave_wallet_constants.h"
 #include "brave/components/brave_wallet/common/brave_wallet_types.h"
@@ -41,8 +42,10 @@ class SolanaTxStateManagerUnitTest : public testing::Test {
     brave_wallet::RegisterProfilePrefs(prefs_.registry());
     json_rpc_service_ = std::make_unique<JsonRpcService>(
         shared_url_loader_factory_, GetPrefs());
+    tx_store_ = std::make_unique<TxStore>(GetPrefs(), base::FilePath());
     solana_tx_state_manager_ = std::make_unique<SolanaTxStateManager>(
-        GetPrefs(), json_rpc_service_.get());
+        GetPrefs(), tx_store_.get(), json_rpc_service_.get());
+    task_environment_.RunUntilIdle();
   }
 
   void SetNetwork(const std::string& chain_id) {
@@ -56,6 +59,7 @@ class SolanaTxStateManagerUnitTest : public testing::Test {
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
   sync_preferences::TestingPrefServiceSyncable prefs_;
   std::unique_ptr<JsonRpcService> json_rpc_service_;
+  std::unique_ptr<TxStore> tx_store_;
   std::unique_ptr<SolanaTxStateManager> solana_tx_state_manager_;
 };
 
@@ -0,0 +1,207 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/tx_database.h"
+
+#include <tuple>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/check.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "sql/recovery.h"
+#include "sql/statement.h"
+#include "sql/transaction.h"
+
+namespace brave_wallet {
+
+namespace {
+
+constexpr char kTableName[] = "transactions";
+
+void DatabaseErrorCallback(sql::Database* db,
+                           const base::FilePath& db_file_path,
+                           int extended_error,
+                           sql::Statement* stmt) {
+  if (!db_file_path.empty() && sql::Recovery::ShouldRecover(extended_error)) {
+    // Prevent reentrant calls.
+    db->reset_error_callback();
+
+    // After this call, the |db| handle is poisoned so that future calls will
+    // return errors until the handle is re-opened.
+    sql::Recovery::RecoverDatabase(db, db_file_path);
+
+    // The ignored call signals the test-expectation framework that the error
+    // was handled.
+    std::ignore = sql::Database::IsExpectedSqliteError(extended_error);
+    return;
+  }
+
+  // The default handling is to assert on debug and to ignore on release.
+  if (!sql::Database::IsExpectedSqliteError(extended_error))
+    DLOG(FATAL) << db->GetErrorMessage();
+}
+
+}  // namespace
+
+TxDatabase::TxDatabase(const base::FilePath& db_file_path)
+    : database_({.exclusive_locking = true, .page_size = 4096,
+                 .cache_size = 128}),
+      db_file_path_(db_file_path) {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+TxDatabase::~TxDatabase() = default;
+
+bool TxDatabase::Initialize() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  database_.set_histogram_tag("BraveWalletTransactions");
+
+  // To recover from corruption.
+  database_.set_error_callback(
+      base::BindRepeating(&DatabaseErrorCallback, &database_, db_file_path_));
+
+  const bool opened = db_file_path_.empty() ? database_.OpenInMemory()
+                                            : database_.Open(db_file_path_);
+  return opened && MaybeCreateTable();
+}
+
+absl::optional<base::Value::Dict> TxDatabase::LoadTransactions() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!database_.is_open())
+    return absl::nullopt;
+
+  sql::Statement statement(database_.GetCachedStatement(
+      SQL_FROM_HERE, "SELECT network, id, value FROM transactions"));
+
+  base::Value::Dict transactions;
+  while (statement.Step()) {
+    auto tx = base::JSONReader::Read(statement.ColumnString(2));
+    if (!tx || !tx->is_dict())
+      continue;
+
+    const std::string network = statement.ColumnString(0);
+    base::Value::Dict* network_dict = transactions.FindDict(network);
+    if (!network_dict) {
+      network_dict =
+          transactions.Set(network, base::Value::Dict())->GetIfDict();
+    }
+    network_dict->Set(statement.ColumnString(1), std::move(*tx));
+  }
+
+  if (!statement.Succeeded())
+    return absl::nullopt;
+
+  return transactions;
+}
+
+bool TxDatabase::AddOrUpdateTx(const std::string& network,
+                               const std::string& id,
+                               base::Value::Dict tx) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return InsertTx(network, id, tx, /*replace=*/true);
+}
+
+bool TxDatabase::AddTxs(base::Value::Dict transactions) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Transaction transaction(&database_);
+  if (!transaction.Begin())
+    return false;
+
+  for (const auto [network, network_value] : transactions) {
+    if (!network_value.is_dict())
+      continue;
+    for (const auto [id, tx] : network_value.GetDict()) {
+      if (tx.is_dict() &&
+          !InsertTx(network, id, tx.GetDict(), /*replace=*/false))
+        return false;
+    }
+  }
+
+  return transaction.Commit();
+}
+
+bool TxDatabase::DeleteTx(const std::string& network, const std::string& id) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement statement(database_.GetCachedStatement(
+      SQL_FROM_HERE, "DELETE FROM transactions WHERE network = ? AND id = ?"));
+  statement.BindString(0, network);
+  statement.BindString(1, id);
+  return statement.Run();
+}
+
+bool TxDatabase::DeleteTxs(const std::string& network) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  sql::Statement statement(database_.GetCachedStatement(
+      SQL_FROM_HERE, "DELETE FROM transactions WHERE network = ?"));
+  statement.BindString(0, network);
+  return statement.Run();
+}
+
+bool TxDatabase::DeleteAllTxs() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!database_.Execute("DELETE FROM transactions"))
+    return false;
+
+  std::ignore = database_.Execute("VACUUM");
+  return true;
+}
+
+bool TxDatabase::MaybeCreateTable() {
+  if (database_.DoesTableExist(kTableName))
+    return true;
+
+  // Pending transactions are looked up by network and status on every block,
+  // and the transactions of an account by network and from address.
+  sql::Transaction transaction(&database_);
+  return transaction.Begin() &&
+         database_.Execute(
+             "CREATE TABLE transactions (network TEXT NOT NULL, "
+             "id TEXT NOT NULL, status INTEGER NOT NULL, "
+             "from_address TEXT NOT NULL, value TEXT NOT NULL, "
+             "PRIMARY KEY (network, id))") &&
+         database_.Execute(
+             "CREATE INDEX transactions_network_status_index "
+             "ON transactions (network, status)") &&
+         database_.Execute(
+             "CREATE INDEX transactions_network_from_address_index "
+             "ON transactions (network, from_address)") &&
+         transaction.Commit();
+}
+
+bool TxDatabase::InsertTx(const std::string& network,
+                          const std::string& id,
+                          const base::Value::Dict& tx,
+                          bool replace) {
+  std::string value;
+  if (!base::JSONWriter::Write(tx, &value))
+    return false;
+
+  sql::Statement statement(
+      replace ? database_.GetCachedStatement(
+                    SQL_FROM_HERE,
+                    "INSERT OR REPLACE INTO transactions "
+                    "(network, id, status, from_address, value) "
+                    "VALUES (?,?,?,?,?)")
+              : database_.GetCachedStatement(
+                    SQL_FROM_HERE,
+                    "INSERT OR IGNORE INTO transactions "
+                    "(network, id, status, from_address, value) "
+                    "VALUES (?,?,?,?,?)"));
+  const std::string* from = tx.FindString("from");
+  statement.BindString(0, network);
+  statement.BindString(1, id);
+  statement.BindInt(2, tx.FindInt("status").value_or(-1));
+  statement.BindString(3, from ? *from : "");
+  statement.BindString(4, value);
+  return statement.Run();
+}
+
+}  // namespace brave_wallet
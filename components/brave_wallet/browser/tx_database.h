@@ -0,0 +1,65 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_TX_DATABASE_H_
+#define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_TX_DATABASE_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/sequence_checker.h"
+#include "base/values.h"
+#include "sql/database.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace brave_wallet {
+
+// Persists the transactions of all coins and networks in a SQLite database.
+// Must be used on a sequence that allows blocking, see TxStore.
+//
+// Transactions are keyed by network, the coin_type.network_id path such as
+// ethereum.mainnet, and by id. They are stored as serialized TxMeta values
+// next to indexed network, status and from address columns.
+class TxDatabase {
+ public:
+  // An empty |db_file_path| opens an in-memory database, for tests.
+  explicit TxDatabase(const base::FilePath& db_file_path);
+  ~TxDatabase();
+
+  TxDatabase(const TxDatabase&) = delete;
+  TxDatabase& operator=(const TxDatabase&) = delete;
+
+  bool Initialize();
+
+  // Returns the transactions keyed by network and then by id, or
+  // absl::nullopt if the database could not be read.
+  absl::optional<base::Value::Dict> LoadTransactions();
+
+  bool AddOrUpdateTx(const std::string& network,
+                     const std::string& id,
+                     base::Value::Dict tx);
+  // Adds those of |transactions|, keyed as returned by LoadTransactions, that
+  // are not in the database yet, in a single SQL transaction.
+  bool AddTxs(base::Value::Dict transactions);
+  bool DeleteTx(const std::string& network, const std::string& id);
+  bool DeleteTxs(const std::string& network);
+  bool DeleteAllTxs();
+
+ private:
+  bool MaybeCreateTable();
+  bool InsertTx(const std::string& network,
+                const std::string& id,
+                const base::Value::Dict& tx,
+                bool replace);
+
+  sql::Database database_;
+  base::FilePath db_file_path_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace brave_wallet
+
+#endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_TX_DATABASE_H_
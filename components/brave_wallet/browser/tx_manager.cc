@@ -9,6 +9,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/check.h"
 #include "base/logging.h"
 #include "brave/components/brave_wallet/browser/block_tracker.h"
@@ -35,7 +36,10 @@ TxManager::TxManager(std::unique_ptr<TxStateManager> tx_state_manager,
   DCHECK(json_rpc_service_);
   DCHECK(keyring_service_);
 
-  CheckIfBlockTrackerShouldRun();
+  // Pending transactions are only known once the transactions are loaded.
+  tx_state_manager_->RunWhenLoaded(
+      base::BindOnce(&TxManager::CheckIfBlockTrackerShouldRun,
+                     weak_factory_.GetWeakPtr()));
   tx_state_manager_->AddObserver(this);
   keyring_service_->AddObserver(
       keyring_observer_receiver_.BindNewPipeAndPassRemote());
@@ -91,6 +95,9 @@ void TxManager::RejectTransaction(const std::string& tx_meta_id,
 }
 
 void TxManager::CheckIfBlockTrackerShouldRun() {
+  if (!tx_state_manager_->IsLoaded())
+    return;
+
   bool locked = keyring_service_->IsLocked();
   bool running = block_tracker_->IsRunning();
   if (!locked && !running) {
@@ -108,25 +115,31 @@ void TxManager::OnNewUnapprovedTx(mojom::TransactionInfoPtr tx_info) {
   tx_service_->OnNewUnapprovedTx(tx_info->Clone());
 }
 
+void TxManager::UpdatePendingTransactionsWhenLoaded() {
+  tx_state_manager_->RunWhenLoaded(
+      base::BindOnce(&TxManager::UpdatePendingTransactions,
+                     weak_factory_.GetWeakPtr()));
+}
+
 void TxManager::Locked() {
   CheckIfBlockTrackerShouldRun();
 }
 
 void TxManager::Unlocked() {
   CheckIfBlockTrackerShouldRun();
-  UpdatePendingTransactions();
+  UpdatePendingTransactionsWhenLoaded();
 }
 
 void TxManager::KeyringCreated(const std::string& keyring_id) {
-  UpdatePendingTransactions();
+  UpdatePendingTransactionsWhenLoaded();
 }
 
 void TxManager::KeyringRestored(const std::string& keyring_id) {
-  UpdatePendingTransactions();
+  UpdatePendingTransactionsWhenLoaded();
 }
 
 void TxManager::KeyringReset() {
-  UpdatePendingTransactions();
+  UpdatePendingTransactionsWhenLoaded();
 }
 
 void TxManager::Reset() {
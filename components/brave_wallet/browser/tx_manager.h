@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "brave/components/brave_wallet/browser/tx_state_manager.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "mojo/public/cpp/bindings/receiver.h"
@@ -90,6 +91,9 @@ class TxManager : public TxStateManager::Observer,
   bool known_no_pending_tx_ = false;
 
  private:
+  // Updating pending transactions before they are loaded would find none.
+  void UpdatePendingTransactionsWhenLoaded();
+
   // TxStateManager::Observer
   void OnTransactionStatusChanged(mojom::TransactionInfoPtr tx_info) override;
   void OnNewUnapprovedTx(mojom::TransactionInfoPtr tx_info) override;
@@ -109,6 +113,8 @@ class TxManager : public TxStateManager::Observer,
 
   mojo::Receiver<brave_wallet::mojom::KeyringServiceObserver>
       keyring_observer_receiver_{this};
+
+  base::WeakPtrFactory<TxManager> weak_factory_{this};
 };
 
 }  // namespace brave_wallet
@@ -7,17 +7,22 @@
 
 #include <utility>
 
+#include "base/bind.h"
 #include "brave/components/brave_wallet/browser/brave_wallet_prefs.h"
 #include "brave/components/brave_wallet/browser/eth_tx_manager.h"
 #include "brave/components/brave_wallet/browser/fil_tx_manager.h"
 #include "brave/components/brave_wallet/browser/solana_tx_manager.h"
 #include "brave/components/brave_wallet/browser/tx_manager.h"
+#include "brave/components/brave_wallet/browser/tx_store.h"
 #include "url/origin.h"
 
 namespace brave_wallet {
 
 namespace {
 
+constexpr base::FilePath::CharType kTxDatabaseFileName[] =
+    FILE_PATH_LITERAL("Brave Wallet Transactions");
+
 mojom::CoinType GetCoinTypeFromTxDataUnion(
     const mojom::TxDataUnion& tx_data_union) {
   if (tx_data_union.is_solana_tx_data())
@@ -33,14 +38,23 @@ mojom::CoinType GetCoinTypeFromTxDataUnion(
 
 TxService::TxService(JsonRpcService* json_rpc_service,
                      KeyringService* keyring_service,
-                     PrefService* prefs)
-    : prefs_(prefs), weak_factory_(this) {
-  tx_manager_map_[mojom::CoinType::ETH] = std::unique_ptr<TxManager>(
-      new EthTxManager(this, json_rpc_service, keyring_service, prefs));
-  tx_manager_map_[mojom::CoinType::SOL] = std::unique_ptr<TxManager>(
-      new SolanaTxManager(this, json_rpc_service, keyring_service, prefs));
-  tx_manager_map_[mojom::CoinType::FIL] = std::unique_ptr<TxManager>(
-      new FilTxManager(this, json_rpc_service, keyring_service, prefs));
+                     PrefService* prefs,
+                     const base::FilePath& context_path)
+    : prefs_(prefs),
+      tx_store_(std::make_unique<TxStore>(
+          prefs,
+          context_path.empty() ? base::FilePath()
+                               : context_path.Append(kTxDatabaseFileName))),
+      weak_factory_(this) {
+  tx_manager_map_[mojom::CoinType::ETH] =
+      std::unique_ptr<TxManager>(new EthTxManager(
+          this, json_rpc_service, keyring_service, prefs, tx_store_.get()));
+  tx_manager_map_[mojom::CoinType::SOL] =
+      std::unique_ptr<TxManager>(new SolanaTxManager(
+          this, json_rpc_service, keyring_service, prefs, tx_store_.get()));
+  tx_manager_map_[mojom::CoinType::FIL] =
+      std::unique_ptr<TxManager>(new FilTxManager(
+          this, json_rpc_service, keyring_service, prefs, tx_store_.get()));
 }
 
 TxService::~TxService() = default;
@@ -63,51 +77,68 @@ FilTxManager* TxService::GetFilTxManager() {
   return static_cast<FilTxManager*>(GetTxManager(mojom::CoinType::FIL));
 }
 
+template <typename Interface>
+void TxService::AddReceiverWhenLoaded(
+    mojo::ReceiverSet<Interface>* receivers,
+    mojo::PendingReceiver<Interface> receiver) {
+  // |tx_store_| is owned by this, so are the callbacks it holds.
+  tx_store_->RunWhenLoaded(base::BindOnce(
+      [](TxService* tx_service, mojo::ReceiverSet<Interface>* receivers,
+         mojo::PendingReceiver<Interface> receiver) {
+        receivers->Add(tx_service, std::move(receiver));
+      },
+      base::Unretained(this), base::Unretained(receivers),
+      std::move(receiver)));
+}
+
 mojo::PendingRemote<mojom::TxService> TxService::MakeRemote() {
   mojo::PendingRemote<mojom::TxService> remote;
-  tx_service_receivers_.Add(this, remote.InitWithNewPipeAndPassReceiver());
+  AddReceiverWhenLoaded(&tx_service_receivers_,
+                        remote.InitWithNewPipeAndPassReceiver());
   return remote;
 }
 
 void TxService::Bind(mojo::PendingReceiver<mojom::TxService> receiver) {
-  tx_service_receivers_.Add(this, std::move(receiver));
+  AddReceiverWhenLoaded(&tx_service_receivers_, std::move(receiver));
 }
 
 mojo::PendingRemote<mojom::EthTxManagerProxy>
 TxService::MakeEthTxManagerProxyRemote() {
   mojo::PendingRemote<mojom::EthTxManagerProxy> remote;
-  eth_tx_manager_receivers_.Add(this, remote.InitWithNewPipeAndPassReceiver());
+  AddReceiverWhenLoaded(&eth_tx_manager_receivers_,
+                        remote.InitWithNewPipeAndPassReceiver());
   return remote;
 }
 
 void TxService::BindEthTxManagerProxy(
     mojo::PendingReceiver<mojom::EthTxManagerProxy> receiver) {
-  eth_tx_manager_receivers_.Add(this, std::move(receiver));
+  AddReceiverWhenLoaded(&eth_tx_manager_receivers_, std::move(receiver));
 }
 
 mojo::PendingRemote<mojom::SolanaTxManagerProxy>
 TxService::MakeSolanaTxManagerProxyRemote() {
   mojo::PendingRemote<mojom::SolanaTxManagerProxy> remote;
-  solana_tx_manager_receivers_.Add(this,
-                                   remote.InitWithNewPipeAndPassReceiver());
+  AddReceiverWhenLoaded(&solana_tx_manager_receivers_,
+                        remote.InitWithNewPipeAndPassReceiver());
   return remote;
 }
 
 mojo::PendingRemote<mojom::FilTxManagerProxy>
 TxService::MakeFilTxManagerProxyRemote() {
   mojo::PendingRemote<mojom::FilTxManagerProxy> remote;
-  fil_tx_manager_receivers_.Add(this, remote.InitWithNewPipeAndPassReceiver());
+  AddReceiverWhenLoaded(&fil_tx_manager_receivers_,
+                        remote.InitWithNewPipeAndPassReceiver());
   return remote;
 }
 
 void TxService::BindSolanaTxManagerProxy(
     mojo::PendingReceiver<mojom::SolanaTxManagerProxy> receiver) {
-  solana_tx_manager_receivers_.Add(this, std::move(receiver));
+  AddReceiverWhenLoaded(&solana_tx_manager_receivers_, std::move(receiver));
 }
 
 void TxService::BindFilTxManagerProxy(
     mojo::PendingReceiver<mojom::FilTxManagerProxy> receiver) {
-  fil_tx_manager_receivers_.Add(this, std::move(receiver));
+  AddReceiverWhenLoaded(&fil_tx_manager_receivers_, std::move(receiver));
 }
 
 void TxService::AddUnapprovedTransaction(
@@ -191,6 +222,7 @@ void TxService::OnUnapprovedTxUpdated(mojom::TransactionInfoPtr tx_info) {
 
 void TxService::Reset() {
   ClearTxServiceProfilePrefs(prefs_);
+  tx_store_->DeleteAllTxs();
   for (auto const& service : tx_manager_map_)
     service.second->Reset();
 }
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "components/keyed_service/core/keyed_service.h"
@@ -29,6 +30,7 @@ class TxManager;
 class EthTxManager;
 class SolanaTxManager;
 class FilTxManager;
+class TxStore;
 
 class TxService : public KeyedService,
                   public mojom::TxService,
@@ -36,9 +38,12 @@ class TxService : public KeyedService,
                   public mojom::SolanaTxManagerProxy,
                   public mojom::FilTxManagerProxy {
  public:
+  // Transactions are stored under |context_path|, or in memory if it is
+  // empty.
   TxService(JsonRpcService* json_rpc_service,
             KeyringService* keyring_service,
-            PrefService* prefs);
+            PrefService* prefs,
+            const base::FilePath& context_path);
   ~TxService() override;
   TxService(const TxService&) = delete;
   TxService operator=(const TxService&) = delete;
@@ -189,12 +194,19 @@ class TxService : public KeyedService,
   friend class SolanaTxManagerUnitTest;
   friend class FilTxManagerUnitTest;
 
+  // Requests are only dispatched to |receiver| once the transactions are
+  // loaded, until then they wait in the pipe.
+  template <typename Interface>
+  void AddReceiverWhenLoaded(mojo::ReceiverSet<Interface>* receivers,
+                             mojo::PendingReceiver<Interface> receiver);
+
   TxManager* GetTxManager(mojom::CoinType coin_type);
   EthTxManager* GetEthTxManager();
   SolanaTxManager* GetSolanaTxManager();
   FilTxManager* GetFilTxManager();
 
   raw_ptr<PrefService> prefs_;  // NOT OWNED
+  std::unique_ptr<TxStore> tx_store_;
   base::flat_map<mojom::CoinType, std::unique_ptr<TxManager>> tx_manager_map_;
   mojo::RemoteSet<mojom::TxServiceObserver> observers_;
   mojo::ReceiverSet<mojom::TxService> tx_service_receivers_;
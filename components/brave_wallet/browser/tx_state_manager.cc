@@ -7,12 +7,11 @@
 
 #include <utility>
 
+#include "base/bind.h"
 #include "base/json/values_util.h"
 #include "base/values.h"
-#include "brave/components/brave_wallet/browser/pref_names.h"
 #include "brave/components/brave_wallet/browser/tx_meta.h"
-#include "components/prefs/pref_service.h"
-#include "components/prefs/scoped_user_pref_update.h"
+#include "brave/components/brave_wallet/browser/tx_store.h"
 #include "url/origin.h"
 
 namespace brave_wallet {
@@ -89,28 +88,35 @@ bool TxStateManager::ValueToTxMeta(const base::Value::Dict& value,
 }
 
 TxStateManager::TxStateManager(PrefService* prefs,
+                               TxStore* tx_store,
                                JsonRpcService* json_rpc_service)
-    : prefs_(prefs), json_rpc_service_(json_rpc_service), weak_factory_(this) {
+    : prefs_(prefs),
+      tx_store_(tx_store),
+      json_rpc_service_(json_rpc_service),
+      weak_factory_(this) {
+  DCHECK(tx_store_);
   DCHECK(json_rpc_service_);
 }
 
 TxStateManager::~TxStateManager() = default;
 
 void TxStateManager::AddOrUpdateTx(const TxMeta& meta) {
-  DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
-  base::Value::Dict& dict = update.Get()->GetDict();
-  const std::string path = GetTxPrefPathPrefix() + "." + meta.id();
+  tx_store_->AddOrUpdateTx(
+      GetTxPrefPathPrefix(), meta.id(), meta.ToValue(),
+      base::BindOnce(&TxStateManager::OnTxAddedOrUpdated,
+                     weak_factory_.GetWeakPtr(), meta.ToTransactionInfo()));
+}
 
-  bool is_add = dict.FindByDottedPath(path) == nullptr;
-  dict.SetByDottedPath(path, meta.ToValue());
+void TxStateManager::OnTxAddedOrUpdated(mojom::TransactionInfoPtr tx_info,
+                                        bool is_add) {
   if (!is_add) {
     for (auto& observer : observers_)
-      observer.OnTransactionStatusChanged(meta.ToTransactionInfo());
+      observer.OnTransactionStatusChanged(tx_info->Clone());
     return;
   }
 
   for (auto& observer : observers_)
-    observer.OnNewUnapprovedTx(meta.ToTransactionInfo());
+    observer.OnNewUnapprovedTx(tx_info->Clone());
 
   // We only keep most recent 10 confirmed and rejected tx metas per network
   RetireTxByStatus(mojom::TransactionStatus::Confirmed, kMaxConfirmedTxNum);
@@ -118,47 +124,41 @@ void TxStateManager::AddOrUpdateTx(const TxMeta& meta) {
 }
 
 std::unique_ptr<TxMeta> TxStateManager::GetTx(const std::string& id) {
-  const auto& dict = prefs_->GetDict(kBraveWalletTransactions);
-  const base::Value::Dict* value =
-      dict.FindDictByDottedPath(GetTxPrefPathPrefix() + "." + id);
+  const base::Value::Dict* value = tx_store_->GetTx(GetTxPrefPathPrefix(), id);
   if (!value)
     return nullptr;
 
   return ValueToTxMeta(*value);
 }
 
+bool TxStateManager::IsLoaded() const {
+  return tx_store_->is_loaded();
+}
+
+void TxStateManager::RunWhenLoaded(base::OnceClosure callback) {
+  tx_store_->RunWhenLoaded(std::move(callback));
+}
+
 void TxStateManager::DeleteTx(const std::string& id) {
-  DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
-  base::Value* dict = update.Get();
-  dict->GetDict().RemoveByDottedPath(GetTxPrefPathPrefix() + "." + id);
+  tx_store_->DeleteTx(GetTxPrefPathPrefix(), id);
 }
 
 void TxStateManager::WipeTxs() {
-  DictionaryPrefUpdate update(prefs_, kBraveWalletTransactions);
-  base::Value* dict = update.Get();
-  dict->GetDict().RemoveByDottedPath(GetTxPrefPathPrefix());
+  tx_store_->DeleteTxs(GetTxPrefPathPrefix());
 }
 
 std::vector<std::unique_ptr<TxMeta>> TxStateManager::GetTransactionsByStatus(
     absl::optional<mojom::TransactionStatus> status,
     absl::optional<std::string> from) {
   std::vector<std::unique_ptr<TxMeta>> result;
-  const auto& dict = prefs_->GetDict(kBraveWalletTransactions);
-  const base::Value::Dict* network_dict =
-      dict.FindDictByDottedPath(GetTxPrefPathPrefix());
-  if (!network_dict)
-    return result;
-
-  for (const auto it : *network_dict) {
-    std::unique_ptr<TxMeta> meta = ValueToTxMeta(it.second.GetDict());
+  // Only the transactions matching |status| and |from| are deserialized.
+  for (const base::Value::Dict* value :
+       tx_store_->GetTxs(GetTxPrefPathPrefix(), status, from)) {
+    std::unique_ptr<TxMeta> meta = ValueToTxMeta(*value);
     if (!meta) {
       continue;
     }
-    if (!status.has_value() || meta->status() == *status) {
-      if (from.has_value() && meta->from() != *from)
-        continue;
-      result.push_back(std::move(meta));
-    }
+    result.push_back(std::move(meta));
   }
   return result;
 }
@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -27,11 +28,14 @@ class Value;
 namespace brave_wallet {
 
 class TxMeta;
+class TxStore;
 class JsonRpcService;
 
 class TxStateManager {
  public:
-  TxStateManager(PrefService* prefs, JsonRpcService* json_rpc_service);
+  TxStateManager(PrefService* prefs,
+                 TxStore* tx_store,
+                 JsonRpcService* json_rpc_service);
   virtual ~TxStateManager();
   TxStateManager(const TxStateManager&) = delete;
 
@@ -44,6 +48,11 @@ class TxStateManager {
       absl::optional<mojom::TransactionStatus> status,
       absl::optional<std::string> from);
 
+  // Transactions of previous sessions are loaded asynchronously and reads do
+  // not return them until then, see TxStore.
+  bool IsLoaded() const;
+  void RunWhenLoaded(base::OnceClosure callback);
+
   class Observer : public base::CheckedObserver {
    public:
     virtual void OnTransactionStatusChanged(mojom::TransactionInfoPtr tx_info) {
@@ -59,10 +68,12 @@ class TxStateManager {
   static bool ValueToTxMeta(const base::Value::Dict& value, TxMeta* tx_meta);
 
   raw_ptr<PrefService> prefs_ = nullptr;
+  raw_ptr<TxStore> tx_store_ = nullptr;
   raw_ptr<JsonRpcService> json_rpc_service_ = nullptr;
 
  private:
   FRIEND_TEST_ALL_PREFIXES(TxStateManagerUnitTest, TxOperations);
+  void OnTxAddedOrUpdated(mojom::TransactionInfoPtr tx_info, bool is_add);
   void RetireTxByStatus(mojom::TransactionStatus status, size_t max_num);
 
   // Each derived class should implement its own ValueToTxMeta to create a
@@ -73,8 +84,8 @@ class TxStateManager {
 
   // Each derived class should provide transaction pref path prefix as
   // coin_type.network_id. For example, ethereum.mainnet or solana.testnet.
-  // This will be used to get/set the transaction pref for a specific
-  // coin_type.
+  // This will be used as the network of transactions in TxStore for a
+  // specific coin_type.
   virtual std::string GetTxPrefPathPrefix() = 0;
 
   base::ObserverList<Observer> observers_;
@@ -7,6 +7,7 @@
 
 #include "brave/components/brave_wallet/browser/tx_state_manager.h"
 
+#include "base/files/scoped_temp_dir.h"
 #include "base/run_loop.h"
 #include "base/test/bind.h"
 #include "base/test/task_environment.h"
@@ -17,7 +18,7 @@
 #include "brave/components/brave_wallet/browser/eth_tx_meta.h"
 #include "brave/components/brave_wallet/browser/eth_tx_state_manager.h"
 #include "brave/components/brave_wallet/browser/json_rpc_service.h"
-#include "brave/components/brave_wallet/browser/pref_names.h"
+#include "brave/components/brave_wallet/browser/tx_store.h"
 #include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
 #include "components/prefs/pref_service.h"
 #include "components/sync_preferences/testing_pref_service_syncable.h"
@@ -87,8 +88,14 @@ class TxStateManagerUnitTest : public testing::Test {
     // The only different between each coin type's tx state manager in these
     // base functions are their pref paths, so here we just use
     // EthTxStateManager to test common methods in TxStateManager.
-    tx_state_manager_ =
-        std::make_unique<EthTxStateManager>(&prefs_, json_rpc_service_.get());
+    tx_store_ = std::make_unique<TxStore>(&prefs_, base::FilePath());
+    tx_state_manager_ = std::make_unique<EthTxStateManager>(
+        &prefs_, tx_store_.get(), json_rpc_service_.get());
+    task_environment_.RunUntilIdle();
+  }
+
+  size_t GetTxCount(const std::string& network) {
+    return tx_store_->GetTxs(network, absl::nullopt, absl::nullopt).size();
   }
 
   void SetNetwork(const std::string& chain_id, mojom::CoinType coin) {
@@ -104,28 +111,20 @@ class TxStateManagerUnitTest : public testing::Test {
   scoped_refptr<network::SharedURLLoaderFactory> shared_url_loader_factory_;
   sync_preferences::TestingPrefServiceSyncable prefs_;
   std::unique_ptr<JsonRpcService> json_rpc_service_;
+  std::unique_ptr<TxStore> tx_store_;
   std::unique_ptr<TxStateManager> tx_state_manager_;
 };
 
 TEST_F(TxStateManagerUnitTest, TxOperations) {
-  prefs_.ClearPref(kBraveWalletTransactions);
-
   EthTxMeta meta;
   meta.set_id("001");
-  EXPECT_FALSE(prefs_.HasPrefPath(kBraveWalletTransactions));
+  EXPECT_EQ(GetTxCount("ethereum.mainnet"), 0u);
   // Add
   tx_state_manager_->AddOrUpdateTx(meta);
-  EXPECT_TRUE(prefs_.HasPrefPath(kBraveWalletTransactions));
   {
-    const auto& dict = prefs_.GetDict(kBraveWalletTransactions);
-    EXPECT_EQ(dict.size(), 1u);
-    const auto* ethereum_dict = dict.FindDict("ethereum");
-    ASSERT_TRUE(ethereum_dict);
-    EXPECT_EQ(ethereum_dict->size(), 1u);
-    const auto* network_dict = ethereum_dict->FindDict("mainnet");
-    ASSERT_TRUE(network_dict);
-    EXPECT_EQ(network_dict->size(), 1u);
-    const base::Value::Dict* value = network_dict->FindDict("001");
+    EXPECT_EQ(GetTxCount("ethereum.mainnet"), 1u);
+    const base::Value::Dict* value =
+        tx_store_->GetTx("ethereum.mainnet", "001");
     ASSERT_TRUE(value);
     auto meta_from_value = tx_state_manager_->ValueToTxMeta(*value);
     ASSERT_NE(meta_from_value, nullptr);
@@ -136,15 +135,9 @@ TEST_F(TxStateManagerUnitTest, TxOperations) {
   // Update
   tx_state_manager_->AddOrUpdateTx(meta);
   {
-    const auto& dict = prefs_.GetDict(kBraveWalletTransactions);
-    EXPECT_EQ(dict.size(), 1u);
-    const auto* ethereum_dict = dict.FindDict("ethereum");
-    ASSERT_TRUE(ethereum_dict);
-    EXPECT_EQ(ethereum_dict->size(), 1u);
-    const auto* network_dict = ethereum_dict->FindDict("mainnet");
-    ASSERT_TRUE(network_dict);
-    EXPECT_EQ(network_dict->size(), 1u);
-    const base::Value::Dict* value = network_dict->FindDict("001");
+    EXPECT_EQ(GetTxCount("ethereum.mainnet"), 1u);
+    const base::Value::Dict* value =
+        tx_store_->GetTx("ethereum.mainnet", "001");
     ASSERT_TRUE(value);
     auto meta_from_value = tx_state_manager_->ValueToTxMeta(*value);
     ASSERT_NE(meta_from_value, nullptr);
@@ -155,16 +148,7 @@ TEST_F(TxStateManagerUnitTest, TxOperations) {
   meta.set_tx_hash("0xabff");
   // Add another one
   tx_state_manager_->AddOrUpdateTx(meta);
-  {
-    const auto& dict = prefs_.GetDict(kBraveWalletTransactions);
-    EXPECT_EQ(dict.size(), 1u);
-    const auto* ethereum_dict = dict.FindDict("ethereum");
-    ASSERT_TRUE(ethereum_dict);
-    EXPECT_EQ(ethereum_dict->size(), 1u);
-    const auto* network_dict = ethereum_dict->FindDict("mainnet");
-    ASSERT_TRUE(network_dict);
-    EXPECT_EQ(network_dict->size(), 2u);
-  }
+  EXPECT_EQ(GetTxCount("ethereum.mainnet"), 2u);
 
   // Get
   {
@@ -185,27 +169,15 @@ TEST_F(TxStateManagerUnitTest, TxOperations) {
 
   // Delete
   tx_state_manager_->DeleteTx("001");
-  {
-    const auto& dict = prefs_.GetDict(kBraveWalletTransactions);
-    EXPECT_EQ(dict.size(), 1u);
-    const auto* ethereum_dict = dict.FindDict("ethereum");
-    ASSERT_TRUE(ethereum_dict);
-    EXPECT_EQ(ethereum_dict->size(), 1u);
-    const auto* network_dict = ethereum_dict->FindDict("mainnet");
-    ASSERT_TRUE(network_dict);
-    EXPECT_EQ(network_dict->size(), 1u);
-  }
+  EXPECT_EQ(GetTxCount("ethereum.mainnet"), 1u);
+  EXPECT_FALSE(tx_state_manager_->GetTx("001"));
 
   // Purge
   tx_state_manager_->WipeTxs();
-  EXPECT_TRUE(prefs_.HasPrefPath(kBraveWalletTransactions));
-  EXPECT_FALSE(
-      prefs_.HasPrefPath(std::string(kBraveWalletTransactions) + ".ethereum"));
+  EXPECT_EQ(GetTxCount("ethereum.mainnet"), 0u);
 }
 
 TEST_F(TxStateManagerUnitTest, GetTransactionsByStatus) {
-  prefs_.ClearPref(kBraveWalletTransactions);
-
   std::string addr1 = "0x3535353535353535353535353535353535353535";
   std::string addr2 = "0x2f015c60e0be116b1f0cd534704db9c92118fb6a";
 
@@ -278,8 +250,6 @@ TEST_F(TxStateManagerUnitTest, GetTransactionsByStatus) {
 }
 
 TEST_F(TxStateManagerUnitTest, SwitchNetwork) {
-  prefs_.ClearPref(kBraveWalletTransactions);
-
   EthTxMeta meta;
   meta.set_id("001");
   tx_state_manager_->AddOrUpdateTx(meta);
@@ -296,32 +266,20 @@ TEST_F(TxStateManagerUnitTest, SwitchNetwork) {
   EXPECT_EQ(tx_state_manager_->GetTx("001"), nullptr);
   tx_state_manager_->AddOrUpdateTx(meta);
 
-  const auto& dict = prefs_.GetDict(kBraveWalletTransactions);
-  EXPECT_EQ(dict.size(), 1u);
-  const auto* ethereum_dict = dict.FindDict("ethereum");
-  ASSERT_TRUE(ethereum_dict);
-  EXPECT_EQ(ethereum_dict->size(), 3u);
-  const auto* mainnet_dict = ethereum_dict->FindDict("mainnet");
-  ASSERT_TRUE(mainnet_dict);
-  EXPECT_EQ(mainnet_dict->size(), 1u);
-  EXPECT_TRUE(mainnet_dict->FindDict("001"));
-  const auto* goerli_dict = ethereum_dict->FindDict("goerli");
-  ASSERT_TRUE(goerli_dict);
-  EXPECT_EQ(goerli_dict->size(), 1u);
-  EXPECT_TRUE(goerli_dict->FindDict("001"));
+  EXPECT_EQ(GetTxCount("ethereum.mainnet"), 1u);
+  EXPECT_TRUE(tx_store_->GetTx("ethereum.mainnet", "001"));
+  EXPECT_EQ(GetTxCount("ethereum.goerli"), 1u);
+  EXPECT_TRUE(tx_store_->GetTx("ethereum.goerli", "001"));
   auto localhost_url_spec =
       brave_wallet::GetNetworkURL(&prefs_, mojom::kLocalhostChainId,
                                   mojom::CoinType::ETH)
           .spec();
-  const auto* localhost_dict = ethereum_dict->FindDict(localhost_url_spec);
-  ASSERT_TRUE(localhost_dict);
-  EXPECT_EQ(localhost_dict->size(), 1u);
-  EXPECT_TRUE(localhost_dict->FindDict("001"));
+  const std::string localhost_network = "ethereum." + localhost_url_spec;
+  EXPECT_EQ(GetTxCount(localhost_network), 1u);
+  EXPECT_TRUE(tx_store_->GetTx(localhost_network, "001"));
 }
 
 TEST_F(TxStateManagerUnitTest, RetireOldTxMeta) {
-  prefs_.ClearPref(kBraveWalletTransactions);
-
   for (size_t i = 0; i < 20; ++i) {
     EthTxMeta meta;
     meta.set_id(base::NumberToString(i));
@@ -384,4 +342,52 @@ TEST_F(TxStateManagerUnitTest, Observer) {
   observer.Reset();
 }
 
+TEST_F(TxStateManagerUnitTest, UpdateBeforeLoad) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const auto db_file_path = temp_dir.GetPath().AppendASCII("transactions");
+
+  EthTxMeta meta;
+  meta.set_id("001");
+  {
+    TxStore tx_store(&prefs_, db_file_path);
+    EthTxStateManager tx_state_manager(&prefs_, &tx_store,
+                                       json_rpc_service_.get());
+    tx_state_manager.AddOrUpdateTx(meta);
+    task_environment_.RunUntilIdle();
+  }
+  // Let the database close.
+  task_environment_.RunUntilIdle();
+
+  TxStore tx_store(&prefs_, db_file_path);
+  EthTxStateManager tx_state_manager(&prefs_, &tx_store,
+                                     json_rpc_service_.get());
+  TestTxStateManagerObserver observer;
+  tx_state_manager.AddObserver(&observer);
+  bool loaded = false;
+  tx_state_manager.RunWhenLoaded(
+      base::BindLambdaForTesting([&]() { loaded = true; }));
+
+  ASSERT_FALSE(tx_state_manager.IsLoaded());
+  EXPECT_TRUE(
+      tx_state_manager.GetTransactionsByStatus(absl::nullopt, absl::nullopt)
+          .empty());
+
+  // The transaction is not known before the load, yet updating it must not
+  // report it as a new one.
+  meta.set_status(mojom::TransactionStatus::Approved);
+  tx_state_manager.AddOrUpdateTx(meta);
+  observer.ExpectMatch("001", mojom::TransactionStatus::Approved);
+  EXPECT_FALSE(observer.NewUnapprovedTxFired());
+  EXPECT_TRUE(observer.TxStatusChangedFired());
+
+  EXPECT_TRUE(loaded);
+  EXPECT_TRUE(tx_state_manager.IsLoaded());
+  auto txs =
+      tx_state_manager.GetTransactionsByStatus(absl::nullopt, absl::nullopt);
+  ASSERT_EQ(1u, txs.size());
+  EXPECT_EQ(mojom::TransactionStatus::Approved, txs[0]->status());
+  tx_state_manager.RemoveObserver(&observer);
+}
+
 }  // namespace brave_wallet
@@ -0,0 +1,258 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/tx_store.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/strings/strcat.h"
+#include "base/task/thread_pool.h"
+#include "brave/components/brave_wallet/browser/pref_names.h"
+#include "components/prefs/pref_service.h"
+
+namespace brave_wallet {
+
+namespace {
+
+absl::optional<mojom::TransactionStatus> GetTxStatus(
+    const base::Value::Dict& tx) {
+  absl::optional<int> status = tx.FindInt("status");
+  if (!status)
+    return absl::nullopt;
+  return static_cast<mojom::TransactionStatus>(*status);
+}
+
+}  // namespace
+
+TxStore::NetworkTxs::NetworkTxs() = default;
+TxStore::NetworkTxs::~NetworkTxs() = default;
+TxStore::NetworkTxs::NetworkTxs(NetworkTxs&&) = default;
+TxStore::NetworkTxs& TxStore::NetworkTxs::operator=(NetworkTxs&&) = default;
+
+TxStore::TxStore(PrefService* prefs, const base::FilePath& db_file_path)
+    : prefs_(prefs),
+      // Block shutdown so that transactions, and with them the nonces in use,
+      // are not lost.
+      database_(base::ThreadPool::CreateSequencedTaskRunner(
+                    {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+                     base::TaskShutdownBehavior::BLOCK_SHUTDOWN}),
+                db_file_path) {
+  DCHECK(prefs_);
+  database_.AsyncCall(&TxDatabase::Initialize);
+  MigrateTransactionsPref();
+  database_.AsyncCall(&TxDatabase::LoadTransactions)
+      .Then(base::BindOnce(&TxStore::OnTransactionsLoaded,
+                           weak_ptr_factory_.GetWeakPtr()));
+}
+
+TxStore::~TxStore() = default;
+
+void TxStore::RunWhenLoaded(base::OnceClosure callback) {
+  if (is_loaded_) {
+    std::move(callback).Run();
+    return;
+  }
+
+  loaded_callbacks_.push_back(std::move(callback));
+}
+
+const base::Value::Dict* TxStore::GetTx(const std::string& network,
+                                        const std::string& id) const {
+  auto network_iter = networks_.find(network);
+  if (network_iter == networks_.end())
+    return nullptr;
+
+  auto iter = network_iter->second.txs.find(id);
+  if (iter == network_iter->second.txs.end())
+    return nullptr;
+
+  return &iter->second;
+}
+
+std::vector<const base::Value::Dict*> TxStore::GetTxs(
+    const std::string& network,
+    absl::optional<mojom::TransactionStatus> status,
+    const absl::optional<std::string>& from) const {
+  std::vector<const base::Value::Dict*> result;
+  auto network_iter = networks_.find(network);
+  if (network_iter == networks_.end())
+    return result;
+
+  const NetworkTxs& network_txs = network_iter->second;
+  auto add_if_from_matches = [&](const base::Value::Dict& tx) {
+    const std::string* tx_from = tx.FindString("from");
+    if (!from || (tx_from && *tx_from == *from))
+      result.push_back(&tx);
+  };
+
+  if (!status) {
+    for (const auto& [id, tx] : network_txs.txs)
+      add_if_from_matches(tx);
+    return result;
+  }
+
+  auto status_iter = network_txs.ids_by_status.find(*status);
+  if (status_iter == network_txs.ids_by_status.end())
+    return result;
+
+  for (const auto& id : status_iter->second)
+    add_if_from_matches(network_txs.txs.at(id));
+  return result;
+}
+
+void TxStore::AddOrUpdateTx(const std::string& network,
+                            const std::string& id,
+                            base::Value::Dict tx,
+                            base::OnceCallback<void(bool)> callback) {
+  database_.AsyncCall(&TxDatabase::AddOrUpdateTx)
+      .WithArgs(network, id, tx.Clone());
+  if (!is_loaded_) {
+    // The transaction may be one of those being loaded, so whether it is
+    // added is only known when the change is replayed.
+    changes_before_load_.push_back(base::BindOnce(
+        &TxStore::AddOrUpdateTxInMemory, base::Unretained(this), network, id,
+        tx.Clone())
+        .Then(std::move(callback)));
+    AddOrUpdateTxInMemory(network, id, std::move(tx));
+    return;
+  }
+
+  std::move(callback).Run(AddOrUpdateTxInMemory(network, id, std::move(tx)));
+}
+
+void TxStore::DeleteTx(const std::string& network, const std::string& id) {
+  database_.AsyncCall(&TxDatabase::DeleteTx).WithArgs(network, id);
+  if (!is_loaded_) {
+    changes_before_load_.push_back(base::BindOnce(
+        &TxStore::DeleteTxInMemory, base::Unretained(this), network, id));
+  }
+
+  DeleteTxInMemory(network, id);
+}
+
+void TxStore::DeleteTxs(const std::string& network) {
+  database_.AsyncCall(&TxDatabase::DeleteTxs).WithArgs(network);
+  if (!is_loaded_) {
+    changes_before_load_.push_back(base::BindOnce(
+        [](TxStore* tx_store, const std::string& network) {
+          tx_store->networks_.erase(network);
+        },
+        base::Unretained(this), network));
+  }
+
+  networks_.erase(network);
+}
+
+void TxStore::DeleteAllTxs() {
+  database_.AsyncCall(&TxDatabase::DeleteAllTxs);
+  if (!is_loaded_) {
+    changes_before_load_.push_back(base::BindOnce(
+        [](TxStore* tx_store) { tx_store->networks_.clear(); },
+        base::Unretained(this)));
+  }
+
+  networks_.clear();
+}
+
+bool TxStore::AddOrUpdateTxInMemory(const std::string& network,
+                                    const std::string& id,
+                                    base::Value::Dict tx) {
+  NetworkTxs& network_txs = networks_[network];
+  auto iter = network_txs.txs.find(id);
+  const bool is_add = iter == network_txs.txs.end();
+  if (!is_add)
+    DeleteTxInMemory(network, id);
+
+  if (auto status = GetTxStatus(tx))
+    network_txs.ids_by_status[*status].insert(id);
+  network_txs.txs.insert_or_assign(id, std::move(tx));
+  return is_add;
+}
+
+void TxStore::DeleteTxInMemory(const std::string& network,
+                               const std::string& id) {
+  auto network_iter = networks_.find(network);
+  if (network_iter == networks_.end())
+    return;
+
+  NetworkTxs& network_txs = network_iter->second;
+  auto iter = network_txs.txs.find(id);
+  if (iter == network_txs.txs.end())
+    return;
+
+  if (auto status = GetTxStatus(iter->second)) {
+    auto status_iter = network_txs.ids_by_status.find(*status);
+    if (status_iter != network_txs.ids_by_status.end()) {
+      status_iter->second.erase(id);
+      if (status_iter->second.empty())
+        network_txs.ids_by_status.erase(status_iter);
+    }
+  }
+  network_txs.txs.erase(iter);
+}
+
+void TxStore::SetTxsInMemory(base::Value::Dict transactions) {
+  networks_.clear();
+  for (auto [network, network_value] : transactions) {
+    if (!network_value.is_dict())
+      continue;
+    for (auto [id, tx] : network_value.GetDict()) {
+      if (tx.is_dict())
+        AddOrUpdateTxInMemory(network, id, std::move(tx.GetDict()));
+    }
+  }
+}
+
+void TxStore::MigrateTransactionsPref() {
+  const auto& pref = prefs_->GetDict(kBraveWalletTransactions);
+  if (pref.empty())
+    return;
+
+  // The pref keys transactions by coin type, network id and then id.
+  base::Value::Dict transactions;
+  for (const auto [coin, coin_value] : pref) {
+    if (!coin_value.is_dict())
+      continue;
+    for (const auto [network_id, network_value] : coin_value.GetDict()) {
+      if (network_value.is_dict()) {
+        transactions.Set(base::StrCat({coin, ".", network_id}),
+                         network_value.Clone());
+      }
+    }
+  }
+
+  // Keep serving the migrated transactions if the database cannot be read.
+  SetTxsInMemory(transactions.Clone());
+  migrated_transactions_ = transactions.Clone();
+  database_.AsyncCall(&TxDatabase::AddTxs)
+      .WithArgs(std::move(transactions))
+      .Then(base::BindOnce(&TxStore::OnTransactionsPrefMigrated,
+                           weak_ptr_factory_.GetWeakPtr()));
+}
+
+void TxStore::OnTransactionsPrefMigrated(bool success) {
+  // Transactions already in the database are not overwritten, so a migration
+  // that is not recorded here is safely retried by the next session.
+  if (success)
+    prefs_->ClearPref(kBraveWalletTransactions);
+}
+
+void TxStore::OnTransactionsLoaded(
+    absl::optional<base::Value::Dict> transactions) {
+  // Replaying the changes also tells their callbacks whether transactions
+  // were added, so it happens even if the database could not be read.
+  SetTxsInMemory(transactions ? std::move(*transactions)
+                              : std::move(migrated_transactions_));
+  migrated_transactions_.clear();
+  is_loaded_ = true;
+
+  for (auto& change : std::exchange(changes_before_load_, {}))
+    std::move(change).Run();
+  for (auto& callback : std::exchange(loaded_callbacks_, {}))
+    std::move(callback).Run();
+}
+
+}  // namespace brave_wallet
@@ -0,0 +1,112 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_TX_STORE_H_
+#define BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_TX_STORE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
+#include "base/files/file_path.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/sequence_bound.h"
+#include "base/values.h"
+#include "brave/components/brave_wallet/browser/tx_database.h"
+#include "brave/components/brave_wallet/common/brave_wallet.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+class PrefService;
+
+namespace brave_wallet {
+
+// Holds the transactions of all coins and networks in memory, indexed by
+// status, and persists them to a TxDatabase on a background sequence. Reads
+// never touch the disk and a write only rewrites the changed transaction.
+//
+// Networks are coin_type.network_id paths such as ethereum.mainnet. The
+// transactions formerly kept in the kBraveWalletTransactions pref are
+// migrated to the database on first use.
+class TxStore {
+ public:
+  // An empty |db_file_path| keeps the database in memory, for tests.
+  TxStore(PrefService* prefs, const base::FilePath& db_file_path);
+  ~TxStore();
+
+  TxStore(const TxStore&) = delete;
+  TxStore& operator=(const TxStore&) = delete;
+
+  const base::Value::Dict* GetTx(const std::string& network,
+                                 const std::string& id) const;
+  // Returns the transactions of |network| matching |status| and |from|, if
+  // set, in order of id.
+  std::vector<const base::Value::Dict*> GetTxs(
+      const std::string& network,
+      absl::optional<mojom::TransactionStatus> status,
+      const absl::optional<std::string>& from) const;
+
+  // |callback| is passed true if the transaction was added rather than
+  // updated. Before the transactions are loaded that is not known yet, so
+  // |callback| runs once they are.
+  void AddOrUpdateTx(const std::string& network,
+                     const std::string& id,
+                     base::Value::Dict tx,
+                     base::OnceCallback<void(bool)> callback);
+  void DeleteTx(const std::string& network, const std::string& id);
+  void DeleteTxs(const std::string& network);
+  void DeleteAllTxs();
+
+  // Transactions persisted by previous sessions are only returned once
+  // loaded, which happens shortly after construction. Reads that must see
+  // them wait for |RunWhenLoaded|.
+  bool is_loaded() const { return is_loaded_; }
+  // Runs |callback| right away if the transactions are loaded, otherwise once
+  // they are.
+  void RunWhenLoaded(base::OnceClosure callback);
+
+ private:
+  struct NetworkTxs {
+    NetworkTxs();
+    ~NetworkTxs();
+    NetworkTxs(NetworkTxs&&);
+    NetworkTxs& operator=(NetworkTxs&&);
+
+    base::flat_map<std::string, base::Value::Dict> txs;
+    base::flat_map<mojom::TransactionStatus, base::flat_set<std::string>>
+        ids_by_status;
+  };
+
+  bool AddOrUpdateTxInMemory(const std::string& network,
+                             const std::string& id,
+                             base::Value::Dict tx);
+  void DeleteTxInMemory(const std::string& network, const std::string& id);
+  // Replaces the transactions in memory with |transactions|, keyed by network
+  // and then by id.
+  void SetTxsInMemory(base::Value::Dict transactions);
+
+  void MigrateTransactionsPref();
+  void OnTransactionsPrefMigrated(bool success);
+  void OnTransactionsLoaded(absl::optional<base::Value::Dict> transactions);
+
+  raw_ptr<PrefService> prefs_ = nullptr;
+  base::SequenceBound<TxDatabase> database_;
+  base::flat_map<std::string, NetworkTxs> networks_;
+
+  bool is_loaded_ = false;
+  // What is in memory if the database cannot be loaded.
+  base::Value::Dict migrated_transactions_;
+  // Changes made before the transactions were loaded, replayed on top of them.
+  std::vector<base::OnceClosure> changes_before_load_;
+  std::vector<base::OnceClosure> loaded_callbacks_;
+
+  base::WeakPtrFactory<TxStore> weak_ptr_factory_{this};
+};
+
+}  // namespace brave_wallet
+
+#endif  // BRAVE_COMPONENTS_BRAVE_WALLET_BROWSER_TX_STORE_H_
@@ -0,0 +1,350 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_wallet/browser/tx_store.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/callback_helpers.h"
+#include "base/check.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/values.h"
+#include "brave/components/brave_wallet/browser/pref_names.h"
+#include "components/prefs/scoped_user_pref_update.h"
+#include "components/prefs/testing_pref_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_wallet {
+
+namespace {
+
+constexpr char kMainnet[] = "ethereum.mainnet";
+constexpr char kGoerli[] = "ethereum.goerli";
+constexpr char kFrom1[] = "0x3535353535353535353535353535353535353535";
+constexpr char kFrom2[] = "0x2f015c60e0be116b1f0cd534704db9c92118fb6a";
+
+base::Value::Dict MakeTx(const std::string& id,
+                         mojom::TransactionStatus status,
+                         const std::string& from) {
+  base::Value::Dict tx;
+  tx.Set("id", id);
+  tx.Set("status", static_cast<int>(status));
+  tx.Set("from", from);
+  return tx;
+}
+
+std::vector<std::string> GetIds(
+    const std::vector<const base::Value::Dict*>& txs) {
+  std::vector<std::string> ids;
+  for (const auto* tx : txs)
+    ids.push_back(*tx->FindString("id"));
+  return ids;
+}
+
+}  // namespace
+
+class TxStoreUnitTest : public testing::Test {
+ public:
+  TxStoreUnitTest() = default;
+
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    prefs_.registry()->RegisterDictionaryPref(kBraveWalletTransactions);
+  }
+
+  std::unique_ptr<TxStore> CreateTxStore() {
+    return std::make_unique<TxStore>(
+        &prefs_, temp_dir_.GetPath().AppendASCII("transactions"));
+  }
+
+  // Closes the database of |tx_store| once pending writes are done.
+  void DestroyTxStore(std::unique_ptr<TxStore> tx_store) {
+    tx_store.reset();
+    task_environment_.RunUntilIdle();
+  }
+
+  // Returns whether |tx| was added. That is only known right away once
+  // |tx_store| is loaded.
+  bool AddOrUpdateTx(TxStore* tx_store,
+                     const std::string& network,
+                     const std::string& id,
+                     base::Value::Dict tx) {
+    CHECK(tx_store->is_loaded());
+    absl::optional<bool> is_add;
+    tx_store->AddOrUpdateTx(
+        network, id, std::move(tx),
+        base::BindLambdaForTesting([&](bool result) { is_add = result; }));
+    EXPECT_TRUE(is_add);
+    return is_add.value_or(false);
+  }
+
+  std::vector<std::string> GetTxIds(
+      TxStore* tx_store,
+      const std::string& network,
+      absl::optional<mojom::TransactionStatus> status,
+      const absl::optional<std::string>& from) {
+    return GetIds(tx_store->GetTxs(network, status, from));
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  TestingPrefServiceSimple prefs_;
+};
+
+TEST_F(TxStoreUnitTest, GetTxs) {
+  auto tx_store = CreateTxStore();
+  task_environment_.RunUntilIdle();
+  ASSERT_TRUE(tx_store->is_loaded());
+
+  EXPECT_TRUE(AddOrUpdateTx(
+      tx_store.get(), kMainnet, "1",
+      MakeTx("1", mojom::TransactionStatus::Submitted, kFrom1)));
+  EXPECT_TRUE(AddOrUpdateTx(
+      tx_store.get(), kMainnet, "2",
+      MakeTx("2", mojom::TransactionStatus::Submitted, kFrom2)));
+  EXPECT_TRUE(AddOrUpdateTx(
+      tx_store.get(), kMainnet, "3",
+      MakeTx("3", mojom::TransactionStatus::Confirmed, kFrom1)));
+  EXPECT_TRUE(AddOrUpdateTx(
+      tx_store.get(), kGoerli, "4",
+      MakeTx("4", mojom::TransactionStatus::Submitted, kFrom1)));
+
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet, absl::nullopt, absl::nullopt),
+            (std::vector<std::string>{"1", "2", "3"}));
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet,
+                     mojom::TransactionStatus::Submitted, absl::nullopt),
+            (std::vector<std::string>{"1", "2"}));
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet,
+                     mojom::TransactionStatus::Submitted, kFrom2),
+            (std::vector<std::string>{"2"}));
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet, absl::nullopt, kFrom1),
+            (std::vector<std::string>{"1", "3"}));
+  EXPECT_TRUE(GetTxIds(tx_store.get(), kMainnet,
+                       mojom::TransactionStatus::Approved, absl::nullopt)
+                  .empty());
+  EXPECT_EQ(GetTxIds(tx_store.get(), kGoerli, absl::nullopt, absl::nullopt),
+            (std::vector<std::string>{"4"}));
+
+  // Updating the status of a transaction moves it in the status index.
+  EXPECT_FALSE(AddOrUpdateTx(
+      tx_store.get(), kMainnet, "1",
+      MakeTx("1", mojom::TransactionStatus::Confirmed, kFrom1)));
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet,
+                     mojom::TransactionStatus::Submitted, absl::nullopt),
+            (std::vector<std::string>{"2"}));
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet,
+                     mojom::TransactionStatus::Confirmed, absl::nullopt),
+            (std::vector<std::string>{"1", "3"}));
+
+  tx_store->DeleteTx(kMainnet, "3");
+  EXPECT_FALSE(tx_store->GetTx(kMainnet, "3"));
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet,
+                     mojom::TransactionStatus::Confirmed, absl::nullopt),
+            (std::vector<std::string>{"1"}));
+
+  tx_store->DeleteTxs(kMainnet);
+  EXPECT_TRUE(
+      GetTxIds(tx_store.get(), kMainnet, absl::nullopt, absl::nullopt).empty());
+  EXPECT_TRUE(tx_store->GetTx(kGoerli, "4"));
+
+  tx_store->DeleteAllTxs();
+  EXPECT_FALSE(tx_store->GetTx(kGoerli, "4"));
+}
+
+TEST_F(TxStoreUnitTest, PersistTxs) {
+  auto tx_store = CreateTxStore();
+  tx_store->AddOrUpdateTx(
+      kMainnet, "1",
+      MakeTx("1", mojom::TransactionStatus::Submitted, kFrom1),
+      base::DoNothing());
+  tx_store->AddOrUpdateTx(
+      kMainnet, "2",
+      MakeTx("2", mojom::TransactionStatus::Submitted, kFrom1),
+      base::DoNothing());
+  tx_store->AddOrUpdateTx(
+      kGoerli, "3",
+      MakeTx("3", mojom::TransactionStatus::Submitted, kFrom1),
+      base::DoNothing());
+  tx_store->AddOrUpdateTx(
+      kMainnet, "2",
+      MakeTx("2", mojom::TransactionStatus::Confirmed, kFrom1),
+      base::DoNothing());
+  tx_store->DeleteTx(kMainnet, "1");
+  DestroyTxStore(std::move(tx_store));
+
+  tx_store = CreateTxStore();
+  EXPECT_FALSE(tx_store->is_loaded());
+  task_environment_.RunUntilIdle();
+  ASSERT_TRUE(tx_store->is_loaded());
+
+  EXPECT_FALSE(tx_store->GetTx(kMainnet, "1"));
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet,
+                     mojom::TransactionStatus::Confirmed, absl::nullopt),
+            (std::vector<std::string>{"2"}));
+  EXPECT_TRUE(tx_store->GetTx(kGoerli, "3"));
+
+  tx_store->DeleteTxs(kGoerli);
+  DestroyTxStore(std::move(tx_store));
+
+  tx_store = CreateTxStore();
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(tx_store->GetTx(kMainnet, "2"));
+  EXPECT_FALSE(tx_store->GetTx(kGoerli, "3"));
+
+  tx_store->DeleteAllTxs();
+  DestroyTxStore(std::move(tx_store));
+
+  tx_store = CreateTxStore();
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(tx_store->GetTx(kMainnet, "2"));
+}
+
+TEST_F(TxStoreUnitTest, ApplyChangesMadeBeforeLoad) {
+  auto tx_store = CreateTxStore();
+  tx_store->AddOrUpdateTx(
+      kMainnet, "1",
+      MakeTx("1", mojom::TransactionStatus::Submitted, kFrom1),
+      base::DoNothing());
+  tx_store->AddOrUpdateTx(
+      kMainnet, "2",
+      MakeTx("2", mojom::TransactionStatus::Submitted, kFrom1),
+      base::DoNothing());
+  DestroyTxStore(std::move(tx_store));
+
+  tx_store = CreateTxStore();
+  ASSERT_FALSE(tx_store->is_loaded());
+  tx_store->AddOrUpdateTx(
+      kMainnet, "2",
+      MakeTx("2", mojom::TransactionStatus::Confirmed, kFrom1),
+      base::DoNothing());
+  tx_store->AddOrUpdateTx(
+      kMainnet, "3",
+      MakeTx("3", mojom::TransactionStatus::Submitted, kFrom1),
+      base::DoNothing());
+  tx_store->DeleteTx(kMainnet, "1");
+  task_environment_.RunUntilIdle();
+  ASSERT_TRUE(tx_store->is_loaded());
+
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet, absl::nullopt, absl::nullopt),
+            (std::vector<std::string>{"2", "3"}));
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet,
+                     mojom::TransactionStatus::Submitted, absl::nullopt),
+            (std::vector<std::string>{"3"}));
+}
+
+TEST_F(TxStoreUnitTest, ReadAndUpdateBeforeLoad) {
+  auto tx_store = CreateTxStore();
+  tx_store->AddOrUpdateTx(
+      kMainnet, "1",
+      MakeTx("1", mojom::TransactionStatus::Submitted, kFrom1),
+      base::DoNothing());
+  DestroyTxStore(std::move(tx_store));
+
+  tx_store = CreateTxStore();
+  ASSERT_FALSE(tx_store->is_loaded());
+  bool loaded = false;
+  tx_store->RunWhenLoaded(base::BindLambdaForTesting([&]() {
+    // Callbacks run with the changes made before the load applied.
+    EXPECT_TRUE(tx_store->is_loaded());
+    EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet,
+                       mojom::TransactionStatus::Submitted, absl::nullopt),
+              (std::vector<std::string>{"2"}));
+    loaded = true;
+  }));
+
+  // Reads do not see the persisted transactions yet.
+  EXPECT_FALSE(tx_store->GetTx(kMainnet, "1"));
+  EXPECT_TRUE(
+      GetTxIds(tx_store.get(), kMainnet, absl::nullopt, absl::nullopt).empty());
+
+  // Whether a change adds a transaction is only known once loaded.
+  absl::optional<bool> is_update_add;
+  absl::optional<bool> is_new_add;
+  tx_store->AddOrUpdateTx(
+      kMainnet, "1", MakeTx("1", mojom::TransactionStatus::Confirmed, kFrom1),
+      base::BindLambdaForTesting(
+          [&](bool is_add) { is_update_add = is_add; }));
+  tx_store->AddOrUpdateTx(
+      kMainnet, "2", MakeTx("2", mojom::TransactionStatus::Submitted, kFrom1),
+      base::BindLambdaForTesting([&](bool is_add) { is_new_add = is_add; }));
+  EXPECT_FALSE(is_update_add);
+  EXPECT_FALSE(is_new_add);
+  EXPECT_FALSE(loaded);
+
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(loaded);
+  EXPECT_EQ(is_update_add, false);
+  EXPECT_EQ(is_new_add, true);
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet,
+                     mojom::TransactionStatus::Confirmed, absl::nullopt),
+            (std::vector<std::string>{"1"}));
+
+  // Once loaded, callbacks run right away.
+  bool ran = false;
+  tx_store->RunWhenLoaded(base::BindLambdaForTesting([&]() { ran = true; }));
+  EXPECT_TRUE(ran);
+}
+
+TEST_F(TxStoreUnitTest, MigrateTransactionsPref) {
+  {
+    DictionaryPrefUpdate update(&prefs_, kBraveWalletTransactions);
+    base::Value::Dict& dict = update.Get()->GetDict();
+    dict.SetByDottedPath(
+        "ethereum.mainnet.1",
+        base::Value(MakeTx("1", mojom::TransactionStatus::Submitted, kFrom1)));
+    dict.SetByDottedPath(
+        "solana.testnet.2",
+        base::Value(MakeTx("2", mojom::TransactionStatus::Confirmed, kFrom2)));
+  }
+
+  // Migrated transactions are available right away.
+  auto tx_store = CreateTxStore();
+  EXPECT_TRUE(tx_store->GetTx(kMainnet, "1"));
+  EXPECT_TRUE(tx_store->GetTx("solana.testnet", "2"));
+
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(prefs_.HasPrefPath(kBraveWalletTransactions));
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet,
+                     mojom::TransactionStatus::Submitted, absl::nullopt),
+            (std::vector<std::string>{"1"}));
+  tx_store->AddOrUpdateTx(
+      kMainnet, "1",
+      MakeTx("1", mojom::TransactionStatus::Confirmed, kFrom1),
+      base::DoNothing());
+  DestroyTxStore(std::move(tx_store));
+
+  // A migration that is retried does not overwrite newer transactions.
+  {
+    DictionaryPrefUpdate update(&prefs_, kBraveWalletTransactions);
+    update.Get()->GetDict().SetByDottedPath(
+        "ethereum.mainnet.1",
+        base::Value(MakeTx("1", mojom::TransactionStatus::Submitted, kFrom1)));
+  }
+  tx_store = CreateTxStore();
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(GetTxIds(tx_store.get(), kMainnet,
+                     mojom::TransactionStatus::Confirmed, absl::nullopt),
+            (std::vector<std::string>{"1"}));
+  EXPECT_TRUE(tx_store->GetTx("solana.testnet", "2"));
+}
+
+TEST_F(TxStoreUnitTest, InMemory) {
+  auto tx_store = std::make_unique<TxStore>(&prefs_, base::FilePath());
+  tx_store->AddOrUpdateTx(
+      kMainnet, "1",
+      MakeTx("1", mojom::TransactionStatus::Submitted, kFrom1),
+      base::DoNothing());
+  task_environment_.RunUntilIdle();
+  ASSERT_TRUE(tx_store->is_loaded());
+  EXPECT_TRUE(tx_store->GetTx(kMainnet, "1"));
+}
+
+}  // namespace brave_wallet
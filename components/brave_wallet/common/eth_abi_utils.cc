@@ -128,6 +128,15 @@ EthAddress ExtractAddressFromTuple(Span data, size_t tuple_pos) {
   return ExtractAddress(*address_head);
 }
 
+absl::optional<uint256_t> ExtractUint256FromTuple(Span data,
+                                                  size_t tuple_pos) {
+  // Uint256 is placed in tuple head.
+  auto head = ExtractHeadFromTuple(data, tuple_pos);
+  if (!head)
+    return absl::nullopt;
+  return BytesToUint256(*head);
+}
+
 absl::optional<std::vector<uint8_t>> ExtractBytes(Span bytes_encoded) {
   // uint256 size followed by padded bytes.
   auto bytes_len_row = ExtractRow(bytes_encoded, 0);
@@ -267,6 +276,43 @@ ExtractFixedBytesFromTuple(Span data, size_t fixed_size, size_t tuple_pos) {
   return std::vector<uint8_t>{head->begin(), head->begin() + fixed_size};
 }
 
+absl::optional<std::vector<Span>> ExtractTupleArrayFromTuple(Span data,
+                                                             size_t tuple_pos) {
+  // Head contains offset to tuple[] start.
+  auto head = ExtractHeadFromTuple(data, tuple_pos);
+  if (!head)
+    return absl::nullopt;
+
+  absl::optional<size_t> offset = BytesToSize(*head);
+  if (!offset || *offset > data.size())
+    return absl::nullopt;
+
+  // Array is stored as size row and tuple of that size.
+  Span tuple_array = data.subspan(*offset);
+  auto [tuple_size, tuple_header] = ExtractArrayInfo(tuple_array);
+  if (!tuple_size)
+    return absl::nullopt;
+  // Row count in array is reasonable upper limit.
+  if (*tuple_size > PaddedRowCount(tuple_array.size()))
+    return absl::nullopt;
+
+  std::vector<Span> result;
+  result.reserve(*tuple_size);
+  for (auto i = 0u; i < *tuple_size; ++i) {
+    // Each tuple head row contains offset to encoded tuple element.
+    auto tuple_element_head = ExtractHeadFromTuple(tuple_header, i);
+    if (!tuple_element_head)
+      return absl::nullopt;
+
+    auto tuple_element_offset = BytesToSize(*tuple_element_head);
+    if (!tuple_element_offset || *tuple_element_offset >= tuple_header.size())
+      return absl::nullopt;
+
+    result.push_back(tuple_header.subspan(*tuple_element_offset));
+  }
+  return result;
+}
+
 // NOLINTNEXTLINE(runtime/references)
 size_t AppendEmptyRow(std::vector<uint8_t>& destination) {
   destination.resize(destination.size() + kRowLength, 0);
@@ -415,6 +461,22 @@ TupleEncoder& TupleEncoder::AddStringArray(
   return *this;
 }
 
+TupleEncoder& TupleEncoder::AddTupleArray(
+    const std::vector<std::vector<uint8_t>>& encoded_tuples) {
+  auto& element = AppendElement();
+  // Encoded as tuple size.
+  AppendRow(element.tail, uint256_t(encoded_tuples.size()));
+
+  // And then tuple of offsets to encoded tuples.
+  TupleEncoder tuple_array;
+  for (auto& encoded_tuple : encoded_tuples) {
+    DCHECK(!encoded_tuple.empty());
+    tuple_array.AppendElement().tail = encoded_tuple;
+  }
+  tuple_array.EncodeTo(element.tail);
+  return *this;
+}
+
 TupleEncoder::Element& TupleEncoder::AppendElement() {
   return elements_.emplace_back();
 }
@@ -29,6 +29,7 @@ std::pair<Span, Span> ExtractFunctionSelectorAndArgsFromCall(Span data);
 
 EthAddress ExtractAddress(Span address_encoded);
 EthAddress ExtractAddressFromTuple(Span data, size_t tuple_pos);
+absl::optional<uint256_t> ExtractUint256FromTuple(Span data, size_t tuple_pos);
 absl::optional<std::vector<uint8_t>> ExtractBytes(Span bytes_encoded);
 absl::optional<std::string> ExtractString(Span string_encoded);
 
@@ -40,6 +41,10 @@ absl::optional<std::vector<uint8_t>> ExtractBytesFromTuple(Span data,
                                                            size_t tuple_pos);
 absl::optional<std::vector<uint8_t>>
 ExtractFixedBytesFromTuple(Span data, size_t fixed_size, size_t tuple_pos);
+// Returns encoded elements of a dynamic tuple array, each to be decoded with
+// Extract*FromTuple.
+absl::optional<std::vector<Span>> ExtractTupleArrayFromTuple(Span data,
+                                                             size_t tuple_pos);
 
 class TupleEncoder {
  public:
@@ -51,6 +56,9 @@ class TupleEncoder {
   TupleEncoder& AddBytes(Span bytes);
   TupleEncoder& AddString(const std::string& string);
   TupleEncoder& AddStringArray(const std::vector<std::string>& string_array);
+  // Adds an array of dynamic tuples, each encoded with |Encode|.
+  TupleEncoder& AddTupleArray(
+      const std::vector<std::vector<uint8_t>>& encoded_tuples);
 
   std::vector<uint8_t> Encode() const;
   std::vector<uint8_t> EncodeWithSelector(Span4 selector) const;
@@ -386,6 +386,61 @@ TEST(EthAbiUtilsTest, ExtractFixedBytesFromTuple) {
   EXPECT_FALSE(ExtractFixedBytesFromTuple(args, 4, 3));
 }
 
+TEST(EthAbiUtilsTest, ExtractUint256FromTuple) {
+  auto bytes = ToBytes(GetOffchainLookupResponse());
+
+  auto [_, args] = ExtractFunctionSelectorAndArgsFromCall(bytes);
+
+  EXPECT_EQ(*ExtractUint256FromTuple(args, 1), uint256_t(0xa0));
+  EXPECT_EQ(*ExtractUint256FromTuple(args, 2), uint256_t(0x160));
+
+  // Bad tuple pos.
+  EXPECT_FALSE(ExtractUint256FromTuple(args, 1000));
+
+  // Empty data.
+  EXPECT_FALSE(ExtractUint256FromTuple({}, 0));
+}
+
+TEST(EthAbiUtilsTest, ExtractTupleArrayFromTuple) {
+  // (uint256,bytes)[]
+  auto args = ToBytes(
+      "0000000000000000000000000000000000000000000000000000000000000020"
+      "0000000000000000000000000000000000000000000000000000000000000002"
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "00000000000000000000000000000000000000000000000000000000000000c0"
+      "0000000000000000000000000000000000000000000000000000000000000001"
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "0000000000000000000000000000000000000000000000000000000000000001"
+      "aa00000000000000000000000000000000000000000000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000000000000002"
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "0000000000000000000000000000000000000000000000000000000000000000");
+
+  auto tuples = ExtractTupleArrayFromTuple(args, 0);
+  ASSERT_TRUE(tuples);
+  ASSERT_EQ(2u, tuples->size());
+  EXPECT_EQ(*ExtractUint256FromTuple(tuples->at(0), 0), uint256_t(1));
+  EXPECT_EQ(ToHex(*ExtractBytesFromTuple(tuples->at(0), 1)), "0xaa");
+  EXPECT_EQ(*ExtractUint256FromTuple(tuples->at(1), 0), uint256_t(2));
+  EXPECT_TRUE(ExtractBytesFromTuple(tuples->at(1), 1)->empty());
+
+  // Bad tuple pos.
+  EXPECT_FALSE(ExtractTupleArrayFromTuple(args, 1000));
+
+  // Empty data.
+  EXPECT_FALSE(ExtractTupleArrayFromTuple({}, 0));
+
+  // Bad offset of tuple element.
+  args[126] = 0xff;
+  EXPECT_FALSE(ExtractTupleArrayFromTuple(args, 0));
+
+  // Empty array.
+  auto empty_args = ToBytes(
+      "0000000000000000000000000000000000000000000000000000000000000020"
+      "0000000000000000000000000000000000000000000000000000000000000000");
+  EXPECT_EQ(0u, ExtractTupleArrayFromTuple(empty_args, 0)->size());
+}
+
 TEST(EthAbiTupleEncoderTest, EncodeCall) {
   std::vector<uint8_t> data(33, 0xbb);
   auto selector_bytes = ToBytes("f400d2f8");
@@ -425,4 +480,37 @@ TEST(EthAbiTupleEncoderTest, EncodeCall) {
           .substr(2));
 }
 
+TEST(EthAbiTupleEncoderTest, EncodeTupleArray) {
+  auto selector_bytes = ToBytes("f400d2f8");
+  Span4 selector(selector_bytes.begin(), 4);
+  auto tuple_0 = TupleEncoder().AddUint256(1).AddBytes(ToBytes("aa")).Encode();
+  auto tuple_1 = TupleEncoder().AddUint256(2).AddBytes({}).Encode();
+  // f((uint256,bytes)[])
+  EXPECT_EQ(
+      "f400d2f8"
+      "0000000000000000000000000000000000000000000000000000000000000020"
+      "0000000000000000000000000000000000000000000000000000000000000002"
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "00000000000000000000000000000000000000000000000000000000000000c0"
+      "0000000000000000000000000000000000000000000000000000000000000001"
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "0000000000000000000000000000000000000000000000000000000000000001"
+      "aa00000000000000000000000000000000000000000000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000000000000002"
+      "0000000000000000000000000000000000000000000000000000000000000040"
+      "0000000000000000000000000000000000000000000000000000000000000000",
+      ToHex(TupleEncoder()
+                .AddTupleArray({tuple_0, tuple_1})
+                .EncodeWithSelector(selector))
+          .substr(2));
+
+  // f((uint256,bytes)[]) with empty array.
+  EXPECT_EQ(
+      "f400d2f8"
+      "0000000000000000000000000000000000000000000000000000000000000020"
+      "0000000000000000000000000000000000000000000000000000000000000000",
+      ToHex(TupleEncoder().AddTupleArray({}).EncodeWithSelector(selector))
+          .substr(2));
+}
+
 }  // namespace brave_wallet::eth_abi
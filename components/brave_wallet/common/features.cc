@@ -50,5 +50,13 @@ BASE_FEATURE(kBraveWalletSnsFeature,
              "BraveWalletSns",
              base::FEATURE_DISABLED_BY_DEFAULT);
 
+BASE_FEATURE(kBraveWalletJsonRpcResponseCacheFeature,
+             "BraveWalletJsonRpcResponseCache",
+             base::FEATURE_ENABLED_BY_DEFAULT);
+
+BASE_FEATURE(kBraveWalletAssetDiscoveryBalanceScanFeature,
+             "BraveWalletAssetDiscoveryBalanceScan",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 }  // namespace features
 }  // namespace brave_wallet
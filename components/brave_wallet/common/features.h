@@ -20,6 +20,8 @@ BASE_DECLARE_FEATURE(kBraveWalletSolanaProviderFeature);
 BASE_DECLARE_FEATURE(kBraveWalletDappsSupportFeature);
 BASE_DECLARE_FEATURE(kBraveWalletENSL2Feature);
 BASE_DECLARE_FEATURE(kBraveWalletSnsFeature);
+BASE_DECLARE_FEATURE(kBraveWalletJsonRpcResponseCacheFeature);
+BASE_DECLARE_FEATURE(kBraveWalletAssetDiscoveryBalanceScanFeature);
 
 }  // namespace features
 }  // namespace brave_wallet
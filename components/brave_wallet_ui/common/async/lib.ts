@@ -30,6 +30,7 @@ import { getTokenParam, getFlattenedAccountBalances } from '../../utils/api-util
 import Amount from '../../utils/amount'
 import { sortTransactionByDate } from '../../utils/tx-utils'
 import { addLogoToToken, getBatTokensFromList, getNativeTokensFromList, getUniqueAssets } from '../../utils/asset-utils'
+import { isValidAddress } from '../../utils/address-utils'
 import { loadTimeData } from '../../../common/loadTimeData'
 import { walletApi } from '../slices/api.slice'
 
@@ -532,6 +533,33 @@ export function refreshBalances () {
     const getBlockchainTokensBalanceReturnInfos = await Promise.all(accounts.map(async (account) => {
       const networks = getNetworksByCoinType(networkList, account.coin)
       if (account.coin === BraveWallet.CoinType.ETH) {
+        // With the balance scan, get the ERC20 balances of each network in
+        // aggregated calls instead of one call per token. Balances the scan
+        // could not get are requested per token below.
+        const erc20BalanceInfos = new Map<BraveWallet.BlockchainToken, typeof emptyBalance>()
+        if (loadTimeData.getBoolean(BraveWallet.ASSET_DISCOVERY_BALANCE_SCAN_LOAD_TIME_KEY)) {
+          const erc20TokensByChainId: { [chainId: string]: BraveWallet.BlockchainToken[] } = {}
+          visibleTokens.forEach((token) => {
+            // An invalid contract address fails the whole scan
+            if (!token.isErc721 && isValidAddress(token.contractAddress, 20) && networks.some(n => n.chainId === token.chainId)) {
+              erc20TokensByChainId[token.chainId] = [...(erc20TokensByChainId[token.chainId] ?? []), token]
+            }
+          })
+          await Promise.all(Object.keys(erc20TokensByChainId).map(async (chainId) => {
+            const tokens = erc20TokensByChainId[chainId]
+            const result = await jsonRpcService.getERC20TokenBalances(tokens.map(token => token.contractAddress), account.address, chainId)
+            if (result.error !== BraveWallet.ProviderError.kSuccess) {
+              return
+            }
+            tokens.forEach((token, index) => {
+              const balance = result.balances[index]
+              if (typeof balance === 'string') {
+                erc20BalanceInfos.set(token, { balance, error: BraveWallet.ProviderError.kSuccess, errorMessage: '' })
+              }
+            })
+          }))
+        }
+
         return Promise.all(visibleTokens.map(async (token) => {
           let balanceInfo = emptyBalance
           if (networks.some(n => n.chainId === token.chainId)) {
@@ -539,8 +567,8 @@ export function refreshBalances () {
               balanceInfo =
                 await jsonRpcService.getERC721TokenBalance(token.contractAddress, token.tokenId ?? '', account.address, token?.chainId ?? '')
             } else {
-              balanceInfo =
-               await jsonRpcService.getERC20TokenBalance(token.contractAddress, account.address, token?.chainId ?? '')
+              balanceInfo = erc20BalanceInfos.get(token) ??
+                await jsonRpcService.getERC20TokenBalance(token.contractAddress, account.address, token?.chainId ?? '')
             }
           }
           return {
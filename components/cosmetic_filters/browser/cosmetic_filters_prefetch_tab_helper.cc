@@ -0,0 +1,184 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/cosmetic_filters/browser/cosmetic_filters_prefetch_tab_helper.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/containers/cxx20_erase.h"
+#include "base/feature_list.h"
+#include "base/metrics/histogram_macros.h"
+#include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/common/features.h"
+#include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+#include "mojo/public/cpp/bindings/associated_remote.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
+
+namespace cosmetic_filters {
+
+CosmeticFiltersPrefetchTabHelper::CosmeticFiltersPrefetchTabHelper(
+    content::WebContents* web_contents,
+    brave_shields::AdBlockService* ad_block_service,
+    HostContentSettingsMap* settings_map)
+    : content::WebContentsObserver(web_contents),
+      content::WebContentsUserData<CosmeticFiltersPrefetchTabHelper>(
+          *web_contents),
+      ad_block_service_(ad_block_service),
+      settings_map_(settings_map) {}
+
+CosmeticFiltersPrefetchTabHelper::~CosmeticFiltersPrefetchTabHelper() =
+    default;
+
+// static
+void CosmeticFiltersPrefetchTabHelper::MaybeCreateForWebContents(
+    content::WebContents* web_contents,
+    brave_shields::AdBlockService* ad_block_service,
+    HostContentSettingsMap* settings_map) {
+  if (!ad_block_service || !settings_map ||
+      !base::FeatureList::IsEnabled(
+          brave_shields::features::kCosmeticFilteringPrefetch)) {
+    return;
+  }
+
+  CreateForWebContents(web_contents, ad_block_service, settings_map);
+}
+
+void CosmeticFiltersPrefetchTabHelper::DidStartNavigation(
+    content::NavigationHandle* navigation_handle) {
+  if (navigation_handle->IsSameDocument()) {
+    return;
+  }
+
+  // A new document navigation in the same frame supersedes any earlier one,
+  // so its resources must not reach the frame once they arrive.
+  const int frame_tree_node_id = navigation_handle->GetFrameTreeNodeId();
+  base::EraseIf(pending_navigations_, [frame_tree_node_id](const auto& entry) {
+    return entry.second.frame_tree_node_id == frame_tree_node_id;
+  });
+
+  StartPrefetch(navigation_handle);
+}
+
+void CosmeticFiltersPrefetchTabHelper::DidRedirectNavigation(
+    content::NavigationHandle* navigation_handle) {
+  // Any result for the previous URL will be dropped on arrival since it no
+  // longer matches.
+  pending_navigations_.erase(navigation_handle->GetNavigationId());
+  StartPrefetch(navigation_handle);
+}
+
+void CosmeticFiltersPrefetchTabHelper::ReadyToCommitNavigation(
+    content::NavigationHandle* navigation_handle) {
+  auto it = pending_navigations_.find(navigation_handle->GetNavigationId());
+  if (it == pending_navigations_.end()) {
+    return;
+  }
+
+  content::RenderFrameHost* render_frame_host =
+      navigation_handle->GetRenderFrameHost();
+  PendingNavigation& pending = it->second;
+  UMA_HISTOGRAM_BOOLEAN("Brave.CosmeticFilters.PrefetchReadyBeforeCommit",
+                        pending.resources.has_value());
+  if (!pending.resources) {
+    pending.committing_frame = render_frame_host->GetGlobalId();
+    return;
+  }
+
+  PushResources(render_frame_host, pending.url,
+                std::move(pending.resources.value()));
+  pending_navigations_.erase(it);
+}
+
+void CosmeticFiltersPrefetchTabHelper::DidFinishNavigation(
+    content::NavigationHandle* navigation_handle) {
+  pending_navigations_.erase(navigation_handle->GetNavigationId());
+}
+
+void CosmeticFiltersPrefetchTabHelper::StartPrefetch(
+    content::NavigationHandle* navigation_handle) {
+  if (!ShouldPrefetch(navigation_handle)) {
+    return;
+  }
+
+  const GURL& url = navigation_handle->GetURL();
+  const int64_t navigation_id = navigation_handle->GetNavigationId();
+  PendingNavigation& pending = pending_navigations_[navigation_id];
+  pending.url = url;
+  pending.frame_tree_node_id = navigation_handle->GetFrameTreeNodeId();
+
+  ad_block_service_->GetTaskRunner()->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&brave_shields::AdBlockService::UrlCosmeticResources,
+                     base::Unretained(ad_block_service_), url.spec()),
+      base::BindOnce(&CosmeticFiltersPrefetchTabHelper::OnUrlCosmeticResources,
+                     weak_factory_.GetWeakPtr(), navigation_id, url));
+}
+
+bool CosmeticFiltersPrefetchTabHelper::ShouldPrefetch(
+    content::NavigationHandle* navigation_handle) const {
+  // Only the top-level document is worth racing the commit for. Subframes,
+  // most of which are ads themselves, would each cost a lookup on the adblock
+  // task runner, and the renderer asks for their resources on its own.
+  if (navigation_handle->IsSameDocument() ||
+      !navigation_handle->IsInOutermostMainFrame() ||
+      !navigation_handle->GetURL().SchemeIsHTTPOrHTTPS() ||
+      !base::FeatureList::IsEnabled(
+          brave_shields::features::kBraveAdblockCosmeticFiltering)) {
+    return false;
+  }
+
+  // The renderer makes the authoritative decision once the frame commits;
+  // this only avoids wasting work on sites where shields are down.
+  const GURL& url = navigation_handle->GetURL();
+  return brave_shields::GetBraveShieldsEnabled(settings_map_, url) &&
+         brave_shields::GetCosmeticFilteringControlType(settings_map_, url) !=
+             brave_shields::ControlType::ALLOW;
+}
+
+void CosmeticFiltersPrefetchTabHelper::OnUrlCosmeticResources(
+    int64_t navigation_id,
+    const GURL& url,
+    mojom::UrlCosmeticResourcesPtr resources) {
+  auto it = pending_navigations_.find(navigation_id);
+  if (it == pending_navigations_.end() || it->second.url != url) {
+    return;
+  }
+
+  PendingNavigation& pending = it->second;
+  if (!pending.committing_frame) {
+    pending.resources = std::move(resources);
+    return;
+  }
+
+  // Too late to beat the commit, but possibly still ahead of the renderer's
+  // own request.
+  content::RenderFrameHost* render_frame_host =
+      content::RenderFrameHost::FromID(*pending.committing_frame);
+  if (render_frame_host) {
+    PushResources(render_frame_host, url, std::move(resources));
+  }
+  pending_navigations_.erase(it);
+}
+
+void CosmeticFiltersPrefetchTabHelper::PushResources(
+    content::RenderFrameHost* render_frame_host,
+    const GURL& url,
+    mojom::UrlCosmeticResourcesPtr resources) {
+  if (!render_frame_host->IsRenderFrameLive()) {
+    return;
+  }
+
+  mojo::AssociatedRemote<mojom::CosmeticFiltersAgent> agent;
+  render_frame_host->GetRemoteAssociatedInterfaces()->GetInterface(&agent);
+  agent->SetPrefetchedUrlCosmeticResources(url, std::move(resources));
+}
+
+WEB_CONTENTS_USER_DATA_KEY_IMPL(CosmeticFiltersPrefetchTabHelper);
+
+}  // namespace cosmetic_filters
@@ -0,0 +1,105 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_COSMETIC_FILTERS_BROWSER_COSMETIC_FILTERS_PREFETCH_TAB_HELPER_H_
+#define BRAVE_COMPONENTS_COSMETIC_FILTERS_BROWSER_COSMETIC_FILTERS_PREFETCH_TAB_HELPER_H_
+
+#include <stdint.h>
+
+#include "base/containers/flat_map.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
+#include "content/public/browser/global_routing_id.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "content/public/browser/web_contents_user_data.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/gurl.h"
+
+class HostContentSettingsMap;
+
+namespace brave_shields {
+class AdBlockService;
+}
+
+namespace content {
+class NavigationHandle;
+class WebContents;
+}  // namespace content
+
+namespace cosmetic_filters {
+
+// Starts computing the cosmetic resources for a main frame as soon as its
+// navigation starts, on the adblock task runner, and hands them to the
+// renderer through `mojom::CosmeticFiltersAgent` once the navigation is ready
+// to commit. Navigations whose resources are not ready in time are covered by
+// the renderer asking for them asynchronously.
+class CosmeticFiltersPrefetchTabHelper
+    : public content::WebContentsObserver,
+      public content::WebContentsUserData<CosmeticFiltersPrefetchTabHelper> {
+ public:
+  ~CosmeticFiltersPrefetchTabHelper() override;
+  CosmeticFiltersPrefetchTabHelper(const CosmeticFiltersPrefetchTabHelper&) =
+      delete;
+  CosmeticFiltersPrefetchTabHelper& operator=(
+      const CosmeticFiltersPrefetchTabHelper&) = delete;
+
+  // Attaches the helper if the feature is enabled.
+  static void MaybeCreateForWebContents(
+      content::WebContents* web_contents,
+      brave_shields::AdBlockService* ad_block_service,
+      HostContentSettingsMap* settings_map);
+
+ private:
+  friend class content::WebContentsUserData<CosmeticFiltersPrefetchTabHelper>;
+
+  struct PendingNavigation {
+    GURL url;
+    int frame_tree_node_id = content::RenderFrameHost::kNoFrameTreeNodeId;
+    absl::optional<mojom::UrlCosmeticResourcesPtr> resources;
+    // Set once the navigation is ready to commit, so that resources arriving
+    // afterwards are sent straight to the committing frame.
+    absl::optional<content::GlobalRenderFrameHostId> committing_frame;
+  };
+
+  CosmeticFiltersPrefetchTabHelper(
+      content::WebContents* web_contents,
+      brave_shields::AdBlockService* ad_block_service,
+      HostContentSettingsMap* settings_map);
+
+  // content::WebContentsObserver overrides.
+  void DidStartNavigation(
+      content::NavigationHandle* navigation_handle) override;
+  void DidRedirectNavigation(
+      content::NavigationHandle* navigation_handle) override;
+  void ReadyToCommitNavigation(
+      content::NavigationHandle* navigation_handle) override;
+  void DidFinishNavigation(
+      content::NavigationHandle* navigation_handle) override;
+
+  void StartPrefetch(content::NavigationHandle* navigation_handle);
+  bool ShouldPrefetch(content::NavigationHandle* navigation_handle) const;
+  void OnUrlCosmeticResources(int64_t navigation_id,
+                              const GURL& url,
+                              mojom::UrlCosmeticResourcesPtr resources);
+  void PushResources(content::RenderFrameHost* render_frame_host,
+                     const GURL& url,
+                     mojom::UrlCosmeticResourcesPtr resources);
+
+  raw_ptr<brave_shields::AdBlockService> ad_block_service_ =
+      nullptr;  // Not owned
+  raw_ptr<HostContentSettingsMap> settings_map_ = nullptr;  // Not owned
+
+  base::flat_map<int64_t, PendingNavigation> pending_navigations_;
+
+  base::WeakPtrFactory<CosmeticFiltersPrefetchTabHelper> weak_factory_{this};
+
+  WEB_CONTENTS_USER_DATA_KEY_DECL();
+};
+
+}  // namespace cosmetic_filters
+
+#endif  // BRAVE_COMPONENTS_COSMETIC_FILTERS_BROWSER_COSMETIC_FILTERS_PREFETCH_TAB_HELPER_H_
@@ -12,7 +12,6 @@
 
 #include "base/callback.h"
 #include "base/memory/raw_ptr.h"
-#include "base/values.h"
 #include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 
@@ -37,8 +36,9 @@ class CosmeticFiltersResources final
   ~CosmeticFiltersResources() override;
 
   // Sends back to renderer a response about rules that has to be applied
-  // for the specified selectors.
-  void HiddenClassIdSelectors(const std::string& input,
+  // for the specified classes and ids.
+  void HiddenClassIdSelectors(const std::vector<std::string>& classes,
+                              const std::vector<std::string>& ids,
                               const std::vector<std::string>& exceptions,
                               HiddenClassIdSelectorsCallback callback) override;
 
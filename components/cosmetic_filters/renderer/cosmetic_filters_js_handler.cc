@@ -9,7 +9,7 @@
 
 #include "base/bind.h"
 #include "base/feature_list.h"
-#include "base/json/json_writer.h"
+#include "base/json/string_escape.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
 #include "base/strings/stringprintf.h"
@@ -39,6 +39,10 @@ static base::NoDestructor<std::vector<std::string>> g_vetted_search_engines(
     {"duckduckgo", "qwant", "bing", "startpage", "google", "yandex", "ecosia",
      "brave"});
 
+// Upper bound on the number of class and id names remembered as having no
+// generic rule, each.
+constexpr size_t kMaxNonMatchingNames = 10000;
+
 // Entry point to content_cosmetic.ts script.
 const char kObservingScriptletEntryPoint[] =
     "window.content_cosmetic.tryScheduleQueuePump()";
@@ -142,6 +146,26 @@ bool IsVettedSearchEngine(const GURL& url) {
   return false;
 }
 
+// Builds a JavaScript array literal of string literals directly from the
+// selectors, without going through base::Value and JSONWriter.
+std::string ToJSArray(const std::vector<std::string>& strings) {
+  std::string result = "[";
+  for (const auto& string : strings) {
+    if (result.size() > 1)
+      result += ',';
+    base::EscapeJSONString(string, /*put_in_quotes=*/true, &result);
+  }
+  result += ']';
+  return result;
+}
+
+void AppendHideRules(const std::vector<std::string>& selectors,
+                     std::string* stylesheet) {
+  for (const auto& selector : selectors) {
+    *stylesheet += selector + "{display:none !important}";
+  }
+}
+
 // ID is used in TRACE_ID_WITH_SCOPE(). Must be unique accoss the process.
 int MakeUniquePerfId() {
   static int counter = 0;
@@ -194,7 +218,9 @@ CosmeticFiltersJSHandler::CosmeticFiltersJSHandler(
     const int32_t isolated_world_id)
     : render_frame_(render_frame),
       isolated_world_id_(isolated_world_id),
-      enabled_1st_party_cf_(false) {
+      enabled_1st_party_cf_(false),
+      non_matching_classes_(kMaxNonMatchingNames),
+      non_matching_ids_(kMaxNonMatchingNames) {
   EnsureConnected();
 
   const bool perf_tracker_enabled = base::FeatureList::IsEnabled(
@@ -207,14 +233,47 @@ CosmeticFiltersJSHandler::CosmeticFiltersJSHandler(
 CosmeticFiltersJSHandler::~CosmeticFiltersJSHandler() = default;
 
 void CosmeticFiltersJSHandler::HiddenClassIdSelectors(
-    const std::string& input) {
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids) {
+  size_t skipped = 0;
+  for (const auto& name : classes) {
+    if (non_matching_classes_.Get(name) != non_matching_classes_.end()) {
+      skipped++;
+      continue;
+    }
+    pending_classes_.push_back(name);
+  }
+  for (const auto& name : ids) {
+    if (non_matching_ids_.Get(name) != non_matching_ids_.end()) {
+      skipped++;
+      continue;
+    }
+    pending_ids_.push_back(name);
+  }
+  UMA_HISTOGRAM_COUNTS_1000("Brave.CosmeticFilters.ClassIdNegativeCacheHits",
+                            skipped);
+
+  MaybeSendPendingClassIdQueries();
+}
+
+void CosmeticFiltersJSHandler::MaybeSendPendingClassIdQueries() {
+  if (class_id_query_in_flight_ ||
+      (pending_classes_.empty() && pending_ids_.empty())) {
+    return;
+  }
   if (!EnsureConnected())
     return;
 
+  class_id_query_in_flight_ = true;
+  std::vector<std::string> classes;
+  std::vector<std::string> ids;
+  classes.swap(pending_classes_);
+  ids.swap(pending_ids_);
   cosmetic_filters_resources_->HiddenClassIdSelectors(
-      input, exceptions_,
+      classes, ids, exceptions_,
       base::BindOnce(&CosmeticFiltersJSHandler::OnHiddenClassIdSelectors,
-                     base::Unretained(this)));
+                     base::Unretained(this), document_generation_, classes,
+                     ids));
 }
 
 bool CosmeticFiltersJSHandler::OnIsFirstParty(const std::string& url_string) {
@@ -336,12 +395,22 @@ void CosmeticFiltersJSHandler::OnRemoteDisconnect() {
   EnsureConnected();
 }
 
-bool CosmeticFiltersJSHandler::ProcessURL(
-    const GURL& url,
-    absl::optional<base::OnceClosure> callback) {
-  resources_dict_ = absl::nullopt;
+bool CosmeticFiltersJSHandler::ProcessURL(const GURL& url,
+                                          base::OnceClosure callback) {
+  resources_.reset();
+  on_resources_callback_.Reset();
   url_ = url;
   enabled_1st_party_cf_ = false;
+  exceptions_.clear();
+
+  document_generation_++;
+  pending_classes_.clear();
+  pending_ids_.clear();
+  if (url_.host() != negative_cache_host_) {
+    negative_cache_host_ = url_.host();
+    non_matching_classes_.Clear();
+    non_matching_ids_.Clear();
+  }
 
   // Trivially, don't make exceptions for malformed URLs.
   if (!EnsureConnected() || url_.is_empty() || !url_.is_valid())
@@ -362,58 +431,84 @@ bool CosmeticFiltersJSHandler::ProcessURL(
       render_frame_->GetWebFrame()->IsCrossOriginToOutermostMainFrame() ||
       content_settings->IsFirstPartyCosmeticFilteringEnabled(url_);
 
-  if (callback.has_value()) {
-    SCOPED_UMA_HISTOGRAM_TIMER_MICROS(
-        "Brave.CosmeticFilters.UrlCosmeticResources");
-    TRACE_EVENT1("brave.adblock", "UrlCosmeticResources", "url", url_.spec());
-    cosmetic_filters_resources_->UrlCosmeticResources(
-        url_.spec(),
-        base::BindOnce(&CosmeticFiltersJSHandler::OnUrlCosmeticResources,
-                       base::Unretained(this), std::move(callback.value())));
-  } else {
-    TRACE_EVENT1("brave.adblock", "UrlCosmeticResourcesSync", "url",
-                 url_.spec());
-    SCOPED_UMA_HISTOGRAM_TIMER_MICROS(
-        "Brave.CosmeticFilters.UrlCosmeticResourcesSync");
-    base::Value result;
-    cosmetic_filters_resources_->UrlCosmeticResources(url_.spec(), &result);
-
-    auto* dict = result.GetIfDict();
-    if (dict)
-      resources_dict_ = std::move(*dict);
+  const bool prefetched = prefetched_resources_ && prefetched_url_ == url_;
+  UMA_HISTOGRAM_BOOLEAN("Brave.CosmeticFilters.UrlCosmeticResourcesPrefetched",
+                        prefetched);
+  if (prefetched) {
+    SetResources(std::move(prefetched_resources_.value()));
+    prefetched_resources_ = absl::nullopt;
+    std::move(callback).Run();
+    return true;
   }
+  prefetched_resources_ = absl::nullopt;
+
+  // The browser may still push the resources before this request is answered.
+  on_resources_callback_ = std::move(callback);
+  TRACE_EVENT1("brave.adblock", "UrlCosmeticResources", "url", url_.spec());
+  cosmetic_filters_resources_->UrlCosmeticResources(
+      url_.spec(),
+      base::BindOnce(&CosmeticFiltersJSHandler::OnUrlCosmeticResources,
+                     base::Unretained(this), url_));
 
   return true;
 }
 
+void CosmeticFiltersJSHandler::OnPrefetchedUrlCosmeticResources(
+    const GURL& url,
+    mojom::UrlCosmeticResourcesPtr result) {
+  if (on_resources_callback_ && url == url_) {
+    SetResources(std::move(result));
+    std::move(on_resources_callback_).Run();
+    return;
+  }
+
+  prefetched_url_ = url;
+  prefetched_resources_ = std::move(result);
+}
+
 void CosmeticFiltersJSHandler::OnUrlCosmeticResources(
-    base::OnceClosure callback,
-    base::Value result) {
-  if (!EnsureConnected())
+    const GURL& url,
+    mojom::UrlCosmeticResourcesPtr result) {
+  // Either the prefetched resources won the race or the frame has navigated
+  // elsewhere since.
+  if (!on_resources_callback_ || url != url_ || !EnsureConnected())
     return;
 
-  auto* dict = result.GetIfDict();
-  if (dict)
-    resources_dict_ = std::move(*dict);
+  SetResources(std::move(result));
+  std::move(on_resources_callback_).Run();
+}
+
+void CosmeticFiltersJSHandler::SetResources(
+    mojom::UrlCosmeticResourcesPtr result) {
+  if (result) {
+    OnEngineGeneration(result->engine_generation);
+  }
+  resources_ = std::move(result);
+}
 
-  std::move(callback).Run();
+void CosmeticFiltersJSHandler::OnEngineGeneration(uint64_t engine_generation) {
+  if (engine_generation == negative_cache_engine_generation_) {
+    return;
+  }
+  // A list was updated, so names without a rule may have gained one.
+  negative_cache_engine_generation_ = engine_generation;
+  non_matching_classes_.Clear();
+  non_matching_ids_.Clear();
 }
 
 void CosmeticFiltersJSHandler::ApplyRules(bool de_amp_enabled) {
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  if (!resources_dict_ || web_frame->IsProvisional())
+  if (!resources_ || web_frame->IsProvisional())
     return;
 
   SCOPED_UMA_HISTOGRAM_TIMER_MICROS("Brave.CosmeticFilters.ApplyRules");
   TRACE_EVENT1("brave.adblock", "ApplyRules", "url", url_.spec());
 
   std::string scriptlet_script;
-  base::Value* injected_script = resources_dict_->Find("injected_script");
-  if (injected_script &&
-      base::JSONWriter::Write(*injected_script, &scriptlet_script)) {
-    scriptlet_script = base::StringPrintf(kScriptletInitScript,
-                                          de_amp_enabled ? "true" : "false",
-                                          scriptlet_script.c_str());
+  if (!resources_->injected_script.empty()) {
+    scriptlet_script = base::StringPrintf(
+        kScriptletInitScript, de_amp_enabled ? "true" : "false",
+        base::GetQuotedJSONString(resources_->injected_script).c_str());
   }
   if (!scriptlet_script.empty()) {
     web_frame->ExecuteScriptInIsolatedWorld(
@@ -429,7 +524,7 @@ void CosmeticFiltersJSHandler::ApplyRules(bool de_amp_enabled) {
   }
 
   // Working on css rules
-  generichide_ = resources_dict_->FindBool("generichide").value_or(false);
+  generichide_ = resources_->generichide;
   namespace bf = brave_shields::features;
   std::string cosmetic_filtering_init_script = base::StringPrintf(
       kCosmeticFilteringInitScript, enabled_1st_party_cf_ ? "true" : "false",
@@ -449,48 +544,35 @@ void CosmeticFiltersJSHandler::ApplyRules(bool de_amp_enabled) {
       blink::BackForwardCacheAware::kAllow);
   ExecuteObservingBundleEntryPoint();
 
-  CSSRulesRoutine(*resources_dict_);
+  CSSRulesRoutine(*resources_);
 }
 
 void CosmeticFiltersJSHandler::CSSRulesRoutine(
-    const base::Value::Dict& resources_dict) {
+    const mojom::UrlCosmeticResources& resources) {
   SCOPED_UMA_HISTOGRAM_TIMER_MICROS("Brave.CosmeticFilters.CSSRulesRoutine");
   TRACE_EVENT1("brave.adblock", "CSSRulesRoutine", "url", url_.spec());
 
   blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-  const auto* cf_exceptions_list = resources_dict.FindList("exceptions");
-  if (cf_exceptions_list) {
-    for (const auto& item : *cf_exceptions_list) {
-      DCHECK(item.is_string());
-      exceptions_.push_back(item.GetString());
-    }
-  }
+  exceptions_.insert(exceptions_.end(), resources.exceptions.begin(),
+                     resources.exceptions.end());
   // If its a vetted engine AND we're not in aggressive mode, don't apply
   // cosmetic filtering from the default engine.
-  const auto* hide_selectors_list =
+  const std::vector<std::string>* hide_selectors =
       (IsVettedSearchEngine(url_) && !enabled_1st_party_cf_)
           ? nullptr
-          : resources_dict.FindList("hide_selectors");
+          : &resources.hide_selectors;
 
   std::string stylesheet = "";
 
-  if (hide_selectors_list && !hide_selectors_list->empty()) {
+  if (hide_selectors && !hide_selectors->empty()) {
     // treat `hide_selectors` the same as `force_hide_selectors` if aggressive
     // mode is enabled.
     if (enabled_1st_party_cf_) {
-      for (auto& selector : *hide_selectors_list) {
-        DCHECK(selector.is_string());
-        stylesheet += selector.GetString() + "{display:none !important}";
-      }
+      AppendHideRules(*hide_selectors, &stylesheet);
     } else {
-      std::string json_selectors;
-      base::JSONWriter::Write(*hide_selectors_list, &json_selectors);
-      if (json_selectors.empty()) {
-        json_selectors = "[]";
-      }
       // Building a script for stylesheet modifications
       std::string new_selectors_script = base::StringPrintf(
-          kHideSelectorsInjectScript, json_selectors.c_str());
+          kHideSelectorsInjectScript, ToJSArray(*hide_selectors).c_str());
       web_frame->ExecuteScriptInIsolatedWorld(
           isolated_world_id_,
           blink::WebScriptSource(
@@ -499,29 +581,14 @@ void CosmeticFiltersJSHandler::CSSRulesRoutine(
     }
   }
 
-  const auto* force_hide_selectors_list =
-      resources_dict.FindList("force_hide_selectors");
-  if (force_hide_selectors_list) {
-    for (auto& selector : *force_hide_selectors_list) {
-      DCHECK(selector.is_string());
-      stylesheet += selector.GetString() + "{display:none !important}";
-    }
-  }
+  AppendHideRules(resources.force_hide_selectors, &stylesheet);
 
-  const auto* style_selectors_dictionary =
-      resources_dict.FindDict("style_selectors");
-  if (style_selectors_dictionary) {
-    for (const auto kv : *style_selectors_dictionary) {
-      DCHECK(kv.second.is_list());
-      std::string selector = kv.first;
-      const auto& styles = kv.second.GetList();
-      stylesheet += selector + '{';
-      for (auto& style : styles) {
-        DCHECK(style.is_string());
-        stylesheet += style.GetString() + ';';
-      }
-      stylesheet += '}';
+  for (const auto& [selector, styles] : resources.style_selectors) {
+    stylesheet += selector + '{';
+    for (const auto& style : styles) {
+      stylesheet += style + ';';
     }
+    stylesheet += '}';
   }
 
   if (!stylesheet.empty()) {
@@ -533,7 +600,43 @@ void CosmeticFiltersJSHandler::CSSRulesRoutine(
 }
 
 void CosmeticFiltersJSHandler::OnHiddenClassIdSelectors(
-    base::Value::Dict result) {
+    uint64_t document_generation,
+    std::vector<std::string> classes,
+    std::vector<std::string> ids,
+    std::vector<std::string> hide_selectors,
+    std::vector<std::string> force_hide_selectors,
+    uint64_t engine_generation) {
+  class_id_query_in_flight_ = false;
+  OnEngineGeneration(engine_generation);
+  if (document_generation != document_generation_) {
+    MaybeSendPendingClassIdQueries();
+    return;
+  }
+
+  // Generic rules are keyed by the class or id they start with, so a name
+  // that doesn't appear in any of the returned selectors has no rule. This
+  // can only over-approximate the matching names, never miss one.
+  auto is_returned = [&](const std::string& name) {
+    for (const auto* selectors : {&hide_selectors, &force_hide_selectors}) {
+      for (const auto& selector : *selectors) {
+        if (selector.find(name) != std::string::npos)
+          return true;
+      }
+    }
+    return false;
+  };
+  for (auto& name : classes) {
+    if (!is_returned(name))
+      non_matching_classes_.Put(std::move(name));
+  }
+  for (auto& name : ids) {
+    if (!is_returned(name))
+      non_matching_ids_.Put(std::move(name));
+  }
+
+  // Names that showed up in the meantime go out as a single request.
+  MaybeSendPendingClassIdQueries();
+
   if (generichide_) {
     return;
   }
@@ -542,19 +645,9 @@ void CosmeticFiltersJSHandler::OnHiddenClassIdSelectors(
       "Brave.CosmeticFilters.OnHiddenClassIdSelectors");
   TRACE_EVENT1("brave.adblock", "OnHiddenClassIdSelectors", "url", url_.spec());
 
-  base::Value::List* hide_selectors = result.FindList("hide_selectors");
-  DCHECK(hide_selectors);
-
-  base::Value::List* force_hide_selectors =
-      result.FindList("force_hide_selectors");
-  DCHECK(force_hide_selectors);
-
-  if (force_hide_selectors->size() != 0) {
+  if (!force_hide_selectors.empty()) {
     std::string stylesheet = "";
-    for (auto& selector : *force_hide_selectors) {
-      DCHECK(selector.is_string());
-      stylesheet += selector.GetString() + "{display:none !important}";
-    }
+    AppendHideRules(force_hide_selectors, &stylesheet);
     InjectStylesheet(stylesheet);
   }
 
@@ -565,22 +658,14 @@ void CosmeticFiltersJSHandler::OnHiddenClassIdSelectors(
 
   if (enabled_1st_party_cf_) {
     std::string stylesheet = "";
-    for (auto& selector : *hide_selectors) {
-      DCHECK(selector.is_string());
-      stylesheet += selector.GetString() + "{display:none !important}";
-    }
+    AppendHideRules(hide_selectors, &stylesheet);
     InjectStylesheet(stylesheet);
   } else {
     blink::WebLocalFrame* web_frame = render_frame_->GetWebFrame();
-    std::string json_selectors;
-    if (!base::JSONWriter::Write(*hide_selectors, &json_selectors) ||
-        json_selectors.empty()) {
-      json_selectors = "[]";
-    }
-    // Building a script for stylesheet modifications
-    std::string new_selectors_script =
-        base::StringPrintf(kHideSelectorsInjectScript, json_selectors.c_str());
-    if (hide_selectors->size() != 0) {
+    if (!hide_selectors.empty()) {
+      // Building a script for stylesheet modifications
+      std::string new_selectors_script = base::StringPrintf(
+          kHideSelectorsInjectScript, ToJSArray(hide_selectors).c_str());
       web_frame->ExecuteScriptInIsolatedWorld(
           isolated_world_id_,
           blink::WebScriptSource(
@@ -10,6 +10,8 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
+#include "base/containers/lru_cache.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
@@ -37,8 +39,13 @@ class CosmeticFiltersJSHandler {
   void AddJavaScriptObjectToFrame(v8::Local<v8::Context> context);
   // Fetches an initial set of resources to inject into the page if cosmetic
   // filtering is enabled, and returns whether or not to proceed with cosmetic
-  // filtering.
-  bool ProcessURL(const GURL& url, absl::optional<base::OnceClosure> callback);
+  // filtering. `callback` runs once the resources are available, which is
+  // synchronously if the browser already pushed them for `url`.
+  bool ProcessURL(const GURL& url, base::OnceClosure callback);
+  // Receives the resources the browser computed for `url` at navigation start.
+  // They may arrive either before or after `ProcessURL` for the same URL.
+  void OnPrefetchedUrlCosmeticResources(const GURL& url,
+                                        mojom::UrlCosmeticResourcesPtr result);
   void ApplyRules(bool de_amp_enabled);
 
  private:
@@ -60,12 +67,25 @@ class CosmeticFiltersJSHandler {
   void CreateWorkerObject(v8::Isolate* isolate, v8::Local<v8::Context> context);
 
   // A function to be called from JS
-  void HiddenClassIdSelectors(const std::string& input);
-
-  void OnUrlCosmeticResources(base::OnceClosure callback,
-                              base::Value result);
-  void CSSRulesRoutine(const base::Value::Dict& resources_dict);
-  void OnHiddenClassIdSelectors(base::Value::Dict result);
+  void HiddenClassIdSelectors(const std::vector<std::string>& classes,
+                              const std::vector<std::string>& ids);
+  // Sends the names queued by `HiddenClassIdSelectors`, if any, unless a
+  // request is already in flight.
+  void MaybeSendPendingClassIdQueries();
+
+  void OnUrlCosmeticResources(const GURL& url,
+                              mojom::UrlCosmeticResourcesPtr result);
+  void SetResources(mojom::UrlCosmeticResourcesPtr result);
+  void CSSRulesRoutine(const mojom::UrlCosmeticResources& resources);
+  void OnHiddenClassIdSelectors(uint64_t document_generation,
+                                std::vector<std::string> classes,
+                                std::vector<std::string> ids,
+                                std::vector<std::string> hide_selectors,
+                                std::vector<std::string> force_hide_selectors,
+                                uint64_t engine_generation);
+  // Clears the negative cache if the filter lists changed since it was
+  // filled.
+  void OnEngineGeneration(uint64_t engine_generation);
   bool OnIsFirstParty(const std::string& url_string);
   int OnEventBegin(const std::string& event_name);
   void OnEventEnd(const std::string& event_name, int);
@@ -81,7 +101,31 @@ class CosmeticFiltersJSHandler {
   bool enabled_1st_party_cf_;
   std::vector<std::string> exceptions_;
   GURL url_;
-  absl::optional<base::Value::Dict> resources_dict_;
+  mojom::UrlCosmeticResourcesPtr resources_;
+  // Runs once `resources_` has been filled in for `url_`, from either the
+  // prefetched resources or the fallback request, whichever comes first.
+  base::OnceClosure on_resources_callback_;
+  // Resources pushed by the browser ahead of the matching `ProcessURL` call.
+  GURL prefetched_url_;
+  absl::optional<mojom::UrlCosmeticResourcesPtr> prefetched_resources_;
+
+  // Bumped on every `ProcessURL` so that selectors requested for a previous
+  // document are not applied to the current one.
+  uint64_t document_generation_ = 0;
+  // Class and id names that no generic rule starts with. Kept across
+  // documents of the same host, since the exceptions that apply to it don't
+  // change, and cleared otherwise. Also cleared whenever a reply from the
+  // browser carries a new engine generation, i.e. after a list update.
+  std::string negative_cache_host_;
+  uint64_t negative_cache_engine_generation_ = 0;
+  base::HashingLRUCacheSet<std::string> non_matching_classes_;
+  base::HashingLRUCacheSet<std::string> non_matching_ids_;
+  // Names seen while a `HiddenClassIdSelectors` request was in flight. They
+  // are sent together once it is answered, so at most one request per frame
+  // is ever outstanding.
+  std::vector<std::string> pending_classes_;
+  std::vector<std::string> pending_ids_;
+  bool class_id_query_in_flight_ = false;
 
   // True if the content_cosmetic.bundle.js has injected in the current frame.
   bool bundle_injected_ = false;
@@ -14,6 +14,7 @@
 #include "brave/components/de_amp/common/features.h"
 #include "content/public/renderer/render_frame.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/blink/public/common/associated_interfaces/associated_interface_registry.h"
 #include "third_party/blink/public/platform/web_isolated_world_info.h"
 #include "third_party/blink/public/platform/web_url.h"
 #include "third_party/blink/public/web/web_local_frame.h"
@@ -61,7 +62,13 @@ CosmeticFiltersJsRenderFrameObserver::CosmeticFiltersJsRenderFrameObserver(
       native_javascript_handle_(
           new CosmeticFiltersJSHandler(render_frame, isolated_world_id)),
       get_de_amp_enabled_closure_(std::move(get_de_amp_enabled_closure)),
-      ready_(new base::OneShotEvent()) {}
+      ready_(new base::OneShotEvent()) {
+  render_frame->GetAssociatedInterfaceRegistry()
+      ->AddInterface<mojom::CosmeticFiltersAgent>(base::BindRepeating(
+          &CosmeticFiltersJsRenderFrameObserver::
+              BindCosmeticFiltersAgentReceiver,
+          base::Unretained(this)));
+}
 
 CosmeticFiltersJsRenderFrameObserver::~CosmeticFiltersJsRenderFrameObserver() =
     default;
@@ -88,17 +95,25 @@ void CosmeticFiltersJsRenderFrameObserver::ReadyToCommitNavigation(
   if (!url_.SchemeIsHTTPOrHTTPS())
     return;
 
-  if (base::FeatureList::IsEnabled(
-          ::brave_shields::features::kCosmeticFilteringSyncLoad)) {
-    if (native_javascript_handle_->ProcessURL(url_, absl::nullopt)) {
-      ready_->Signal();
-    }
-  } else {
-    native_javascript_handle_->ProcessURL(
-        url_, absl::make_optional(base::BindOnce(
-                  &CosmeticFiltersJsRenderFrameObserver::OnProcessURL,
-                  weak_factory_.GetWeakPtr())));
-  }
+  // Signals right away if the browser has already pushed the resources for
+  // this navigation; otherwise the document starts loading without them and
+  // the rules are applied as soon as they arrive.
+  native_javascript_handle_->ProcessURL(
+      url_, base::BindOnce(&CosmeticFiltersJsRenderFrameObserver::OnProcessURL,
+                           weak_factory_.GetWeakPtr()));
+}
+
+void CosmeticFiltersJsRenderFrameObserver::SetPrefetchedUrlCosmeticResources(
+    const GURL& url,
+    mojom::UrlCosmeticResourcesPtr resources) {
+  native_javascript_handle_->OnPrefetchedUrlCosmeticResources(
+      url, std::move(resources));
+}
+
+void CosmeticFiltersJsRenderFrameObserver::BindCosmeticFiltersAgentReceiver(
+    mojo::PendingAssociatedReceiver<mojom::CosmeticFiltersAgent>
+        pending_receiver) {
+  cosmetic_filters_agent_receivers_.Add(this, std::move(pending_receiver));
 }
 
 void CosmeticFiltersJsRenderFrameObserver::RunScriptsAtDocumentStart() {
@@ -10,10 +10,13 @@
 
 #include "base/memory/weak_ptr.h"
 #include "base/one_shot_event.h"
+#include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
 #include "brave/components/cosmetic_filters/renderer/cosmetic_filters_js_handler.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "content/public/renderer/render_frame_observer_tracker.h"
+#include "mojo/public/cpp/bindings/associated_receiver_set.h"
+#include "mojo/public/cpp/bindings/pending_associated_receiver.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/blink/public/web/web_navigation_type.h"
 #include "url/gurl.h"
@@ -26,7 +29,8 @@ namespace cosmetic_filters {
 class CosmeticFiltersJsRenderFrameObserver
     : public content::RenderFrameObserver,
       public content::RenderFrameObserverTracker<
-          CosmeticFiltersJsRenderFrameObserver> {
+          CosmeticFiltersJsRenderFrameObserver>,
+      public mojom::CosmeticFiltersAgent {
  public:
   CosmeticFiltersJsRenderFrameObserver(
       content::RenderFrame* render_frame,
@@ -52,7 +56,15 @@ class CosmeticFiltersJsRenderFrameObserver
 
   void RunScriptsAtDocumentStart();
 
+  // mojom::CosmeticFiltersAgent implementation.
+  void SetPrefetchedUrlCosmeticResources(
+      const GURL& url,
+      mojom::UrlCosmeticResourcesPtr resources) override;
+
  private:
+  void BindCosmeticFiltersAgentReceiver(
+      mojo::PendingAssociatedReceiver<mojom::CosmeticFiltersAgent>
+          pending_receiver);
   void OnProcessURL();
   void ApplyRules();
 
@@ -70,6 +82,9 @@ class CosmeticFiltersJsRenderFrameObserver
 
   std::unique_ptr<base::OneShotEvent> ready_;
 
+  mojo::AssociatedReceiverSet<mojom::CosmeticFiltersAgent>
+      cosmetic_filters_agent_receivers_;
+
   base::WeakPtrFactory<CosmeticFiltersJsRenderFrameObserver> weak_factory_{
       this};
 };
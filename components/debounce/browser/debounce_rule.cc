@@ -5,6 +5,7 @@
 
 #include "brave/components/debounce/browser/debounce_rule.h"
 
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -129,7 +130,7 @@ bool DebounceRule::IsSameETLDForDebounce(const GURL& url1, const GURL& url2) {
 
 // static
 base::expected<std::pair<std::vector<std::unique_ptr<DebounceRule>>,
-                         base::flat_set<std::string>>,
+                         DebounceRuleIndex>,
                std::string>
 DebounceRule::ParseRules(const std::string& contents) {
   if (contents.empty()) {
@@ -139,25 +140,52 @@ DebounceRule::ParseRules(const std::string& contents) {
   if (!root) {
     return base::unexpected("Failed to parse debounce configuration");
   }
-  std::vector<std::string> hosts;
   std::vector<std::unique_ptr<DebounceRule>> rules;
+  // The eTLD+1s each rule is indexed under, parallel to `rules`. Rules with
+  // an include pattern that isn't tied to one site are indexed under all of
+  // them, which is how they used to be applied.
+  std::vector<base::flat_set<std::string>> rule_hosts;
+  std::vector<bool> rule_is_generic;
+  std::map<std::string, std::vector<const DebounceRule*>> index;
   base::JSONValueConverter<DebounceRule> converter;
   for (base::Value& it : root->GetList()) {
     std::unique_ptr<DebounceRule> rule = std::make_unique<DebounceRule>();
     if (!converter.Convert(it, rule.get()))
       continue;
+    rule->CompileParamRegex();
+    std::vector<std::string> hosts;
+    bool is_generic = false;
     for (const URLPattern& pattern : rule->include_pattern_set()) {
-      if (!pattern.host().empty()) {
-        const std::string etldp1 =
-            DebounceRule::GetETLDForDebounce(pattern.host());
-        if (!etldp1.empty())
-          hosts.push_back(std::move(etldp1));
+      std::string etldp1 =
+          pattern.host().empty()
+              ? std::string()
+              : DebounceRule::GetETLDForDebounce(pattern.host());
+      if (etldp1.empty()) {
+        is_generic = true;
+        continue;
       }
+      index.emplace(etldp1, std::vector<const DebounceRule*>());
+      hosts.push_back(std::move(etldp1));
     }
     rules.push_back(std::move(rule));
+    rule_hosts.emplace_back(std::move(hosts));
+    rule_is_generic.push_back(is_generic);
   }
+
+  for (size_t i = 0; i < rules.size(); i++) {
+    if (rule_is_generic[i]) {
+      for (auto& [etldp1, indexed_rules] : index)
+        indexed_rules.push_back(rules[i].get());
+      continue;
+    }
+    for (const std::string& etldp1 : rule_hosts[i])
+      index[etldp1].push_back(rules[i].get());
+  }
+
   return std::pair<std::vector<std::unique_ptr<DebounceRule>>,
-                   base::flat_set<std::string>>(std::move(rules), hosts);
+                   DebounceRuleIndex>(
+      std::move(rules), DebounceRuleIndex(std::make_move_iterator(index.begin()),
+                                          std::make_move_iterator(index.end())));
 }
 
 bool DebounceRule::CheckPrefForRule(const PrefService* prefs) const {
@@ -177,29 +205,37 @@ bool DebounceRule::CheckPrefForRule(const PrefService* prefs) const {
   return true;
 }
 
-bool DebounceRule::ValidateAndParsePatternRegex(
-    const std::string& pattern,
-    const std::string& path,
-    std::string* parsed_value) const {
-  if (pattern.length() > kMaxLengthRegexPattern) {
+void DebounceRule::CompileParamRegex() {
+  if (action_ != kDebounceRegexPath)
+    return;
+
+  if (param_.length() > kMaxLengthRegexPattern) {
     VLOG(1) << "Debounce regex pattern exceeds max length: "
             << kMaxLengthRegexPattern;
-    return false;
+    return;
   }
   re2::RE2::Options options;
   options.set_max_mem(kMaxMemoryPerRegexPattern);
-  const re2::RE2 pattern_regex(pattern, options);
+  auto pattern_regex = std::make_unique<re2::RE2>(param_, options);
 
-  if (!pattern_regex.ok()) {
-    VLOG(1) << "Debounce rule has param: " << pattern
+  if (!pattern_regex->ok()) {
+    VLOG(1) << "Debounce rule has param: " << param_
             << " which is an invalid regex pattern";
-    return false;
+    return;
   }
-  if (pattern_regex.NumberOfCapturingGroups() < 1) {
-    VLOG(1) << "Debounce rule has param: " << pattern
+  if (pattern_regex->NumberOfCapturingGroups() < 1) {
+    VLOG(1) << "Debounce rule has param: " << param_
             << " which captures < 1 groups";
-    return false;
+    return;
   }
+  param_regex_ = std::move(pattern_regex);
+}
+
+bool DebounceRule::ParsePatternRegex(const std::string& path,
+                                     std::string* parsed_value) const {
+  if (!param_regex_)
+    return false;
+  const re2::RE2& pattern_regex = *param_regex_;
 
   // Get matching capture groups by applying regex to the path
   size_t number_of_capturing_groups =
@@ -258,7 +294,7 @@ bool DebounceRule::Apply(const GURL& original_url,
     // Important: Apply param regex to ONLY the path of original URL.
     auto path = original_url.path();
 
-    if (!ValidateAndParsePatternRegex(param_, path, &unescaped_value)) {
+    if (!ParsePatternRegex(path, &unescaped_value)) {
       VLOG(1) << "Debounce regex parsing failed";
       return false;
     }
@@ -11,6 +11,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/json/json_value_converter.h"
 #include "base/strings/escape.h"
@@ -21,8 +22,20 @@
 
 class GURL;
 
+namespace re2 {
+class RE2;
+}  // namespace re2
+
 namespace debounce {
 
+class DebounceRule;
+
+// Rules that may apply to a URL, keyed by the URL's eTLD+1 as returned by
+// `DebounceRule::GetETLDForDebounce`. Each list is in the order the rules
+// appear in the configuration file.
+using DebounceRuleIndex =
+    base::flat_map<std::string, std::vector<const DebounceRule*>>;
+
 enum DebounceAction {
   kDebounceNoAction,
   kDebounceRedirectToParam,
@@ -49,8 +62,10 @@ class DebounceRule {
                                   DebounceAction* field);
   static bool ParsePrependScheme(base::StringPiece value,
                                  DebouncePrependScheme* field);
+  // Returns the parsed rules along with an index over them. The index points
+  // into the returned rules, so it must not outlive them.
   static base::expected<std::pair<std::vector<std::unique_ptr<DebounceRule>>,
-                                  base::flat_set<std::string>>,
+                                  DebounceRuleIndex>,
                         std::string>
   ParseRules(const std::string& contents);
   static const std::string GetETLDForDebounce(const std::string& host);
@@ -67,15 +82,18 @@ class DebounceRule {
 
  private:
   bool CheckPrefForRule(const PrefService* prefs) const;
-  bool ValidateAndParsePatternRegex(const std::string& pattern,
-                                    const std::string& path,
-                                    std::string* parsed_value) const;
+  // Compiles `param_` for regex-path rules. Leaves `param_regex_` empty if
+  // the pattern isn't acceptable, so that the rule never applies.
+  void CompileParamRegex();
+  bool ParsePatternRegex(const std::string& path,
+                         std::string* parsed_value) const;
   extensions::URLPatternSet include_pattern_set_;
   extensions::URLPatternSet exclude_pattern_set_;
   DebounceAction action_;
   DebouncePrependScheme prepend_scheme_;
   std::string param_;
   std::string pref_;
+  std::unique_ptr<re2::RE2> param_regex_;
 };
 
 }  // namespace debounce
@@ -445,4 +445,44 @@ TEST(DebounceRuleUnitTest, CatchMultiplePathsForSameInclude) {
   }
 }
 
+TEST(DebounceRuleUnitTest, RuleIndexByETLD) {
+  const std::string contents = R"json(
+      [{
+          "include": ["*://*.tracker.com/*", "*://redirect.example.org/*"],
+          "exclude": [],
+          "action": "redirect",
+          "param": "url"
+      }, {
+          "include": ["*://*/*"],
+          "exclude": [],
+          "action": "redirect",
+          "param": "dest"
+      }, {
+          "include": ["*://other.com/*"],
+          "exclude": [],
+          "action": "redirect",
+          "param": "url"
+      }]
+      )json";
+  auto parsed = DebounceRule::ParseRules(contents);
+  ASSERT_TRUE(parsed.has_value());
+  const auto& rules = parsed.value().first;
+  const DebounceRuleIndex& index = parsed.value().second;
+  ASSERT_EQ(rules.size(), 3u);
+
+  // Host-less rules are indexed under every site, after the site's own rules
+  // that come before them in the file.
+  ASSERT_EQ(index.size(), 3u);
+  EXPECT_EQ(index.at("tracker.com"),
+            (std::vector<const DebounceRule*>{rules[0].get(),
+                                               rules[1].get()}));
+  EXPECT_EQ(index.at("example.org"),
+            (std::vector<const DebounceRule*>{rules[0].get(),
+                                               rules[1].get()}));
+  EXPECT_EQ(index.at("other.com"),
+            (std::vector<const DebounceRule*>{rules[1].get(),
+                                               rules[2].get()}));
+  EXPECT_FALSE(index.contains("brave.com"));
+}
+
 }  // namespace debounce
@@ -8,8 +8,10 @@
 #include <memory>
 #include <vector>
 
+#include "base/containers/contains.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
+#include "base/ranges/algorithm.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/task/task_runner_util.h"
@@ -22,6 +24,9 @@
 namespace brave {
 
 namespace {
+
+constexpr size_t kSanitizedURLsCacheSize = 256;
+
 bool CreateURLPatternSetFromValue(const base::Value* value,
                                   extensions::URLPatternSet* result) {
   if (!value || !value->is_list())
@@ -48,8 +53,34 @@ absl::optional<base::flat_set<std::string>> CreateParamsList(
   return result;
 }
 
-base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> ParseFromJson(
-    const std::string& json) {
+// Whether `pattern` matches every HTTP(S) URL of its host, in which case the
+// item's params can be stripped without checking the pattern again.
+bool CoversWholeHost(const URLPattern& pattern) {
+  return pattern.scheme() == "*" && pattern.port() == "*" &&
+         pattern.path() == "/*";
+}
+
+void AddToIndex(size_t index, URLSanitizerService::Matchers* matchers) {
+  const URLSanitizerService::MatchItem* item = matchers->items[index].get();
+  for (const URLPattern& pattern : item->include) {
+    URLSanitizerService::HostMatchers* host_matchers = nullptr;
+    if (pattern.host().empty()) {
+      host_matchers = &matchers->any_host;
+    } else if (pattern.match_subdomains()) {
+      host_matchers = &matchers->by_domain[pattern.host()];
+    } else {
+      host_matchers = &matchers->by_host[pattern.host()];
+    }
+
+    if (item->exclude.is_empty() && CoversWholeHost(pattern)) {
+      host_matchers->params.insert(item->params.begin(), item->params.end());
+    } else if (!base::Contains(host_matchers->conditional, index)) {
+      host_matchers->conditional.push_back(index);
+    }
+  }
+}
+
+URLSanitizerService::Matchers ParseFromJson(const std::string& json) {
   auto parsed_json = base::JSONReader::ReadAndReturnValueWithError(json);
   if (!parsed_json.has_value()) {
     VLOG(1) << "Error parsing feature JSON: " << parsed_json.error().message;
@@ -59,7 +90,7 @@ base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> ParseFromJson(
   if (!list) {
     return {};
   }
-  base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> matchers;
+  URLSanitizerService::Matchers matchers;
   for (const auto& it : *list) {
     const base::Value::Dict* items = it.GetIfDict();
     if (!items)
@@ -83,7 +114,8 @@ base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> ParseFromJson(
         std::move(include_matcher), std::move(exclude_matcher),
         std::move(*params));
 
-    matchers.insert(std::move(item));
+    matchers.items.push_back(std::move(item));
+    AddToIndex(matchers.items.size() - 1, &matchers);
   }
 
   return matchers;
@@ -91,7 +123,8 @@ base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> ParseFromJson(
 
 }  // namespace
 
-URLSanitizerService::URLSanitizerService() = default;
+URLSanitizerService::URLSanitizerService()
+    : sanitized_urls_(kSanitizedURLsCacheSize) {}
 
 URLSanitizerService::~URLSanitizerService() = default;
 
@@ -103,6 +136,18 @@ URLSanitizerService::MatchItem::MatchItem(extensions::URLPatternSet in,
                                           base::flat_set<std::string> prm)
     : include(std::move(in)), exclude(std::move(ex)), params(std::move(prm)) {}
 
+URLSanitizerService::HostMatchers::HostMatchers() = default;
+URLSanitizerService::HostMatchers::HostMatchers(HostMatchers&&) = default;
+URLSanitizerService::HostMatchers&
+URLSanitizerService::HostMatchers::operator=(HostMatchers&&) = default;
+URLSanitizerService::HostMatchers::~HostMatchers() = default;
+
+URLSanitizerService::Matchers::Matchers() = default;
+URLSanitizerService::Matchers::Matchers(Matchers&&) = default;
+URLSanitizerService::Matchers& URLSanitizerService::Matchers::operator=(
+    Matchers&&) = default;
+URLSanitizerService::Matchers::~Matchers() = default;
+
 void URLSanitizerService::Initialize(const std::string& json) {
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()}, base::BindOnce(&ParseFromJson, json),
@@ -110,32 +155,77 @@ void URLSanitizerService::Initialize(const std::string& json) {
                      weak_factory_.GetWeakPtr()));
 }
 
-void URLSanitizerService::UpdateMatchers(
-    base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> mappings) {
-  matchers_ = std::move(mappings);
+void URLSanitizerService::UpdateMatchers(Matchers matchers) {
+  matchers_ = std::move(matchers);
+  sanitized_urls_.Clear();
   if (initialization_callback_for_testing_)
     std::move(initialization_callback_for_testing_).Run();
 }
 
 GURL URLSanitizerService::SanitizeURL(const GURL& initial_url) {
-  if (matchers_.empty() || !initial_url.SchemeIsHTTPOrHTTPS())
+  if (matchers_.items.empty() || !initial_url.SchemeIsHTTPOrHTTPS())
     return initial_url;
+  if (auto cached_url = sanitized_urls_.Get(initial_url.spec()))
+    return std::move(*cached_url);
+
+  // Items that apply to every URL of their host have had their parameters
+  // unioned into the index, and those are stripped first. The remaining
+  // items are then checked in rule order against the URL as sanitized so
+  // far, like every item used to be, since their patterns may look at the
+  // query.
+  base::flat_set<std::string> params;
+  std::vector<size_t> candidates;
+  auto collect = [&](const HostMatchers& host_matchers) {
+    params.insert(host_matchers.params.begin(), host_matchers.params.end());
+    candidates.insert(candidates.end(), host_matchers.conditional.begin(),
+                      host_matchers.conditional.end());
+  };
+
+  collect(matchers_.any_host);
+  base::StringPiece host = initial_url.host_piece();
+  auto by_host = matchers_.by_host.find(host);
+  if (by_host != matchers_.by_host.end())
+    collect(by_host->second);
+  // Walk up the parent domains: a.b.example.com, b.example.com, example.com
+  // and com.
+  while (!host.empty()) {
+    auto by_domain = matchers_.by_domain.find(host);
+    if (by_domain != matchers_.by_domain.end())
+      collect(by_domain->second);
+    const size_t dot = host.find('.');
+    host = dot == base::StringPiece::npos ? base::StringPiece()
+                                          : host.substr(dot + 1);
+  }
+
   GURL url = initial_url;
-  for (const auto& it : matchers_) {
-    if (!it->include.MatchesURL(url) || it->exclude.MatchesURL(url))
+  if (!params.empty())
+    url = StripQueryParameters(url, params);
+
+  base::ranges::sort(candidates);
+  candidates.erase(base::ranges::unique(candidates), candidates.end());
+  for (size_t index : candidates) {
+    const MatchItem& item = *matchers_.items[index];
+    if (!item.include.MatchesURL(url) || item.exclude.MatchesURL(url))
       continue;
-    auto sanitized_query = StripQueryParameter(url.query(), it->params);
-    GURL::Replacements replacements;
-    if (!sanitized_query.empty()) {
-      replacements.SetQueryStr(sanitized_query);
-    } else {
-      replacements.ClearQuery();
-    }
-    url = url.ReplaceComponents(replacements);
+    url = StripQueryParameters(url, item.params);
   }
+  sanitized_urls_.Put(initial_url.spec(), url);
   return url;
 }
 
+GURL URLSanitizerService::StripQueryParameters(
+    const GURL& url,
+    const base::flat_set<std::string>& params) {
+  auto sanitized_query = StripQueryParameter(url.query(), params);
+  GURL::Replacements replacements;
+  if (!sanitized_query.empty()) {
+    replacements.SetQueryStr(sanitized_query);
+  } else {
+    replacements.ClearQuery();
+  }
+  return url.ReplaceComponents(replacements);
+}
+
 void URLSanitizerService::OnRulesReady(const std::string& json_content) {
   Initialize(json_content);
 }
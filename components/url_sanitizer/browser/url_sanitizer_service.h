@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/containers/flat_map.h"
@@ -16,6 +17,7 @@
 #include "base/gtest_prod_util.h"
 #include "base/memory/weak_ptr.h"
 #include "base/strings/string_piece.h"
+#include "brave/base/containers/sharded_lru_cache.h"
 #include "brave/components/url_sanitizer/browser/url_sanitizer_component_installer.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "extensions/common/url_pattern_set.h"
@@ -41,6 +43,41 @@ class URLSanitizerService : public KeyedService,
     base::flat_set<std::string> params;
   };
 
+  // The match items that can apply to the URLs of one host (or of any host).
+  struct HostMatchers {
+    HostMatchers();
+    HostMatchers(HostMatchers&&);
+    HostMatchers& operator=(HostMatchers&&);
+    ~HostMatchers();
+
+    // Parameters to strip from every HTTP(S) URL of the host, unioned from
+    // the items whose include pattern covers the whole host and which have no
+    // exclusions.
+    base::flat_set<std::string> params;
+    // Indices into `Matchers::items` of the items that still need their
+    // patterns checked against the URL.
+    std::vector<size_t> conditional;
+  };
+
+  // All the match items along with an index over them by include pattern
+  // host, so that sanitizing a URL only looks at the items for its host and
+  // its parent domains.
+  struct Matchers {
+    Matchers();
+    Matchers(Matchers&&);
+    Matchers& operator=(Matchers&&);
+    ~Matchers();
+
+    // In the order they appear in the rules.
+    std::vector<std::unique_ptr<MatchItem>> items;
+    // Items whose include patterns match exactly this host.
+    base::flat_map<std::string, HostMatchers> by_host;
+    // Items whose include patterns match this host and its subdomains.
+    base::flat_map<std::string, HostMatchers> by_domain;
+    // Items whose include patterns match any host.
+    HostMatchers any_host;
+  };
+
   GURL SanitizeURL(const GURL& url);
 
   void SetInitializationCallbackForTesting(base::OnceClosure callback) {
@@ -52,14 +89,19 @@ class URLSanitizerService : public KeyedService,
  protected:
   friend class URLSanitizerServiceUnitTest;
 
-  void UpdateMatchers(
-      base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>>);
+  void UpdateMatchers(Matchers matchers);
 
   std::string StripQueryParameter(const std::string& query,
                                   const base::flat_set<std::string>& trackers);
 
  private:
-  base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> matchers_;
+  GURL StripQueryParameters(const GURL& url,
+                            const base::flat_set<std::string>& params);
+
+  Matchers matchers_;
+  // Sanitized URLs by original spec, so that copying the same link again
+  // doesn't rerun every matcher. Cleared whenever the matchers change.
+  brave::ShardedLRUCache<std::string, GURL> sanitized_urls_;
   base::OnceClosure initialization_callback_for_testing_;
   base::WeakPtrFactory<URLSanitizerService> weak_factory_{this};
 };
@@ -0,0 +1,80 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "brave/components/url_sanitizer/browser/url_sanitizer_service.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+constexpr int kSanitizeCount = 20000;
+
+// One rule per host, as most of the shipped rules are, plus a catch-all.
+std::string MakeRules(int host_count) {
+  std::string rules =
+      R"([{"include": ["*://*/*"], "params": ["utm_source", "utm_medium"]})";
+  for (int i = 0; i < host_count; i++) {
+    base::StringAppendF(
+        &rules,
+        R"(, {"include": ["*://*.host%d.com/*"], "params": ["p%d"]})"
+        R"(, {"include": ["https://www.host%d.com/page/*"],)"
+        R"( "exclude": ["https://www.host%d.com/page/keep/*"],)"
+        R"( "params": ["q%d"]})",
+        i, i, i, i, i);
+  }
+  return rules + "]";
+}
+
+}  // namespace
+
+class URLSanitizerServicePerfTest : public testing::Test {
+ protected:
+  void RunBenchmark(int host_count) {
+    URLSanitizerService service;
+    base::RunLoop loop;
+    service.SetInitializationCallbackForTesting(loop.QuitClosure());
+    service.Initialize(MakeRules(host_count));
+    loop.Run();
+
+    // Every URL is distinct so that none of them is served from the cache of
+    // sanitized URLs.
+    const base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kSanitizeCount; i++) {
+      const GURL url(base::StringPrintf(
+          "https://www.host%d.com/page/%d?utm_source=x&p%d=1&keep=1",
+          i % host_count, i, i % host_count));
+      EXPECT_EQ(service.SanitizeURL(url).query(), "keep=1");
+    }
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+    perf_test::PerfResultReporter reporter(
+        "URLSanitizer", base::NumberToString(host_count) + "_hosts");
+    reporter.RegisterImportantMetric(".sanitize_time", "us");
+    reporter.AddResult(".sanitize_time",
+                       elapsed.InMicrosecondsF() / kSanitizeCount);
+  }
+
+ private:
+  base::test::TaskEnvironment task_environment_;
+};
+
+// The time per URL should stay flat as the number of rules grows.
+TEST_F(URLSanitizerServicePerfTest, SanitizeURL) {
+  for (int host_count : {10, 100, 1000, 10000}) {
+    RunBenchmark(host_count);
+  }
+}
+
+}  // namespace brave
@@ -5,6 +5,7 @@
 
 #include "brave/components/url_sanitizer/browser/url_sanitizer_service.h"
 
+#include <string>
 #include <vector>
 
 #include "base/containers/flat_set.h"
@@ -66,6 +67,8 @@ class URLSanitizerServiceUnitTest : public testing::Test,
     loop.Run();
   }
 
+  const Matchers& matchers() const { return matchers_; }
+
  private:
   base::test::TaskEnvironment task_environment_;
 };
@@ -128,6 +131,10 @@ TEST_F(URLSanitizerServiceUnitTest, ClearURLS) {
     { "include": [ "*://*.twitter.com/*"], "params": ["t"] }
   ])");
 
+  // Results from the previous rules are not reused.
+  EXPECT_EQ(SanitizeURL(GURL("https://brave.com/?query=removethis")),
+            GURL("https://brave.com/?query=removethis"));
+
   EXPECT_EQ(
       SanitizeURL(
           GURL("https://twitter.com/post/?utm_content=removethis&e=&t=g&=end")),
@@ -154,4 +161,83 @@ TEST_F(URLSanitizerServiceUnitTest, ClearURLS) {
             GURL("ws://localhost:8080/?utm_source=web"));
 }
 
+TEST_F(URLSanitizerServiceUnitTest, IndexesItemsByHost) {
+  WaitInitialization(R"([
+    { "include": [ "*://*/*" ], "params": ["any"] },
+    { "include": [ "*://example.com/*" ], "params": ["host"] },
+    { "include": [ "*://*.example.com/*" ], "params": ["domain"] },
+    { "include": [ "https://example.com/*" ], "params": ["https"] },
+    { "include": [ "*://example.com/path/*" ], "params": ["path"] },
+    {
+      "include": [ "*://*.example.org/*", "*://example.net/*" ],
+      "exclude": [ "*://example.net/keep/*" ],
+      "params": ["excluded"]
+    }
+  ])");
+
+  const Matchers& index = matchers();
+  ASSERT_EQ(index.items.size(), 6u);
+
+  // Items covering every URL of their host are unioned into the index.
+  EXPECT_EQ(index.any_host.params, base::flat_set<std::string>({"any"}));
+  EXPECT_TRUE(index.any_host.conditional.empty());
+  ASSERT_TRUE(index.by_host.contains("example.com"));
+  const HostMatchers& example_com = index.by_host.at("example.com");
+  EXPECT_EQ(example_com.params, base::flat_set<std::string>({"host"}));
+  ASSERT_TRUE(index.by_domain.contains("example.com"));
+  EXPECT_EQ(index.by_domain.at("example.com").params,
+            base::flat_set<std::string>({"domain"}));
+
+  // The rest keep their rule order and are checked per URL.
+  EXPECT_EQ(example_com.conditional, std::vector<size_t>({3, 4}));
+
+  // Every include pattern indexes the item, exclusions make it conditional.
+  ASSERT_TRUE(index.by_domain.contains("example.org"));
+  EXPECT_TRUE(index.by_domain.at("example.org").params.empty());
+  EXPECT_EQ(index.by_domain.at("example.org").conditional,
+            std::vector<size_t>({5}));
+  ASSERT_TRUE(index.by_host.contains("example.net"));
+  EXPECT_EQ(index.by_host.at("example.net").conditional,
+            std::vector<size_t>({5}));
+  EXPECT_FALSE(index.by_host.contains("example.org"));
+}
+
+TEST_F(URLSanitizerServiceUnitTest, MatchesHostAndParentDomains) {
+  WaitInitialization(R"([
+    { "include": [ "*://*.example.com/*" ], "params": ["domain"] },
+    { "include": [ "*://b.example.com/*" ], "params": ["host"] },
+    { "include": [ "http://a.b.example.com/*" ], "params": ["http"] }
+  ])");
+
+  EXPECT_EQ(SanitizeURL(GURL("https://a.b.example.com/?domain=1&host=2&http=3"
+                             "&keep=4")),
+            GURL("https://a.b.example.com/?host=2&http=3&keep=4"));
+  EXPECT_EQ(SanitizeURL(GURL("http://a.b.example.com/?domain=1&host=2&http=3"
+                             "&keep=4")),
+            GURL("http://a.b.example.com/?host=2&keep=4"));
+  EXPECT_EQ(
+      SanitizeURL(GURL("https://b.example.com/?domain=1&host=2&keep=4")),
+      GURL("https://b.example.com/?keep=4"));
+  EXPECT_EQ(SanitizeURL(GURL("https://example.com/?domain=1&keep=4")),
+            GURL("https://example.com/?keep=4"));
+  EXPECT_EQ(SanitizeURL(GURL("https://notexample.com/?domain=1&keep=4")),
+            GURL("https://notexample.com/?domain=1&keep=4"));
+}
+
+TEST_F(URLSanitizerServiceUnitTest, MatchesURLAsSanitizedSoFar) {
+  // The second item is excluded for URLs that still carry `utm`, which the
+  // first item strips before it is checked.
+  WaitInitialization(R"([
+    { "include": [ "https://example.com/*" ], "params": ["utm"] },
+    {
+      "include": [ "https://example.com/*" ],
+      "exclude": [ "https://example.com/*utm=*" ],
+      "params": ["ref"]
+    }
+  ])");
+
+  EXPECT_EQ(SanitizeURL(GURL("https://example.com/?utm=1&ref=2&keep=3")),
+            GURL("https://example.com/?keep=3"));
+}
+
 }  // namespace brave
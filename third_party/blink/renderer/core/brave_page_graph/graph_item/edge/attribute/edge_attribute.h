@@ -16,7 +16,7 @@ namespace brave_page_graph {
 class NodeActor;
 class NodeHTMLElement;
 
-class EdgeAttribute : public GraphEdge {
+class CORE_EXPORT EdgeAttribute : public GraphEdge {
  public:
   EdgeAttribute(GraphItemContext* context,
                 NodeActor* out_node,
@@ -16,7 +16,7 @@ namespace brave_page_graph {
 class NodeActor;
 class NodeHTMLElement;
 
-class EdgeAttributeSet final : public EdgeAttribute {
+class CORE_EXPORT EdgeAttributeSet final : public EdgeAttribute {
  public:
   EdgeAttributeSet(GraphItemContext* context,
                    NodeActor* out_node,
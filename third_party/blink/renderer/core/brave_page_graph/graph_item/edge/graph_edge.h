@@ -13,7 +13,7 @@ namespace brave_page_graph {
 
 class GraphNode;
 
-class GraphEdge : public GraphItem {
+class CORE_EXPORT GraphEdge : public GraphItem {
  public:
   GraphEdge(GraphItemContext* context, GraphNode* out_node, GraphNode* in_node);
 
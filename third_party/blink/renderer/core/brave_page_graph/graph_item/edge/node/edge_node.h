@@ -14,7 +14,7 @@ namespace brave_page_graph {
 class NodeActor;
 class NodeHTML;
 
-class EdgeNode : public GraphEdge {
+class CORE_EXPORT EdgeNode : public GraphEdge {
  public:
   EdgeNode(GraphItemContext* context, NodeActor* out_node, NodeHTML* in_node);
   ~EdgeNode() override;
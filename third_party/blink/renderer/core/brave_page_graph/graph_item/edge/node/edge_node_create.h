@@ -14,7 +14,7 @@ namespace brave_page_graph {
 class NodeActor;
 class NodeHTML;
 
-class EdgeNodeCreate final : public EdgeNode {
+class CORE_EXPORT EdgeNodeCreate final : public EdgeNode {
  public:
   EdgeNodeCreate(GraphItemContext* context,
                  NodeActor* out_node,
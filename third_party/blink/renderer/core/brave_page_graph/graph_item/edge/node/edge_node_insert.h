@@ -15,7 +15,7 @@ class NodeActor;
 class NodeHTML;
 class NodeHTMLElement;
 
-class EdgeNodeInsert final : public EdgeNode {
+class CORE_EXPORT EdgeNodeInsert final : public EdgeNode {
  public:
   EdgeNodeInsert(GraphItemContext* context,
                  NodeActor* out_node,
@@ -16,7 +16,7 @@ namespace brave_page_graph {
 
 class GraphItemContext;
 
-class GraphItem {
+class CORE_EXPORT GraphItem {
  public:
   explicit GraphItem(GraphItemContext* context);
   virtual ~GraphItem();
@@ -0,0 +1,60 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/graph_item_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/containers/adapters.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/graph_item.h"
+
+namespace brave_page_graph {
+
+namespace {
+
+constexpr size_t kBlockSize = 64 * 1024;
+
+}  // namespace
+
+GraphItemArena::GraphItemArena() = default;
+
+GraphItemArena::~GraphItemArena() {
+  for (auto* graph_item : base::Reversed(graph_items_)) {
+    graph_item->~GraphItem();
+  }
+}
+
+void* GraphItemArena::Allocate(const size_t size, const size_t alignment) {
+  DCHECK_GT(alignment, 0u);
+  DCHECK_LE(alignment, alignof(std::max_align_t));
+
+  size_t padding =
+      (alignment - reinterpret_cast<uintptr_t>(block_pos_) % alignment) %
+      alignment;
+  if (!block_pos_ || padding + size > block_remaining_) {
+    // Graph items larger than a block get a block of their own.
+    const size_t block_size = std::max(size, kBlockSize);
+    blocks_.push_back(std::unique_ptr<char[]>(new char[block_size]));
+    block_pos_ = blocks_.back().get();
+    block_remaining_ = block_size;
+    padding = 0;
+  }
+
+  void* const storage = block_pos_ + padding;
+  block_pos_ += padding + size;
+  block_remaining_ -= padding + size;
+
+  return storage;
+}
+
+void GraphItemArena::Add(GraphItem* graph_item) {
+  DCHECK(graph_item);
+  graph_items_.push_back(graph_item);
+}
+
+}  // namespace brave_page_graph
@@ -0,0 +1,52 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_CORE_BRAVE_PAGE_GRAPH_GRAPH_ITEM_GRAPH_ITEM_ARENA_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_CORE_BRAVE_PAGE_GRAPH_GRAPH_ITEM_GRAPH_ITEM_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "third_party/blink/renderer/core/core_export.h"
+
+namespace brave_page_graph {
+
+class GraphItem;
+
+// Owns the graph items of a page graph. Graph items are never removed from a
+// graph, so they are bump allocated from large blocks rather than allocated
+// one by one, and are destroyed together with the arena.
+class CORE_EXPORT GraphItemArena final {
+ public:
+  GraphItemArena();
+
+  GraphItemArena(const GraphItemArena&) = delete;
+  GraphItemArena& operator=(const GraphItemArena&) = delete;
+
+  ~GraphItemArena();
+
+  // Returns uninitialized storage for a graph item, which stays valid until
+  // the arena is destroyed.
+  void* Allocate(size_t size, size_t alignment);
+
+  // Takes ownership of |graph_item|, which must have been constructed in
+  // storage returned by |Allocate|. Graph items are destroyed in the reverse
+  // order they were added.
+  void Add(GraphItem* graph_item);
+
+  size_t size() const { return graph_items_.size(); }
+
+ private:
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* block_pos_ = nullptr;
+  size_t block_remaining_ = 0;
+
+  std::vector<GraphItem*> graph_items_;
+};
+
+}  // namespace brave_page_graph
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_CORE_BRAVE_PAGE_GRAPH_GRAPH_ITEM_GRAPH_ITEM_ARENA_H_
@@ -0,0 +1,140 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/graph_item_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "base/memory/raw_ptr.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/graph_item.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/graph_item_context.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_page_graph {
+
+namespace {
+
+constexpr size_t kBlockSize = 64 * 1024;
+
+class TestGraphItemContext : public GraphItemContext {
+ public:
+  base::TimeTicks GetGraphStartTime() const override { return start_time_; }
+  GraphItemId GetNextGraphItemId() override { return ++id_counter_; }
+
+ private:
+  const base::TimeTicks start_time_ = base::TimeTicks::Now();
+  GraphItemId id_counter_ = 0;
+};
+
+// Records its id in |destroyed_ids| when destroyed.
+template <size_t kPayloadSize>
+class TestGraphItem : public GraphItem {
+ public:
+  TestGraphItem(GraphItemContext* context,
+                std::vector<GraphItemId>* destroyed_ids)
+      : GraphItem(context), destroyed_ids_(destroyed_ids) {}
+  ~TestGraphItem() override { destroyed_ids_->push_back(GetId()); }
+
+  ItemName GetItemName() const override { return "test item"; }
+  GraphMLId GetGraphMLId() const override { return "t"; }
+  void AddGraphMLTag(xmlDocPtr doc, xmlNodePtr parent_node) const override {}
+
+  const char* payload() const { return payload_; }
+
+ private:
+  raw_ptr<std::vector<GraphItemId>> destroyed_ids_;
+  char payload_[kPayloadSize];
+};
+
+template <typename T>
+T* AddTestItem(GraphItemArena* arena,
+               GraphItemContext* context,
+               std::vector<GraphItemId>* destroyed_ids) {
+  T* item =
+      new (arena->Allocate(sizeof(T), alignof(T))) T(context, destroyed_ids);
+  arena->Add(item);
+  return item;
+}
+
+bool IsAligned(const void* ptr, size_t alignment) {
+  return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+}  // namespace
+
+TEST(GraphItemArenaTest, AllocationsAreAlignedAndDisjoint) {
+  GraphItemArena arena;
+
+  char* const first = static_cast<char*>(arena.Allocate(1, 1));
+  char* const second = static_cast<char*>(arena.Allocate(8, 8));
+  char* const third = static_cast<char*>(arena.Allocate(3, 4));
+
+  EXPECT_TRUE(IsAligned(second, 8));
+  EXPECT_TRUE(IsAligned(third, 4));
+  EXPECT_GT(second, first);
+  EXPECT_GE(third, second + 8);
+}
+
+TEST(GraphItemArenaTest, RollsOverToNewBlock) {
+  GraphItemArena arena;
+
+  // Fill most of the first block, then ask for more than what is left.
+  char* const first = static_cast<char*>(arena.Allocate(kBlockSize - 16, 1));
+  char* const second = static_cast<char*>(arena.Allocate(32, 8));
+  EXPECT_TRUE(IsAligned(second, 8));
+  EXPECT_TRUE(second < first || second >= first + kBlockSize - 16);
+
+  // The new block is used for the following allocations.
+  char* const third = static_cast<char*>(arena.Allocate(32, 8));
+  EXPECT_EQ(second + 32, third);
+}
+
+TEST(GraphItemArenaTest, OversizedAllocationGetsOwnBlock) {
+  GraphItemArena arena;
+
+  char* const small = static_cast<char*>(arena.Allocate(16, 8));
+  char* const large = static_cast<char*>(arena.Allocate(kBlockSize * 2, 8));
+  ASSERT_TRUE(large);
+  // The whole oversized allocation is writable.
+  large[0] = 1;
+  large[kBlockSize * 2 - 1] = 1;
+
+  char* const next = static_cast<char*>(arena.Allocate(16, 8));
+  EXPECT_NE(small, next);
+  EXPECT_TRUE(next < large || next >= large + kBlockSize * 2);
+}
+
+TEST(GraphItemArenaTest, DestroysItemsInReverseOrder) {
+  TestGraphItemContext context;
+  std::vector<GraphItemId> destroyed_ids;
+  std::vector<GraphItemId> added_ids;
+
+  {
+    GraphItemArena arena;
+    // Mix small and large items so that they span several blocks.
+    for (int i = 0; i < 100; ++i) {
+      if (i % 10 == 0) {
+        added_ids.push_back(AddTestItem<TestGraphItem<kBlockSize>>(
+                                &arena, &context, &destroyed_ids)
+                                ->GetId());
+      } else {
+        added_ids.push_back(AddTestItem<TestGraphItem<1024>>(&arena, &context,
+                                                             &destroyed_ids)
+                                ->GetId());
+      }
+    }
+    EXPECT_EQ(100u, arena.size());
+    EXPECT_TRUE(destroyed_ids.empty());
+  }
+
+  ASSERT_EQ(added_ids.size(), destroyed_ids.size());
+  EXPECT_TRUE(std::equal(added_ids.rbegin(), added_ids.rend(),
+                         destroyed_ids.begin()));
+}
+
+}  // namespace brave_page_graph
@@ -11,7 +11,7 @@
 
 namespace brave_page_graph {
 
-class NodeActor : public GraphNode {
+class CORE_EXPORT NodeActor : public GraphNode {
  public:
   explicit NodeActor(GraphItemContext* context);
   ~NodeActor() override;
@@ -11,7 +11,7 @@
 
 namespace brave_page_graph {
 
-class NodeParser final : public NodeActor {
+class CORE_EXPORT NodeParser final : public NodeActor {
  public:
   explicit NodeParser(GraphItemContext* context);
   ~NodeParser() override;
@@ -13,7 +13,7 @@ namespace brave_page_graph {
 
 class GraphEdge;
 
-class GraphNode : public GraphItem {
+class CORE_EXPORT GraphNode : public GraphItem {
  public:
   explicit GraphNode(GraphItemContext* context);
 
@@ -13,7 +13,7 @@ namespace brave_page_graph {
 
 class NodeHTMLElement;
 
-class NodeHTML : public GraphNode {
+class CORE_EXPORT NodeHTML : public GraphNode {
  public:
   NodeHTML(GraphItemContext* context, const blink::DOMNodeId dom_node_id);
   ~NodeHTML() override;
@@ -17,7 +17,7 @@ namespace brave_page_graph {
 
 class EdgeEventListenerAdd;
 
-class NodeHTMLElement : public NodeHTML {
+class CORE_EXPORT NodeHTMLElement : public NodeHTML {
  public:
   NodeHTMLElement(GraphItemContext* context,
                   const blink::DOMNodeId dom_node_id,
@@ -13,7 +13,7 @@
 
 namespace brave_page_graph {
 
-class NodeHTMLText final : public NodeHTML {
+class CORE_EXPORT NodeHTMLText final : public NodeHTML {
  public:
   NodeHTMLText(GraphItemContext* context,
                const blink::DOMNodeId dom_node_id,
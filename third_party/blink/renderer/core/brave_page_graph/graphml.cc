@@ -7,19 +7,112 @@
 
 #include <libxml/entities.h>
 #include <libxml/tree.h>
+#include <libxml/xmlsave.h>
 
 #include <map>
 #include <string>
 #include <vector>
 
+#include "base/check_op.h"
+#include "base/files/file.h"
 #include "base/no_destructor.h"
+#include "base/strings/strcat.h"
 #include "base/strings/string_number_conversions.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/edge/graph_edge.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/node/graph_node.h"
 #include "brave/third_party/blink/renderer/core/brave_page_graph/types.h"
 
 namespace brave_page_graph {
 
 namespace {
+
 uint32_t graphml_index = 0;
+
+constexpr char kPageGraphVersion[] = "0.3.0";
+constexpr char kPageGraphUrl[] =
+    "https://github.com/brave/brave-browser/wiki/PageGraph";
+constexpr char kGraphItemsPlaceholder[] = "page-graph-items";
+
+// Returns the length of the UTF-8 sequence started by |lead_byte|, or 1 if it
+// does not start one.
+size_t Utf8SequenceLength(const unsigned char lead_byte) {
+  if ((lead_byte & 0xE0) == 0xC0) {
+    return 2;
+  }
+  if ((lead_byte & 0xF0) == 0xE0) {
+    return 3;
+  }
+  if ((lead_byte & 0xF8) == 0xF0) {
+    return 4;
+  }
+  return 1;
+}
+
+int WriteGraphMLChunk(void* context, const char* buffer, int len) {
+  static_cast<GraphMLSink*>(context)->Write(base::StringPiece(buffer, len));
+  return len;
+}
+
+// Serializes the GraphML tags added to |parent_node| and frees them.
+void SaveAndFreeChildNodes(xmlSaveCtxtPtr save_ctxt, xmlNodePtr parent_node) {
+  xmlNodePtr child_node = parent_node->children;
+  while (child_node) {
+    xmlNodePtr next_node = child_node->next;
+    xmlSaveTree(save_ctxt, child_node);
+    xmlUnlinkNode(child_node);
+    xmlFreeNode(child_node);
+    child_node = next_node;
+  }
+}
+
+}  // namespace
+
+StringGraphMLSink::StringGraphMLSink() = default;
+
+StringGraphMLSink::~StringGraphMLSink() = default;
+
+void StringGraphMLSink::Write(base::StringPiece chunk) {
+  std::string joined_chunk;
+  if (!partial_sequence_.empty()) {
+    joined_chunk = base::StrCat({partial_sequence_, chunk});
+    chunk = joined_chunk;
+  }
+
+  // Hold back a UTF-8 sequence cut off at the end of the chunk, as it cannot
+  // be decoded until the rest of it is written.
+  size_t complete_size = chunk.size();
+  for (size_t i = 1; i <= 3 && i <= chunk.size(); i++) {
+    const unsigned char byte = chunk[chunk.size() - i];
+    if ((byte & 0xC0) == 0x80) {
+      continue;
+    }
+    if (Utf8SequenceLength(byte) > i) {
+      complete_size = chunk.size() - i;
+    }
+    break;
+  }
+
+  builder_.Append(String::FromUTF8(chunk.data(), complete_size));
+  partial_sequence_ = std::string(chunk.substr(complete_size));
+}
+
+String StringGraphMLSink::TakeString() {
+  DCHECK(partial_sequence_.empty());
+  return builder_.ReleaseString();
+}
+
+FileGraphMLSink::FileGraphMLSink(base::File* file) : file_(file) {
+  DCHECK(file_);
+}
+
+FileGraphMLSink::~FileGraphMLSink() = default;
+
+void FileGraphMLSink::Write(base::StringPiece chunk) {
+  if (!succeeded_) {
+    return;
+  }
+  const int size = static_cast<int>(chunk.size());
+  succeeded_ = file_->WriteAtCurrentPos(chunk.data(), size) == size;
 }
 
 GraphMLAttr::GraphMLAttr(const GraphMLAttrForType for_value,
@@ -217,4 +310,97 @@ const GraphMLAttr* GraphMLAttrDefForType(const GraphMLAttrDef type) {
   return it->second;
 }
 
+void WriteGraphML(const bool is_root_frame,
+                  const std::string& frame_id,
+                  const base::TimeDelta duration,
+                  const NodeList& nodes,
+                  const EdgeList& edges,
+                  GraphMLSink* sink) {
+  DCHECK(sink);
+
+  xmlDocPtr graphml_doc = xmlNewDoc(BAD_CAST "1.0");
+  xmlNodePtr graphml_root_node = xmlNewNode(nullptr, BAD_CAST "graphml");
+  xmlDocSetRootElement(graphml_doc, graphml_root_node);
+
+  xmlNewNs(graphml_root_node, BAD_CAST "http://graphml.graphdrawing.org/xmlns",
+           nullptr);
+  xmlNsPtr xsi_ns = xmlNewNs(
+      graphml_root_node, BAD_CAST "http://www.w3.org/2001/XMLSchema-instance",
+      BAD_CAST "xsi");
+  xmlNewNsProp(graphml_root_node, xsi_ns, BAD_CAST "schemaLocation",
+               BAD_CAST
+               "http://graphml.graphdrawing.org/xmlns "
+               "http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd");
+
+  xmlNodePtr desc_container_node =
+      xmlNewChild(graphml_root_node, nullptr, BAD_CAST "desc", nullptr);
+  xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "version",
+                  BAD_CAST kPageGraphVersion);
+  xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "about",
+                  BAD_CAST kPageGraphUrl);
+  xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "is_root",
+                  BAD_CAST(is_root_frame ? "true" : "false"));
+  xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "frame_id",
+                  BAD_CAST frame_id.c_str());
+
+  xmlNodePtr time_container_node =
+      xmlNewChild(desc_container_node, nullptr, BAD_CAST "time", nullptr);
+
+  xmlNewTextChild(time_container_node, nullptr, BAD_CAST "start",
+                  BAD_CAST base::NumberToString(0).c_str());
+  xmlNewTextChild(
+      time_container_node, nullptr, BAD_CAST "end",
+      BAD_CAST base::NumberToString(duration.InMilliseconds()).c_str());
+
+  for (const auto& graphml_attr : GetGraphMLAttrs()) {
+    graphml_attr.second->AddDefinitionNode(graphml_root_node);
+  }
+
+  xmlNodePtr graph_node =
+      xmlNewChild(graphml_root_node, nullptr, BAD_CAST "graph", nullptr);
+  xmlSetProp(graph_node, BAD_CAST "id", BAD_CAST "G");
+  xmlSetProp(graph_node, BAD_CAST "edgedefault", BAD_CAST "directed");
+
+  // Serialize the document around a placeholder for the graph items, which are
+  // then serialized in its place one at a time.
+  xmlNodePtr placeholder_node =
+      xmlAddChild(graph_node, xmlNewComment(BAD_CAST kGraphItemsPlaceholder));
+
+  xmlChar* xml_string;
+  int size;
+  xmlDocDumpMemoryEnc(graphml_doc, &xml_string, &size, "UTF-8");
+  const base::StringPiece graphml_string(reinterpret_cast<char*>(xml_string),
+                                         size);
+
+  xmlUnlinkNode(placeholder_node);
+  xmlFreeNode(placeholder_node);
+
+  const std::string placeholder =
+      base::StrCat({"<!--", kGraphItemsPlaceholder, "-->"});
+  const size_t placeholder_pos = graphml_string.find(placeholder);
+  CHECK_NE(placeholder_pos, base::StringPiece::npos);
+
+  sink->Write(graphml_string.substr(0, placeholder_pos));
+
+  xmlSaveCtxtPtr save_ctxt =
+      xmlSaveToIO(&WriteGraphMLChunk, nullptr, sink, "UTF-8", 0);
+  CHECK(save_ctxt);
+
+  for (const auto* node : nodes) {
+    node->AddGraphMLTag(graphml_doc, graph_node);
+    SaveAndFreeChildNodes(save_ctxt, graph_node);
+  }
+  for (const auto* edge : edges) {
+    edge->AddGraphMLTag(graphml_doc, graph_node);
+    SaveAndFreeChildNodes(save_ctxt, graph_node);
+  }
+
+  xmlSaveClose(save_ctxt);
+
+  sink->Write(graphml_string.substr(placeholder_pos + placeholder.size()));
+
+  xmlFree(xml_string);
+  xmlFreeDoc(graphml_doc);
+}
+
 }  // namespace brave_page_graph
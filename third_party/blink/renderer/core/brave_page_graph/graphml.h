@@ -11,11 +11,62 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/memory/raw_ptr.h"
+#include "base/strings/string_piece.h"
 #include "base/time/time.h"
 #include "brave/third_party/blink/renderer/core/brave_page_graph/types.h"
+#include "third_party/blink/renderer/core/core_export.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
+#include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
+
+namespace base {
+class File;
+}  // namespace base
 
 namespace brave_page_graph {
 
+// Receives a GraphML document in chunks as it is serialized.
+class GraphMLSink {
+ public:
+  virtual ~GraphMLSink() = default;
+
+  virtual void Write(base::StringPiece chunk) = 0;
+};
+
+// Decodes the document into a String as it is written, so that it is never
+// held in memory as UTF-8 and as a String at the same time.
+class CORE_EXPORT StringGraphMLSink final : public GraphMLSink {
+ public:
+  StringGraphMLSink();
+  ~StringGraphMLSink() override;
+
+  void Write(base::StringPiece chunk) override;
+
+  // Returns the decoded document and resets the sink.
+  String TakeString();
+
+ private:
+  StringBuilder builder_;
+  // The start of a UTF-8 sequence that continues in the next chunk.
+  std::string partial_sequence_;
+};
+
+// Writes the document to |file| as it is serialized.
+class CORE_EXPORT FileGraphMLSink final : public GraphMLSink {
+ public:
+  explicit FileGraphMLSink(base::File* file);
+  ~FileGraphMLSink() override;
+
+  void Write(base::StringPiece chunk) override;
+
+  // Whether every chunk so far was written in full.
+  bool succeeded() const { return succeeded_; }
+
+ private:
+  raw_ptr<base::File> file_;
+  bool succeeded_ = true;
+};
+
 class GraphMLAttr {
  public:
   GraphMLAttr(const GraphMLAttrForType for_value,
@@ -60,6 +111,15 @@ using GraphMLAttrs = base::flat_map<GraphMLAttrDef, const GraphMLAttr*>;
 const GraphMLAttrs& GetGraphMLAttrs();
 const GraphMLAttr* GraphMLAttrDefForType(const GraphMLAttrDef type);
 
+// Serializes a graph to |sink| one graph item at a time, so the whole GraphML
+// document is never held in memory as an XML tree.
+CORE_EXPORT void WriteGraphML(const bool is_root_frame,
+                              const std::string& frame_id,
+                              const base::TimeDelta duration,
+                              const NodeList& nodes,
+                              const EdgeList& edges,
+                              GraphMLSink* sink);
+
 }  // namespace brave_page_graph
 
 #endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_CORE_BRAVE_PAGE_GRAPH_GRAPHML_H_
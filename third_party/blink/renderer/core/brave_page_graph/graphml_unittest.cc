@@ -0,0 +1,234 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graphml.h"
+
+#include <libxml/tree.h>
+
+#include <string>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/edge/attribute/edge_attribute_set.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/edge/node/edge_node_create.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/edge/node/edge_node_insert.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/graph_item_arena.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/node/actor/node_parser.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/node/html/node_html_element.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/node/html/node_html_text.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/page_graph_context.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_page_graph {
+
+namespace {
+
+constexpr char kFrameId[] = "F1";
+constexpr base::TimeDelta kDuration = base::Milliseconds(1234);
+
+class TestPageGraphContext : public PageGraphContext {
+ public:
+  base::TimeTicks GetGraphStartTime() const override { return start_time_; }
+  GraphItemId GetNextGraphItemId() override { return ++id_counter_; }
+
+  void* AllocateGraphItem(size_t size, size_t alignment) override {
+    return graph_items_.Allocate(size, alignment);
+  }
+
+  void AddGraphItem(GraphItem* graph_item) override {
+    graph_items_.Add(graph_item);
+    if (auto* graph_node = DynamicTo<GraphNode>(graph_item)) {
+      nodes_.push_back(graph_node);
+    } else if (auto* graph_edge = DynamicTo<GraphEdge>(graph_item)) {
+      graph_edge->GetInNode()->AddInEdge(graph_edge);
+      graph_edge->GetOutNode()->AddOutEdge(graph_edge);
+      edges_.push_back(graph_edge);
+    }
+  }
+
+  const NodeList& nodes() const { return nodes_; }
+  const EdgeList& edges() const { return edges_; }
+
+ private:
+  const base::TimeTicks start_time_ = base::TimeTicks::Now();
+  GraphItemId id_counter_ = 0;
+
+  GraphItemArena graph_items_;
+  NodeList nodes_;
+  EdgeList edges_;
+};
+
+// Collects the document and counts the chunks it is written in.
+class TestGraphMLSink : public GraphMLSink {
+ public:
+  void Write(base::StringPiece chunk) override {
+    graphml_.append(chunk.data(), chunk.size());
+    chunk_count_++;
+  }
+
+  const std::string& graphml() const { return graphml_; }
+  int chunk_count() const { return chunk_count_; }
+
+ private:
+  std::string graphml_;
+  int chunk_count_ = 0;
+};
+
+// Serializes the graph the way PageGraph::ToGraphML did before it streamed:
+// by building the whole XML tree and dumping it at once.
+std::string SerializeGraphAsTree(const NodeList& nodes,
+                                const EdgeList& edges) {
+  xmlDocPtr graphml_doc = xmlNewDoc(BAD_CAST "1.0");
+  xmlNodePtr graphml_root_node = xmlNewNode(nullptr, BAD_CAST "graphml");
+  xmlDocSetRootElement(graphml_doc, graphml_root_node);
+
+  xmlNewNs(graphml_root_node, BAD_CAST "http://graphml.graphdrawing.org/xmlns",
+           nullptr);
+  xmlNsPtr xsi_ns = xmlNewNs(
+      graphml_root_node, BAD_CAST "http://www.w3.org/2001/XMLSchema-instance",
+      BAD_CAST "xsi");
+  xmlNewNsProp(graphml_root_node, xsi_ns, BAD_CAST "schemaLocation",
+               BAD_CAST
+               "http://graphml.graphdrawing.org/xmlns "
+               "http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd");
+
+  xmlNodePtr desc_container_node =
+      xmlNewChild(graphml_root_node, nullptr, BAD_CAST "desc", nullptr);
+  xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "version",
+                  BAD_CAST "0.3.0");
+  xmlNewTextChild(
+      desc_container_node, nullptr, BAD_CAST "about",
+      BAD_CAST "https://github.com/brave/brave-browser/wiki/PageGraph");
+  xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "is_root",
+                  BAD_CAST "true");
+  xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "frame_id",
+                  BAD_CAST kFrameId);
+
+  xmlNodePtr time_container_node =
+      xmlNewChild(desc_container_node, nullptr, BAD_CAST "time", nullptr);
+  xmlNewTextChild(time_container_node, nullptr, BAD_CAST "start",
+                  BAD_CAST "0");
+  xmlNewTextChild(
+      time_container_node, nullptr, BAD_CAST "end",
+      BAD_CAST base::NumberToString(kDuration.InMilliseconds()).c_str());
+
+  for (const auto& graphml_attr : GetGraphMLAttrs()) {
+    graphml_attr.second->AddDefinitionNode(graphml_root_node);
+  }
+
+  xmlNodePtr graph_node =
+      xmlNewChild(graphml_root_node, nullptr, BAD_CAST "graph", nullptr);
+  xmlSetProp(graph_node, BAD_CAST "id", BAD_CAST "G");
+  xmlSetProp(graph_node, BAD_CAST "edgedefault", BAD_CAST "directed");
+
+  for (const auto* node : nodes) {
+    node->AddGraphMLTag(graphml_doc, graph_node);
+  }
+  for (const auto* edge : edges) {
+    edge->AddGraphMLTag(graphml_doc, graph_node);
+  }
+
+  xmlChar* xml_string;
+  int size;
+  xmlDocDumpMemoryEnc(graphml_doc, &xml_string, &size, "UTF-8");
+  std::string graphml(reinterpret_cast<char*>(xml_string), size);
+
+  xmlFree(xml_string);
+  xmlFreeDoc(graphml_doc);
+  return graphml;
+}
+
+}  // namespace
+
+class PageGraphGraphMLTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    NodeParser* parser = context_.AddNode<NodeParser>();
+    NodeHTMLElement* body = context_.AddNode<NodeHTMLElement>(1, "body");
+    context_.AddEdge<EdgeNodeCreate>(parser, body);
+    context_.AddEdge<EdgeNodeInsert>(parser, body);
+
+    // Non-ASCII text and characters that need escaping, so that both the
+    // encoding and the escaping of the streamed chunks are compared.
+    NodeHTMLText* text =
+        context_.AddNode<NodeHTMLText>(2, "caf\xC3\xA9 \xE2\x9C\x93 <&>\"");
+    context_.AddEdge<EdgeNodeCreate>(parser, text);
+    context_.AddEdge<EdgeNodeInsert>(parser, text, body);
+
+    for (int i = 0; i < 100; i++) {
+      NodeHTMLElement* div = context_.AddNode<NodeHTMLElement>(3 + i, "div");
+      context_.AddEdge<EdgeNodeCreate>(parser, div);
+      context_.AddEdge<EdgeAttributeSet>(parser, div, "title",
+                                         "\xF0\x9F\x98\x80 " +
+                                             base::NumberToString(i));
+      context_.AddEdge<EdgeNodeInsert>(parser, div, body, text);
+    }
+  }
+
+  void Write(GraphMLSink* sink) {
+    WriteGraphML(true, kFrameId, kDuration, context_.nodes(),
+                 context_.edges(), sink);
+  }
+
+  std::string SerializeWithTree() {
+    return SerializeGraphAsTree(context_.nodes(), context_.edges());
+  }
+
+ private:
+  TestPageGraphContext context_;
+};
+
+TEST_F(PageGraphGraphMLTest, StreamedDocumentMatchesTreeSerializer) {
+  TestGraphMLSink sink;
+  Write(&sink);
+
+  EXPECT_EQ(SerializeWithTree(), sink.graphml());
+  // The header, the graph items and the closing tags.
+  EXPECT_GE(sink.chunk_count(), 3);
+}
+
+TEST_F(PageGraphGraphMLTest, StringSinkDecodesDocument) {
+  StringGraphMLSink sink;
+  Write(&sink);
+
+  const std::string expected = SerializeWithTree();
+  EXPECT_EQ(String::FromUTF8(expected.data(), expected.size()),
+            sink.TakeString());
+}
+
+TEST_F(PageGraphGraphMLTest, FileSinkWritesDocument) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  const base::FilePath path = temp_dir.GetPath().AppendASCII("graph.graphml");
+
+  {
+    base::File file(path, base::File::FLAG_CREATE | base::File::FLAG_WRITE);
+    ASSERT_TRUE(file.IsValid());
+    FileGraphMLSink sink(&file);
+    Write(&sink);
+    EXPECT_TRUE(sink.succeeded());
+  }
+
+  std::string graphml;
+  ASSERT_TRUE(base::ReadFileToString(path, &graphml));
+  EXPECT_EQ(SerializeWithTree(), graphml);
+}
+
+TEST(PageGraphStringGraphMLSinkTest, DecodesSequencesSplitAcrossChunks) {
+  const std::string utf8 = "caf\xC3\xA9 \xE2\x9C\x93 \xF0\x9F\x98\x80!";
+
+  StringGraphMLSink sink;
+  for (const char byte : utf8) {
+    sink.Write(base::StringPiece(&byte, 1));
+  }
+
+  EXPECT_EQ(String::FromUTF8(utf8.data(), utf8.size()), sink.TakeString());
+}
+
+}  // namespace brave_page_graph
@@ -17,9 +17,12 @@
 #include <string>
 #include <utility>
 
+#include "base/check_op.h"
 #include "base/debug/stack_trace.h"
 #include "base/json/json_string_value_serializer.h"
 #include "base/no_destructor.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
 #include "brave/components/brave_page_graph/common/features.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/edge/attribute/edge_attribute_delete.h"
@@ -158,6 +161,7 @@ using brave_page_graph::EdgeStructure;
 using brave_page_graph::EdgeTextChange;
 using brave_page_graph::GraphItem;
 using brave_page_graph::GraphItemId;
+using brave_page_graph::GraphMLSink;
 using brave_page_graph::ItemName;
 using brave_page_graph::NodeActor;
 using brave_page_graph::NodeAdFilter;
@@ -177,16 +181,13 @@ using brave_page_graph::NodeStorage;
 using brave_page_graph::NodeTrackerFilter;
 using brave_page_graph::NormalizeUrl;
 using brave_page_graph::ScriptId;
+using brave_page_graph::StringGraphMLSink;
 using brave_page_graph::TrackedRequest;
 
 namespace blink {
 
 namespace {
 
-constexpr char kPageGraphVersion[] = "0.3.0";
-constexpr char kPageGraphUrl[] =
-    "https://github.com/brave/brave-browser/wiki/PageGraph";
-
 PageGraph* GetPageGraphFromIsolate(v8::Isolate* isolate) {
   blink::LocalDOMWindow* window = blink::CurrentDOMWindow(isolate);
   if (!window) {
@@ -866,9 +867,13 @@ GraphItemId PageGraph::GetNextGraphItemId() {
   return ++id_counter_;
 }
 
-void PageGraph::AddGraphItem(std::unique_ptr<GraphItem> graph_item) {
-  GraphItem* item = graph_item.get();
-  graph_items_.push_back(std::move(graph_item));
+void* PageGraph::AllocateGraphItem(const size_t size,
+                                   const size_t alignment) {
+  return graph_items_.Allocate(size, alignment);
+}
+
+void PageGraph::AddGraphItem(GraphItem* item) {
+  graph_items_.Add(item);
 
   if (auto* graph_node = DynamicTo<GraphNode>(item)) {
     nodes_.push_back(graph_node);
@@ -956,70 +961,21 @@ void PageGraph::GenerateReportForNode(const blink::DOMNodeId node_id,
 }
 
 String PageGraph::ToGraphML() const {
-  xmlDocPtr graphml_doc = xmlNewDoc(BAD_CAST "1.0");
-  xmlNodePtr graphml_root_node = xmlNewNode(nullptr, BAD_CAST "graphml");
-  xmlDocSetRootElement(graphml_doc, graphml_root_node);
-
-  xmlNewNs(graphml_root_node, BAD_CAST "http://graphml.graphdrawing.org/xmlns",
-           nullptr);
-  xmlNsPtr xsi_ns = xmlNewNs(
-      graphml_root_node, BAD_CAST "http://www.w3.org/2001/XMLSchema-instance",
-      BAD_CAST "xsi");
-  xmlNewNsProp(graphml_root_node, xsi_ns, BAD_CAST "schemaLocation",
-               BAD_CAST
-               "http://graphml.graphdrawing.org/xmlns "
-               "http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd");
-
-  xmlNodePtr desc_container_node =
-      xmlNewChild(graphml_root_node, nullptr, BAD_CAST "desc", nullptr);
-  xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "version",
-                  BAD_CAST kPageGraphVersion);
-  xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "about",
-                  BAD_CAST kPageGraphUrl);
-  xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "is_root",
-                  BAD_CAST(IsRootFrame() ? "true" : "false"));
-  xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "frame_id",
-                  BAD_CAST frame_id_.c_str());
-
-  xmlNodePtr time_container_node =
-      xmlNewChild(desc_container_node, nullptr, BAD_CAST "time", nullptr);
-
-  xmlNewTextChild(time_container_node, nullptr, BAD_CAST "start",
-                  BAD_CAST base::NumberToString(0).c_str());
-
-  const base::TimeDelta end_time = base::TimeTicks::Now() - start_;
-  xmlNewTextChild(
-      time_container_node, nullptr, BAD_CAST "end",
-      BAD_CAST base::NumberToString(end_time.InMilliseconds()).c_str());
-
-  for (const auto& graphml_attr : brave_page_graph::GetGraphMLAttrs()) {
-    graphml_attr.second->AddDefinitionNode(graphml_root_node);
-  }
-
-  xmlNodePtr graph_node =
-      xmlNewChild(graphml_root_node, nullptr, BAD_CAST "graph", nullptr);
-  xmlSetProp(graph_node, BAD_CAST "id", BAD_CAST "G");
-  xmlSetProp(graph_node, BAD_CAST "edgedefault", BAD_CAST "directed");
-
-  for (const auto* node : nodes_) {
-    node->AddGraphMLTag(graphml_doc, graph_node);
-  }
-  for (const auto* edge : edges_) {
-    edge->AddGraphMLTag(graphml_doc, graph_node);
-  }
+  StringGraphMLSink sink;
+  WriteGraphML(&sink);
 
-  xmlChar* xml_string;
-  int size;
-  xmlDocDumpMemoryEnc(graphml_doc, &xml_string, &size, "UTF-8");
-  auto graphml_string = String::FromUTF8(xml_string, size);
+  String graphml_string = sink.TakeString();
   DCHECK(!graphml_string.empty());
 
-  xmlFree(xml_string);
-  xmlFree(graphml_doc);
-
   return graphml_string;
 }
 
+void PageGraph::WriteGraphML(GraphMLSink* sink) const {
+  brave_page_graph::WriteGraphML(IsRootFrame(), frame_id_,
+                                 base::TimeTicks::Now() - start_, nodes_,
+                                 edges_, sink);
+}
+
 NodeHTML* PageGraph::GetHTMLNode(const DOMNodeId node_id) const {
   VLOG(1) << "GetHTMLNode) node id: " << node_id;
   auto element_node_it = element_nodes_.find(node_id);
@@ -9,10 +9,12 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/time/time.h"
 #include "brave/third_party/blink/renderer/core/brave_page_graph/blink_probe_types.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/graph_item_arena.h"
 #include "brave/third_party/blink/renderer/core/brave_page_graph/page_graph_context.h"
 #include "brave/third_party/blink/renderer/core/brave_page_graph/requests/request_tracker.h"
 #include "brave/third_party/blink/renderer/core/brave_page_graph/scripts/script_tracker.h"
@@ -37,6 +39,7 @@ class UnguessableToken;
 namespace brave_page_graph {
 
 class GraphEdge;
+class GraphMLSink;
 class GraphNode;
 class NodeActor;
 class NodeAdFilter;
@@ -222,12 +225,15 @@ class CORE_EXPORT PageGraph : public GarbageCollected<PageGraph>,
   // PageGraphContext:
   base::TimeTicks GetGraphStartTime() const override;
   brave_page_graph::GraphItemId GetNextGraphItemId() override;
-  void AddGraphItem(
-      std::unique_ptr<brave_page_graph::GraphItem> graph_item) override;
+  void* AllocateGraphItem(size_t size, size_t alignment) override;
+  void AddGraphItem(brave_page_graph::GraphItem* graph_item) override;
 
   void GenerateReportForNode(const blink::DOMNodeId node_id,
                              blink::protocol::Array<String>& report);
   String ToGraphML() const;
+  // Serializes the graph to |sink| one graph item at a time, so the whole
+  // GraphML document is never held in memory as an XML tree.
+  void WriteGraphML(brave_page_graph::GraphMLSink* sink) const;
 
  private:
 #define PAGE_GRAPH_USING_DECL(type) using type = brave_page_graph::type
@@ -239,7 +245,6 @@ class CORE_EXPORT PageGraph : public GarbageCollected<PageGraph>,
   PAGE_GRAPH_USING_DECL(FingerprintingRule);
   PAGE_GRAPH_USING_DECL(GraphEdge);
   PAGE_GRAPH_USING_DECL(GraphItemId);
-  PAGE_GRAPH_USING_DECL(GraphItemUniquePtrList);
   PAGE_GRAPH_USING_DECL(GraphNode);
   PAGE_GRAPH_USING_DECL(InspectorId);
   PAGE_GRAPH_USING_DECL(MethodName);
@@ -439,10 +444,10 @@ class CORE_EXPORT PageGraph : public GarbageCollected<PageGraph>,
   // the graph's construction if needed.
   GraphItemId id_counter_ = 0;
 
-  // These vectors own all of the items that are shared and indexed across
+  // The arena owns all of the items that are shared and indexed across
   // the rest of the graph.  All the other pointers (the weak pointers)
   // do not own their data.
-  GraphItemUniquePtrList graph_items_;
+  brave_page_graph::GraphItemArena graph_items_;
   EdgeList edges_;
   NodeList nodes_;
 
@@ -460,28 +465,28 @@ class CORE_EXPORT PageGraph : public GarbageCollected<PageGraph>,
 
   // Index structure for looking up HTML nodes.
   // This map does not own the references.
-  std::map<blink::DOMNodeId, NodeHTMLElement*> element_nodes_;
-  std::map<blink::DOMNodeId, NodeHTMLText*> text_nodes_;
+  std::unordered_map<blink::DOMNodeId, NodeHTMLElement*> element_nodes_;
+  std::unordered_map<blink::DOMNodeId, NodeHTMLText*> text_nodes_;
 
   // Makes sure we don't have more than one node in the graph representing
   // a single URL (not required for correctness, but keeps things tidier
   // and makes some kinds of queries nicer).
-  std::map<RequestURL, NodeResource*> resource_nodes_;
+  std::unordered_map<RequestURL, NodeResource*> resource_nodes_;
 
   // Index structure for looking up binding nodes.
   // This map does not own the references.
-  std::map<Binding, NodeBinding*> binding_nodes_;
+  std::unordered_map<Binding, NodeBinding*> binding_nodes_;
   // Index structure for storing and looking up webapi nodes.
   // This map does not own the references.
-  std::map<MethodName, NodeJSWebAPI*> js_webapi_nodes_;
+  std::unordered_map<MethodName, NodeJSWebAPI*> js_webapi_nodes_;
   // Index structure for storing and looking up nodes representing built
   // in JS funcs and methods. This map does not own the references.
-  std::map<MethodName, NodeJSBuiltin*> js_builtin_nodes_;
+  std::unordered_map<MethodName, NodeJSBuiltin*> js_builtin_nodes_;
 
   // Index structure for looking up filter nodes.
   // These maps do not own the references.
-  std::map<std::string, NodeAdFilter*> ad_filter_nodes_;
-  std::map<std::string, NodeTrackerFilter*> tracker_filter_nodes_;
+  std::unordered_map<std::string, NodeAdFilter*> ad_filter_nodes_;
+  std::unordered_map<std::string, NodeTrackerFilter*> tracker_filter_nodes_;
   std::map<FingerprintingRule, NodeFingerprintingFilter*>
       fingerprinting_filter_nodes_;
 
@@ -6,7 +6,8 @@
 #ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_CORE_BRAVE_PAGE_GRAPH_PAGE_GRAPH_CONTEXT_H_
 #define BRAVE_THIRD_PARTY_BLINK_RENDERER_CORE_BRAVE_PAGE_GRAPH_PAGE_GRAPH_CONTEXT_H_
 
-#include <memory>
+#include <cstddef>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -19,14 +20,18 @@ class GraphEdge;
 
 class PageGraphContext : public GraphItemContext {
  public:
-  virtual void AddGraphItem(std::unique_ptr<GraphItem> graph_item) = 0;
+  // Returns storage for a graph item owned by the graph. The graph item must
+  // be passed to |AddGraphItem| once it has been constructed.
+  virtual void* AllocateGraphItem(size_t size, size_t alignment) = 0;
+  virtual void AddGraphItem(GraphItem* graph_item) = 0;
 
   template <typename T, typename... Args>
   T* AddNode(Args&&... args) {
     static_assert(std::is_base_of<GraphNode, T>::value,
                   "AddNode only for Nodes");
-    T* node = new T(this, std::forward<Args>(args)...);
-    AddGraphItem(std::unique_ptr<T>(node));
+    T* node = new (AllocateGraphItem(sizeof(T), alignof(T)))
+        T(this, std::forward<Args>(args)...);
+    AddGraphItem(node);
     return node;
   }
 
@@ -34,8 +39,9 @@ class PageGraphContext : public GraphItemContext {
   T* AddEdge(Args&&... args) {
     static_assert(std::is_base_of<GraphEdge, T>::value,
                   "AddEdge only for Edges");
-    T* edge = new T(this, std::forward<Args>(args)...);
-    AddGraphItem(std::unique_ptr<T>(edge));
+    T* edge = new (AllocateGraphItem(sizeof(T), alignof(T)))
+        T(this, std::forward<Args>(args)...);
+    AddGraphItem(edge);
     return edge;
   }
 };
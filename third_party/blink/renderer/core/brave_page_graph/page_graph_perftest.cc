@@ -0,0 +1,136 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/check.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/edge/node/edge_node_create.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/edge/node/edge_node_insert.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/graph_item_arena.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/node/actor/node_parser.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/graph_item/node/html/node_html_element.h"
+#include "brave/third_party/blink/renderer/core/brave_page_graph/page_graph_context.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace brave_page_graph {
+
+namespace {
+
+constexpr int kChildrenPerElement = 8;
+
+// Stores graph items the way PageGraph does: in an arena, with DOM node ids
+// indexed in an unordered map, so that replaying DOM probes through it
+// measures the same allocation and lookup work without a live frame.
+class ReplayPageGraph : public PageGraphContext {
+ public:
+  ReplayPageGraph() : parser_node_(AddNode<NodeParser>()) {}
+
+  base::TimeTicks GetGraphStartTime() const override { return start_time_; }
+  GraphItemId GetNextGraphItemId() override { return ++id_counter_; }
+
+  void* AllocateGraphItem(size_t size, size_t alignment) override {
+    return graph_items_.Allocate(size, alignment);
+  }
+
+  void AddGraphItem(GraphItem* graph_item) override {
+    graph_items_.Add(graph_item);
+    if (auto* graph_node = DynamicTo<GraphNode>(graph_item)) {
+      nodes_.push_back(graph_node);
+    } else if (auto* graph_edge = DynamicTo<GraphEdge>(graph_item)) {
+      graph_edge->GetInNode()->AddInEdge(graph_edge);
+      graph_edge->GetOutNode()->AddOutEdge(graph_edge);
+      edges_.push_back(graph_edge);
+    }
+  }
+
+  // Mirrors PageGraph::RegisterHTMLElementNodeCreated.
+  void RegisterHTMLElementNodeCreated(blink::DOMNodeId node_id) {
+    NodeHTMLElement* const new_node =
+        AddNode<NodeHTMLElement>(node_id, std::string("div"));
+    element_nodes_.emplace(node_id, new_node);
+    AddEdge<EdgeNodeCreate>(parser_node_, new_node);
+  }
+
+  // Mirrors PageGraph::RegisterHTMLElementNodeInserted.
+  void RegisterHTMLElementNodeInserted(blink::DOMNodeId node_id,
+                                       blink::DOMNodeId parent_node_id,
+                                       blink::DOMNodeId before_sibling_id) {
+    NodeHTMLElement* const parent_graph_node =
+        parent_node_id ? GetHTMLElementNode(parent_node_id) : nullptr;
+    NodeHTML* const prior_graph_sibling_node =
+        before_sibling_id ? GetHTMLElementNode(before_sibling_id) : nullptr;
+    NodeHTMLElement* const inserted_node = GetHTMLElementNode(node_id);
+    AddEdge<EdgeNodeInsert>(parser_node_, inserted_node, parent_graph_node,
+                            prior_graph_sibling_node);
+  }
+
+  size_t size() const { return graph_items_.size(); }
+
+ private:
+  NodeHTMLElement* GetHTMLElementNode(blink::DOMNodeId node_id) const {
+    auto it = element_nodes_.find(node_id);
+    CHECK(it != element_nodes_.end());
+    return it->second;
+  }
+
+  const base::TimeTicks start_time_ = base::TimeTicks::Now();
+  GraphItemId id_counter_ = 0;
+
+  GraphItemArena graph_items_;
+  std::vector<GraphNode*> nodes_;
+  std::vector<const GraphEdge*> edges_;
+  std::unordered_map<blink::DOMNodeId, NodeHTMLElement*> element_nodes_;
+
+  NodeParser* const parser_node_;
+};
+
+// Replays the create and insert probes a parser emits while building a tree
+// of |element_count| elements, and returns the number of probes replayed.
+int ReplayDocumentParse(ReplayPageGraph* graph, int element_count) {
+  int probe_count = 0;
+  for (int i = 1; i <= element_count; i++) {
+    const blink::DOMNodeId node_id = i;
+    graph->RegisterHTMLElementNodeCreated(node_id);
+    probe_count++;
+    if (i == 1) {
+      graph->RegisterHTMLElementNodeInserted(node_id, 0, 0);
+    } else {
+      const blink::DOMNodeId parent_id = (i - 2) / kChildrenPerElement + 1;
+      const bool is_first_child = (i - 2) % kChildrenPerElement == 0;
+      graph->RegisterHTMLElementNodeInserted(node_id, parent_id,
+                                             is_first_child ? 0 : node_id - 1);
+    }
+    probe_count++;
+  }
+  return probe_count;
+}
+
+}  // namespace
+
+// The time per probe should stay flat as the document grows.
+TEST(PageGraphPerfTest, ReplayDocumentParse) {
+  for (int element_count : {1000, 10000, 100000}) {
+    ReplayPageGraph graph;
+
+    const base::TimeTicks start = base::TimeTicks::Now();
+    const int probe_count = ReplayDocumentParse(&graph, element_count);
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+
+    // A parser node plus a node and two edges per element.
+    EXPECT_EQ(1u + 3u * element_count, graph.size());
+
+    perf_test::PerfResultReporter reporter(
+        "PageGraph", base::NumberToString(element_count) + "_elements");
+    reporter.RegisterImportantMetric(".probe_time", "us");
+    reporter.AddResult(".probe_time", elapsed.InMicrosecondsF() / probe_count);
+  }
+}
+
+}  // namespace brave_page_graph
@@ -42,7 +42,6 @@ using MethodName = std::string;
 using RequestURL = std::string;
 using InspectorId = uint64_t;
 
-using GraphItemUniquePtrList = std::vector<std::unique_ptr<GraphItem>>;
 using EdgeList = std::vector<const GraphEdge*>;
 using NodeList = std::vector<GraphNode*>;
 using HTMLNodeList = std::vector<NodeHTML*>;
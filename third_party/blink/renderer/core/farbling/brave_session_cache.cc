@@ -6,6 +6,7 @@
 #include "brave/third_party/blink/renderer/core/farbling/brave_session_cache.h"
 
 #include "base/command_line.h"
+#include "base/containers/span.h"
 #include "base/feature_list.h"
 #include "base/sequence_checker.h"
 #include "base/strings/string_number_conversions.h"
@@ -216,6 +217,8 @@ BraveSessionCache::BraveSessionCache(ExecutionContext& context)
   CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_key_),
                sizeof session_key_));
   CHECK(h.Sign(domain, domain_key_, sizeof domain_key_));
+  canvas_keys_.emplace(session_key_ ^
+                       *reinterpret_cast<const uint64_t*>(domain_key_));
   farbling_enabled_ = true;
 }
 
@@ -290,15 +293,9 @@ void BraveSessionCache::PerturbPixelsInternal(const unsigned char* data,
   const size_t pixel_count = size / 4;
   // calculate initial seed to find first pixel to perturb, based on session
   // key, domain key, and canvas contents
-  crypto::HMAC h(crypto::HMAC::SHA256);
-  uint64_t session_plus_domain_key =
-      session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
-  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
-               sizeof session_plus_domain_key));
-  uint8_t canvas_key[32];
-  CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels), size),
-               canvas_key, sizeof canvas_key));
-  uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
+  const CanvasKeyCache::CanvasKey& canvas_key =
+      canvas_keys_->GetCanvasKey(base::make_span(pixels, size));
+  uint64_t v = *reinterpret_cast<const uint64_t*>(canvas_key.data());
   uint64_t pixel_index;
   // choose which channel (R, G, or B) to perturb
   uint8_t channel;
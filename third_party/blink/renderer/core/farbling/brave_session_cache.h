@@ -11,6 +11,7 @@
 
 #include "base/callback.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
+#include "brave/third_party/blink/renderer/core/farbling/canvas_key_cache.h"
 #include "third_party/abseil-cpp/absl/random/random.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "third_party/blink/renderer/core/core_export.h"
@@ -96,6 +97,8 @@ class CORE_EXPORT BraveSessionCache final
   uint64_t session_key_;
   uint8_t domain_key_[32];
   std::map<FarbleKey, int> farbled_integers_;
+  // Set once the session and domain keys are known.
+  absl::optional<CanvasKeyCache> canvas_keys_;
 
   void PerturbPixelsInternal(const unsigned char* data, size_t size);
 };
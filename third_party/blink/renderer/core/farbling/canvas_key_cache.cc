@@ -0,0 +1,74 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/core/farbling/canvas_key_cache.h"
+
+#include "base/check.h"
+#include "base/hash/hash.h"
+#include "base/strings/string_piece.h"
+#include "crypto/hmac.h"
+
+namespace brave {
+
+namespace {
+
+constexpr size_t kCanvasKeyCacheSize = 8;
+
+// Returns a 64-bit fingerprint of |pixels| on every platform.
+uint64_t CanvasFingerprint(base::span<const uint8_t> pixels) {
+  if constexpr (sizeof(size_t) >= sizeof(uint64_t)) {
+    return base::FastHash(pixels);
+  } else {
+    // base::FastHash is only as wide as size_t, so widen it with a second,
+    // independent hash.
+    return static_cast<uint64_t>(base::PersistentHash(pixels)) << 32 |
+           base::FastHash(pixels);
+  }
+}
+
+}  // namespace
+
+CanvasKeyCache::CanvasKeyCache(uint64_t signing_key)
+    : signing_key_(signing_key), canvas_keys_(kCanvasKeyCacheSize) {}
+
+CanvasKeyCache::~CanvasKeyCache() = default;
+
+const CanvasKeyCache::CanvasKey& CanvasKeyCache::GetCanvasKey(
+    base::span<const uint8_t> pixels) {
+  const uint64_t fingerprint = CanvasFingerprint(pixels);
+  const std::pair<size_t, uint64_t> canvas_key_id(pixels.size(), fingerprint);
+  auto canvas_key_it = canvas_keys_.Get(canvas_key_id);
+  if (canvas_key_it == canvas_keys_.end()) {
+    canvas_key_it = canvas_keys_.Put(canvas_key_id,
+                                     DeriveCanvasKey(pixels, fingerprint));
+    derived_key_count_++;
+  }
+  return canvas_key_it->second;
+}
+
+CanvasKeyCache::CanvasKey CanvasKeyCache::DeriveCanvasKey(
+    base::span<const uint8_t> pixels,
+    uint64_t fingerprint) const {
+  crypto::HMAC h(crypto::HMAC::SHA256);
+  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&signing_key_),
+               sizeof signing_key_));
+  CanvasKey canvas_key;
+  if (pixels.size() < kLargeCanvasSize) {
+    CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(pixels.data()),
+                                   pixels.size()),
+                 canvas_key.data(), canvas_key.size()));
+  } else {
+    // Signing every pixel of a large canvas dominates the cost of reading it
+    // back, so sign its size and fingerprint instead. The key is still
+    // deterministic for a given session, domain and canvas contents.
+    const uint64_t canvas_digest[] = {pixels.size(), fingerprint};
+    CHECK(h.Sign(base::StringPiece(reinterpret_cast<const char*>(canvas_digest),
+                                   sizeof canvas_digest),
+                 canvas_key.data(), canvas_key.size()));
+  }
+  return canvas_key;
+}
+
+}  // namespace brave
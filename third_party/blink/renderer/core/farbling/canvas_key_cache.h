@@ -0,0 +1,55 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_THIRD_PARTY_BLINK_RENDERER_CORE_FARBLING_CANVAS_KEY_CACHE_H_
+#define BRAVE_THIRD_PARTY_BLINK_RENDERER_CORE_FARBLING_CANVAS_KEY_CACHE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "base/containers/lru_cache.h"
+#include "base/containers/span.h"
+#include "third_party/blink/renderer/core/core_export.h"
+
+namespace brave {
+
+// Derives the keys that pick which canvas pixels are perturbed on readback,
+// and caches them by canvas contents so that reading back an unchanged canvas
+// again does not derive its key again.
+class CORE_EXPORT CanvasKeyCache {
+ public:
+  using CanvasKey = std::array<uint8_t, 32>;
+
+  // Canvases at least this large (a 512x512 canvas) derive their key from a
+  // fingerprint of their pixels rather than from all of their pixels.
+  static constexpr size_t kLargeCanvasSize = 1024 * 1024;
+
+  // |signing_key| keys the HMAC every canvas key is derived with.
+  explicit CanvasKeyCache(uint64_t signing_key);
+
+  CanvasKeyCache(const CanvasKeyCache&) = delete;
+  CanvasKeyCache& operator=(const CanvasKeyCache&) = delete;
+
+  ~CanvasKeyCache();
+
+  const CanvasKey& GetCanvasKey(base::span<const uint8_t> pixels);
+
+  int derived_key_count_for_testing() const { return derived_key_count_; }
+
+ private:
+  CanvasKey DeriveCanvasKey(base::span<const uint8_t> pixels,
+                            uint64_t fingerprint) const;
+
+  const uint64_t signing_key_;
+  // Canvas keys by pixel buffer size and fingerprint.
+  base::LRUCache<std::pair<size_t, uint64_t>, CanvasKey> canvas_keys_;
+  int derived_key_count_ = 0;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_THIRD_PARTY_BLINK_RENDERER_CORE_FARBLING_CANVAS_KEY_CACHE_H_
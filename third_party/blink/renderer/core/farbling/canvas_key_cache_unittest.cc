@@ -0,0 +1,105 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/third_party/blink/renderer/core/farbling/canvas_key_cache.h"
+
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/strings/string_piece.h"
+#include "crypto/hmac.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave {
+
+namespace {
+
+constexpr uint64_t kSigningKey = 12345;
+
+std::vector<uint8_t> MakePixels(size_t size, uint8_t seed) {
+  std::vector<uint8_t> pixels(size);
+  for (size_t i = 0; i < size; i++) {
+    pixels[i] = static_cast<uint8_t>(i * 31 + seed);
+  }
+  return pixels;
+}
+
+}  // namespace
+
+TEST(CanvasKeyCacheTest, SmallCanvasKeyIsHMACOfPixels) {
+  const std::vector<uint8_t> pixels = MakePixels(64 * 64 * 4, 1);
+
+  CanvasKeyCache::CanvasKey expected_key;
+  crypto::HMAC h(crypto::HMAC::SHA256);
+  ASSERT_TRUE(h.Init(reinterpret_cast<const unsigned char*>(&kSigningKey),
+                     sizeof kSigningKey));
+  ASSERT_TRUE(h.Sign(
+      base::StringPiece(reinterpret_cast<const char*>(pixels.data()),
+                        pixels.size()),
+      expected_key.data(), expected_key.size()));
+
+  CanvasKeyCache cache(kSigningKey);
+  EXPECT_EQ(expected_key, cache.GetCanvasKey(pixels));
+}
+
+TEST(CanvasKeyCacheTest, KeysAreDeterministic) {
+  for (const size_t size : {size_t{64 * 64 * 4}, size_t{1024 * 1024 * 4}}) {
+    const std::vector<uint8_t> pixels = MakePixels(size, 1);
+
+    CanvasKeyCache cache(kSigningKey);
+    CanvasKeyCache other_cache(kSigningKey);
+    EXPECT_EQ(cache.GetCanvasKey(pixels), other_cache.GetCanvasKey(pixels));
+
+    // Another session or domain gets another key.
+    CanvasKeyCache other_session_cache(kSigningKey + 1);
+    EXPECT_NE(cache.GetCanvasKey(pixels),
+              other_session_cache.GetCanvasKey(pixels));
+  }
+}
+
+TEST(CanvasKeyCacheTest, LargeCanvasKeyDependsOnEveryPixel) {
+  std::vector<uint8_t> pixels =
+      MakePixels(CanvasKeyCache::kLargeCanvasSize * 2, 1);
+
+  CanvasKeyCache cache(kSigningKey);
+  const CanvasKeyCache::CanvasKey key = cache.GetCanvasKey(pixels);
+
+  pixels.back() ^= 1;
+  EXPECT_NE(key, cache.GetCanvasKey(pixels));
+  pixels.front() ^= 1;
+  EXPECT_NE(key, cache.GetCanvasKey(pixels));
+  EXPECT_EQ(3, cache.derived_key_count_for_testing());
+}
+
+TEST(CanvasKeyCacheTest, UnchangedCanvasHitsCache) {
+  std::vector<uint8_t> pixels = MakePixels(64 * 64 * 4, 1);
+
+  CanvasKeyCache cache(kSigningKey);
+  const CanvasKeyCache::CanvasKey key = cache.GetCanvasKey(pixels);
+  EXPECT_EQ(key, cache.GetCanvasKey(pixels));
+  EXPECT_EQ(1, cache.derived_key_count_for_testing());
+
+  // Changing the canvas derives a new key, and changing it back finds the
+  // first key in the cache.
+  pixels[0] ^= 1;
+  EXPECT_NE(key, cache.GetCanvasKey(pixels));
+  EXPECT_EQ(2, cache.derived_key_count_for_testing());
+  pixels[0] ^= 1;
+  EXPECT_EQ(key, cache.GetCanvasKey(pixels));
+  EXPECT_EQ(2, cache.derived_key_count_for_testing());
+}
+
+TEST(CanvasKeyCacheTest, SameContentsOfAnotherSizeMissCache) {
+  const std::vector<uint8_t> pixels = MakePixels(64 * 64 * 4, 1);
+
+  CanvasKeyCache cache(kSigningKey);
+  const CanvasKeyCache::CanvasKey key = cache.GetCanvasKey(pixels);
+  const CanvasKeyCache::CanvasKey prefix_key =
+      cache.GetCanvasKey(base::make_span(pixels.data(), pixels.size() / 2));
+  EXPECT_NE(key, prefix_key);
+  EXPECT_EQ(2, cache.derived_key_count_for_testing());
+}
+
+}  // namespace brave